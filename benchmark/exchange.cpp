@@ -0,0 +1,231 @@
+/*
+   This file is part of HPDDM.
+
+   Author(s): Pierre Jolivet <pierre.jolivet@enseeiht.fr>
+        Date: 2026-10-18
+
+   Copyright (C) 2026-     Centre National de la Recherche Scientifique
+
+   HPDDM is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published
+   by the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   HPDDM is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with HPDDM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+#include <map>
+#include <list>
+#include <random>
+#include <sstream>
+#if HPDDM_MKL
+# include <complex>
+# define MKL_Complex16         std::complex<double>
+# define MKL_Complex8          std::complex<float>
+# define MKL_INT               int
+#endif
+#ifndef HPDDM_NUMBERING
+# define HPDDM_NUMBERING       'C'
+#endif
+#include <HPDDM.hpp>
+
+#ifdef FORCE_SINGLE
+#ifdef FORCE_COMPLEX
+typedef std::complex<float> K;
+#ifndef GENERAL_CO
+#define GENERAL_CO
+#endif
+#else
+typedef float K;
+#endif
+#else
+#ifdef FORCE_COMPLEX
+typedef std::complex<double> K;
+#ifndef GENERAL_CO
+#define GENERAL_CO
+#endif
+#else
+typedef double K;
+#endif
+#endif
+
+#ifdef GENERAL_CO
+const char symCoarse = 'G';
+#else
+const char symCoarse = 'S';
+#endif
+
+typedef HPDDM::underlying_type<K> R;
+
+std::vector<std::string> split(const std::string& list) {
+    std::vector<std::string> v;
+    std::istringstream ss(list);
+    std::string s;
+    while(std::getline(ss, s, ','))
+        if(!s.empty())
+            v.emplace_back(s);
+    return v;
+}
+
+/* Function: generate
+ *
+ *  Builds a synthetic neighbor pattern, i.e., the sizes of the interfaces of the current process with all its neighbors.
+ * Processes are either laid out on a 2D or 3D Cartesian grid, in which case interfaces with neighbors sharing a face, an edge, or a vertex are respectively of size interface, interface^(1/2) in 3D, and 1, or they are the vertices of a random graph, in which case each process picks neighbors / 2 neighbors uniformly, and interfaces are of size between interface / 2 and 3 interface / 2. */
+void generate(const int rankWorld, const int sizeWorld, const int pattern, const int interface, const int neighbors, const unsigned int seed, std::map<int, int>& sizes) {
+    if(pattern < 2) {
+        const int dimension = pattern + 2;
+        int dims[3] { };
+        MPI_Dims_create(sizeWorld, dimension, dims);
+        if(dimension == 2)
+            dims[2] = 1;
+        const int coords[3] { rankWorld % dims[0], (rankWorld / dims[0]) % dims[1], rankWorld / (dims[0] * dims[1]) };
+        for(int k = -1; k < 2; ++k)
+            for(int j = -1; j < 2; ++j)
+                for(int i = -1; i < 2; ++i) {
+                    const int neighbor[3] { coords[0] + i, coords[1] + j, coords[2] + k };
+                    const int codimension = (i != 0) + (j != 0) + (k != 0);
+                    if(codimension == 0 || std::any_of(neighbor, neighbor + 3, [&](const int& c) { return c < 0 || c >= dims[&c - neighbor]; }))
+                        continue;
+                    sizes[(neighbor[2] * dims[1] + neighbor[1]) * dims[0] + neighbor[0]] = std::max(1, static_cast<int>(std::lround(std::pow(interface, (dimension - codimension) / (dimension - 1.0)))));
+                }
+    }
+    else {
+        std::mt19937 gen(seed);
+        std::uniform_int_distribution<int> process(0, sizeWorld - 1);
+        std::uniform_int_distribution<int> size(std::max(1, interface / 2), std::max(1, 3 * interface / 2));
+        for(int p = 0; p < sizeWorld; ++p)
+            for(int i = 0; i < std::max(1, neighbors / 2); ++i) {
+                const int q = process(gen);
+                const int s = size(gen);
+                if(q != p && (p == rankWorld || q == rankWorld))
+                    sizes[p == rankWorld ? q : p] = s;
+            }
+    }
+}
+
+int main(int argc, char** argv) {
+    MPI_Init(&argc, &argv);
+    int rankWorld, sizeWorld;
+    MPI_Comm_size(MPI_COMM_WORLD, &sizeWorld);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rankWorld);
+    HPDDM::Option& opt = *HPDDM::Option::get();
+    opt.parse(argc, argv, rankWorld == 0, {
+        std::forward_as_tuple("pattern=(2d|3d|random)", "Neighbor pattern, processes laid out on a Cartesian grid or on a random graph.", HPDDM::Option::Arg::argument),
+        std::forward_as_tuple("interface=<1000>", "Number of unknowns shared by two neighbors, on a face for Cartesian grids, on average for random graphs.", HPDDM::Option::Arg::positive),
+        std::forward_as_tuple("neighbors=<6>", "Average number of neighbors of a process in random graphs.", HPDDM::Option::Arg::positive),
+        std::forward_as_tuple("interior=<10000>", "Number of unknowns of a process not shared with any neighbor.", HPDDM::Option::Arg::integer),
+        std::forward_as_tuple("seed=<0>", "Seed of the random number generators.", HPDDM::Option::Arg::integer),
+        std::forward_as_tuple("mu=<1,2,4,8,16>", "Comma-separated list of numbers of vectors exchanged at once.", HPDDM::Option::Arg::argument),
+        std::forward_as_tuple("warm_up=<10>", "Number of fake runs to prime the pump.", HPDDM::Option::Arg::integer),
+        std::forward_as_tuple("trials=<100>", "Number of trial runs to time.", HPDDM::Option::Arg::integer),
+        std::forward_as_tuple("output=<output_file>", "Name of the file in which the JSON report is saved, standard output otherwise.", HPDDM::Option::Arg::argument)
+    });
+    if(rankWorld != 0)
+        opt.remove("verbosity");
+    const char* const patterns[] { "2d", "3d", "random" };
+    const char* const operations[] { "exchange", "recvBuffer", "scaledExchange" };
+    const int pattern = opt.app().find("pattern") != opt.app().cend() ? opt.app()["pattern"] : 0;
+    const unsigned int seed = opt.app()["seed"];
+    std::map<int, int> sizes;
+    generate(rankWorld, sizeWorld, pattern, opt.app()["interface"], opt.app()["neighbors"], seed, sizes);
+    int ndof = opt.app()["interior"];
+    for(const std::pair<const int, int>& p : sizes)
+        ndof += p.second;
+    /* Interfaces are scattered among the local unknowns, and are disjoint, so that each unknown is either interior or shared with a single neighbor. */
+    std::vector<int> perm(ndof);
+    std::iota(perm.begin(), perm.end(), 0);
+    std::shuffle(perm.begin(), perm.end(), std::mt19937(seed + rankWorld));
+    std::list<int> o;
+    std::vector<std::vector<int>> mapping;
+    mapping.reserve(sizes.size());
+    R* const d = new R[ndof];
+    std::fill_n(d, ndof, 1.0);
+    int offset = 0;
+    for(const std::pair<const int, int>& p : sizes) {
+        o.emplace_back(p.first);
+        mapping.emplace_back(perm.cbegin() + offset, perm.cbegin() + offset + p.second);
+        offset += p.second;
+        for(const int& i : mapping.back())
+            d[i] = 0.5;
+    }
+    std::vector<int> mu;
+    const std::string list = opt.prefix("mu");
+    for(const std::string& s : split(list.empty() ? "1,2,4,8,16" : list))
+        mu.emplace_back(std::min(std::max(1, HPDDM::sto<int>(s)), static_cast<int>(std::numeric_limits<unsigned short>::max())));
+    const int m = *std::max_element(mu.cbegin(), mu.cend());
+    int* const ia = new int[ndof + 1];
+    int* const ja = new int[ndof];
+    K* const a = new K[ndof];
+    std::iota(ia, ia + ndof + 1, 0);
+    std::iota(ja, ja + ndof, 0);
+    std::fill_n(a, ndof, K(1.0));
+    K* const x = new K[m * ndof];
+    {
+        HPDDM::Schwarz<SUBDOMAIN, COARSEOPERATOR, symCoarse, K> A;
+        A.Subdomain::initialize(new HPDDM::MatrixCSR<K>(ndof, ndof, ndof, a, ia, ja, false), o, mapping);
+        A.initialize(d);
+        const bool free = A.setBuffer();
+        const unsigned int warm = opt.app()["warm_up"];
+        const unsigned int trials = std::max(1, static_cast<int>(opt.app()["trials"]));
+        /* Statistics of the pattern summed over all processes: number of messages sent, and number of unknowns sent. */
+        unsigned long long statistics[2] { sizes.size(), static_cast<unsigned long long>(offset) };
+        MPI_Allreduce(MPI_IN_PLACE, statistics, 2, MPI_UNSIGNED_LONG_LONG, MPI_SUM, MPI_COMM_WORLD);
+        int extrema[2] { static_cast<int>(sizes.size()), -static_cast<int>(sizes.size()) };
+        MPI_Allreduce(MPI_IN_PLACE, extrema, 2, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+        std::ostringstream json;
+        json << std::scientific;
+        json << "{\n  \"processes\": " << sizeWorld << ",\n  \"scalar\": \"" << (HPDDM::Wrapper<K>::is_complex ? "complex " : "") << (std::is_same<R, float>::value ? "float" : "double") << "\",\n  \"pattern\": \"" << patterns[pattern] << "\",\n  \"neighbors\": { \"min\": " << -extrema[1] << ", \"avg\": " << static_cast<double>(statistics[0]) / sizeWorld << ", \"max\": " << extrema[0] << " },\n  \"interface\": " << (statistics[0] ? static_cast<double>(statistics[1]) / statistics[0] : 0.0) << ",\n  \"warm_up\": " << warm << ",\n  \"trials\": " << trials << ",\n  \"results\": [";
+        bool first = true;
+        for(unsigned short operation = 0; operation < 3; ++operation)
+            for(const int nu : mu) {
+                std::vector<double> time(trials);
+                for(unsigned int i = 0; i < warm + trials; ++i) {
+                    std::fill_n(x, nu * ndof, K(1.0));
+                    MPI_Barrier(MPI_COMM_WORLD);
+                    const std::chrono::steady_clock::time_point tBegin = std::chrono::steady_clock::now();
+                    switch(operation) {
+                        case 0: A.exchange(x, nu); break;
+                        case 1: for(int j = 0; j < nu; ++j)
+                                    A.recvBuffer(x + j * ndof);
+                                break;
+                        case 2: A.scaledExchange(x, nu); break;
+                    }
+                    if(i >= warm)
+                        time[i - warm] = std::chrono::duration<double>(std::chrono::steady_clock::now() - tBegin).count();
+                }
+                MPI_Allreduce(MPI_IN_PLACE, time.data(), trials, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+                const double min = *std::min_element(time.cbegin(), time.cend());
+                const double avg = std::accumulate(time.cbegin(), time.cend(), 0.0) / trials;
+                /* Latency and bandwidth per neighbor, i.e., the time of an operation divided by the average number of neighbors, and the average size of a message divided by the time of an operation. */
+                const double latency = statistics[0] ? min * sizeWorld / statistics[0] : 0.0;
+                const double bandwidth = statistics[0] ? static_cast<double>(statistics[1]) * nu * sizeof(K) / statistics[0] / min / 1.0e+9 : 0.0;
+                json << (first ? "\n" : ",\n") << "    { \"operation\": \"" << operations[operation] << "\", \"mu\": " << nu << ", \"time\": { \"min\": " << min << ", \"avg\": " << avg << ", \"max\": " << *std::max_element(time.cbegin(), time.cend()) << " }, \"latency\": " << latency << ", \"bandwidth\": " << bandwidth << " }";
+                first = false;
+            }
+        json << (first ? "]\n}\n" : "\n  ]\n}\n");
+        A.clearBuffer(free);
+        if(rankWorld == 0) {
+            const std::string filename = opt.prefix("output");
+            if(filename.empty())
+                std::cout << json.str();
+            else {
+                std::ofstream output { filename };
+                output << json.str();
+            }
+        }
+    }
+    delete [] x;
+    delete [] a;
+    delete [] ja;
+    delete [] ia;
+    delete [] d;
+    MPI_Finalize();
+    return 0;
+}
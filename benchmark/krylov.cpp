@@ -0,0 +1,376 @@
+/*
+   This file is part of HPDDM.
+
+   Author(s): Pierre Jolivet <pierre.jolivet@enseeiht.fr>
+        Date: 2026-10-18
+
+   Copyright (C) 2026-     Centre National de la Recherche Scientifique
+
+   HPDDM is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published
+   by the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   HPDDM is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with HPDDM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+#include <map>
+#include <list>
+#include <sstream>
+#if HPDDM_MKL
+# include <complex>
+# define MKL_Complex16         std::complex<double>
+# define MKL_Complex8          std::complex<float>
+# define MKL_INT               int
+#endif
+#ifndef HPDDM_NUMBERING
+# define HPDDM_NUMBERING       'C'
+#endif
+#include <HPDDM.hpp>
+
+#ifdef FORCE_SINGLE
+#ifdef FORCE_COMPLEX
+typedef std::complex<float> K;
+#ifndef GENERAL_CO
+#define GENERAL_CO
+#endif
+#else
+typedef float K;
+#endif
+#else
+#ifdef FORCE_COMPLEX
+typedef std::complex<double> K;
+#ifndef GENERAL_CO
+#define GENERAL_CO
+#endif
+#else
+typedef double K;
+#endif
+#endif
+
+#ifdef GENERAL_CO
+const char symCoarse = 'G';
+#else
+const char symCoarse = 'S';
+#endif
+
+typedef HPDDM::underlying_type<K> R;
+
+std::vector<std::string> split(const std::string& list) {
+    std::vector<std::string> v;
+    std::istringstream ss(list);
+    std::string s;
+    while(std::getline(ss, s, ','))
+        if(!s.empty())
+            v.emplace_back(s);
+    return v;
+}
+
+template<std::size_t N>
+int find(const char* const (&names)[N], const std::string& s) {
+    return std::distance(names, std::find_if(names, names + N, [&](const char* const name) { return s.compare(name) == 0; }));
+}
+
+/* Generates the overlapping subdomain of a process, from a P1 discretization of a structured mesh of the rectangle [0; px] x [0; py], with px * py processes and cells x cells squares per process.
+ * Dirichlet boundary conditions are imposed on the left side of the rectangle, homogeneous Neumann boundary conditions elsewhere.
+ * Problems are either a Laplacian (dof = 1), linear elasticity (dof = 2, E = 1, nu = 0.3, vertical load), or a Helmholtz equation (dof = 1, lumped mass matrix). The source term of the i-th right-hand side is cos(i x). */
+void generate(int rankWorld, int sizeWorld, const int problem, const int cells, const int overlap, const R wavenumber, const int mu, std::list<int>& o, std::vector<std::vector<int>>& mapping, HPDDM::MatrixCSR<K>*& Mat, HPDDM::MatrixCSR<K>*& MatNeumann, R*& d, K*& f, int& global) {
+    int px = int(sqrt(sizeWorld));
+    while(sizeWorld % px != 0)
+        --px;
+    const int py = sizeWorld / px;
+    const int x = rankWorld % px, y = rankWorld / px;
+    const int Nx = px * cells + 1, Ny = py * cells + 1;
+    const unsigned short dof = (problem == 1 ? 2 : 1);
+    global = Nx * Ny * dof;
+    auto box = [&](int p, int q, int (&b)[4]) {
+        b[0] = std::max(p * cells - overlap, 0);
+        b[1] = std::min((p == px - 1 ? Nx : (p + 1) * cells) + overlap, Nx);
+        b[2] = std::max(q * cells - overlap, 0);
+        b[3] = std::min((q == py - 1 ? Ny : (q + 1) * cells) + overlap, Ny);
+    };
+    int b[4];
+    box(x, y, b);
+    const int width = b[1] - b[0];
+    const int ndof = width * (b[3] - b[2]) * dof;
+    auto local = [&](int i, int j) { return ((j - b[2]) * width + i - b[0]) * dof; };
+    for(int q = std::max(y - 1, 0); q < std::min(y + 2, py); ++q)
+        for(int p = std::max(x - 1, 0); p < std::min(x + 2, px); ++p) {
+            if(p == x && q == y)
+                continue;
+            int c[4];
+            box(p, q, c);
+            c[0] = std::max(c[0], b[0]);
+            c[1] = std::min(c[1], b[1]);
+            c[2] = std::max(c[2], b[2]);
+            c[3] = std::min(c[3], b[3]);
+            if(c[0] < c[1] && c[2] < c[3]) {
+                o.push_back(p + q * px);
+                mapping.emplace_back();
+                mapping.back().reserve((c[1] - c[0]) * (c[3] - c[2]) * dof);
+                for(int j = c[2]; j < c[3]; ++j)
+                    for(int i = c[0]; i < c[1]; ++i)
+                        for(unsigned short k = 0; k < dof; ++k)
+                            mapping.back().emplace_back(local(i, j) + k);
+            }
+        }
+    d = new R[ndof];
+    f = new K[mu * ndof]();
+    for(int j = b[2]; j < b[3]; ++j)
+        for(int i = b[0]; i < b[1]; ++i)
+            std::fill_n(d + local(i, j), dof, (std::min(i / cells, px - 1) == x && std::min(j / cells, py - 1) == y) ? 1.0 : 0.0);
+    const R h = 1.0 / cells;
+    const R lambda = 0.3 / (1.3 * 0.4), shear = 1.0 / 2.6;
+    std::vector<std::map<int, K>> A(ndof), N(ndof);
+    for(int cj = std::max(b[2] - 1, 0); cj < std::min(b[3], Ny - 1); ++cj)
+        for(int ci = std::max(b[0] - 1, 0); ci < std::min(b[1], Nx - 1); ++ci) {
+            const bool inside = (ci >= b[0] && ci + 1 < b[1] && cj >= b[2] && cj + 1 < b[3]);
+            const int triangles[2][3][2] { { { ci, cj }, { ci + 1, cj }, { ci, cj + 1 } }, { { ci + 1, cj + 1 }, { ci, cj + 1 }, { ci + 1, cj } } };
+            for(const auto& t : triangles) {
+                R bx[3], cy[3];
+                const R det = ((t[1][0] - t[0][0]) * (t[2][1] - t[0][1]) - (t[2][0] - t[0][0]) * (t[1][1] - t[0][1])) * h * h;
+                const R area = std::abs(det) / 2.0;
+                for(unsigned short k = 0; k < 3; ++k) {
+                    bx[k] = (t[(k + 1) % 3][1] - t[(k + 2) % 3][1]) * h / det;
+                    cy[k] = (t[(k + 2) % 3][0] - t[(k + 1) % 3][0]) * h / det;
+                }
+                for(unsigned short k = 0; k < 3; ++k) {
+                    if(t[k][0] < b[0] || t[k][0] >= b[1] || t[k][1] < b[2] || t[k][1] >= b[3])
+                        continue;
+                    const int row = local(t[k][0], t[k][1]);
+                    for(unsigned short nu = 0; nu < mu; ++nu)
+                        f[nu * ndof + row + (problem == 1)] += (problem == 1 ? -1.0 : 1.0) * std::cos(nu * t[k][0] * h) * area / 3.0;
+                    for(unsigned short l = 0; l < 3; ++l) {
+                        if(t[l][0] < b[0] || t[l][0] >= b[1] || t[l][1] < b[2] || t[l][1] >= b[3])
+                            continue;
+                        const int col = local(t[l][0], t[l][1]);
+                        K e[2][2];
+                        if(problem == 1) {
+                            e[0][0] = area * ((lambda + 2.0 * shear) * bx[k] * bx[l] + shear * cy[k] * cy[l]);
+                            e[0][1] = area * (lambda * bx[k] * cy[l] + shear * cy[k] * bx[l]);
+                            e[1][0] = area * (lambda * cy[k] * bx[l] + shear * bx[k] * cy[l]);
+                            e[1][1] = area * ((lambda + 2.0 * shear) * cy[k] * cy[l] + shear * bx[k] * bx[l]);
+                        }
+                        else
+                            e[0][0] = area * (bx[k] * bx[l] + cy[k] * cy[l]) - (problem == 2 && k == l ? wavenumber * wavenumber * area / 3.0 : 0.0);
+                        for(unsigned short p = 0; p < dof; ++p)
+                            for(unsigned short q = 0; q < dof; ++q) {
+                                A[row + p][col + q] += e[p][q];
+                                if(inside)
+                                    N[row + p][col + q] += e[p][q];
+                            }
+                    }
+                }
+            }
+        }
+    std::vector<char> dirichlet(ndof);
+    if(b[0] == 0)
+        for(int j = b[2]; j < b[3]; ++j)
+            std::fill_n(dirichlet.begin() + local(0, j), dof, 1);
+    auto csr = [&](std::vector<std::map<int, K>>& M) {
+        int nnz = 0;
+        for(int i = 0; i < ndof; ++i) {
+            if(dirichlet[i]) {
+                M[i].clear();
+                M[i][i] = 1.0;
+            }
+            else
+                for(std::map<int, K>::iterator it = M[i].begin(); it != M[i].end(); )
+                    it = dirichlet[it->first] ? M[i].erase(it) : std::next(it);
+            nnz += M[i].size();
+        }
+        int* ia = new int[ndof + 1];
+        int* ja = new int[nnz];
+        K* a = new K[nnz];
+        ia[0] = (HPDDM_NUMBERING == 'F');
+        for(int i = 0, k = 0; i < ndof; ++i) {
+            for(const std::pair<const int, K>& p : M[i]) {
+                ja[k] = p.first + (HPDDM_NUMBERING == 'F');
+                a[k++] = p.second;
+            }
+            ia[i + 1] = k + (HPDDM_NUMBERING == 'F');
+            std::map<int, K>().swap(M[i]);
+        }
+        return new HPDDM::MatrixCSR<K>(ndof, ndof, nnz, a, ia, ja, false, true);
+    };
+    for(int i = 0; i < ndof; ++i)
+        if(dirichlet[i])
+            for(unsigned short nu = 0; nu < mu; ++nu)
+                f[nu * ndof + i] = 0.0;
+    Mat = csr(A);
+    MatNeumann = csr(N);
+}
+
+int main(int argc, char** argv) {
+    MPI_Init(&argc, &argv);
+    int rankWorld, sizeWorld;
+    MPI_Comm_size(MPI_COMM_WORLD, &sizeWorld);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rankWorld);
+    HPDDM::Option& opt = *HPDDM::Option::get();
+    opt.parse(argc, argv, rankWorld == 0, {
+        std::forward_as_tuple("problem=(laplacian|elasticity|helmholtz)", "Type of generated problem.", HPDDM::Option::Arg::argument),
+        std::forward_as_tuple("cells=<32>", "Number of cells in each direction per process.", HPDDM::Option::Arg::positive),
+        std::forward_as_tuple("overlap=<1>", "Number of grid points in the overlap.", HPDDM::Option::Arg::positive),
+        std::forward_as_tuple("wavenumber=<10>", "Wave number of the Helmholtz equation.", HPDDM::Option::Arg::numeric),
+        std::forward_as_tuple("krylov_methods=<gmres,bgmres,cg>", "Comma-separated list of Krylov methods to benchmark, CG and its block variants are skipped with nonsymmetric preconditioners, which they would silently replace by GMRES.", HPDDM::Option::Arg::argument),
+        std::forward_as_tuple("schwarz_methods=<ras,asm>", "Comma-separated list of Schwarz methods to benchmark.", HPDDM::Option::Arg::argument),
+        std::forward_as_tuple("coarse_corrections=<none,deflated,additive,balanced>", "Comma-separated list of coarse corrections to benchmark.", HPDDM::Option::Arg::argument),
+        std::forward_as_tuple("warm_up=<1>", "Number of fake runs to prime the pump.", HPDDM::Option::Arg::integer),
+        std::forward_as_tuple("trials=<3>", "Number of trial runs to time, each one starting without a recycled subspace nor spectral estimates.", HPDDM::Option::Arg::integer),
+        std::forward_as_tuple("rhs=<1>", "Number of right-hand sides.", HPDDM::Option::Arg::positive),
+        std::forward_as_tuple("output=<output_file>", "Name of the file in which the JSON report is saved, standard output otherwise.", HPDDM::Option::Arg::argument)
+    });
+    if(rankWorld != 0)
+        opt.remove("verbosity");
+    const char* const problems[] { "laplacian", "elasticity", "helmholtz" };
+    const char* const krylov[] { "gmres", "bgmres", "cg", "bcg", "gcrodr", "bgcrodr", "bfbcg", "richardson", "none", "gmresdr", "idr", "bicgstabl" };
+    const char* const schwarz[] { "ras", "oras", "soras", "asm", "osm", "none" };
+    const char* const coarse[] { "deflated", "additive", "balanced", "none" };
+    const std::string list[3] { opt.prefix("krylov_methods"), opt.prefix("schwarz_methods"), opt.prefix("coarse_corrections") };
+    const int problem = opt.app().find("problem") != opt.app().cend() ? opt.app()["problem"] : 0;
+    const std::vector<std::string> methods[3] { split(list[0].empty() ? "gmres,bgmres,cg" : list[0]), split(list[1].empty() ? "ras,asm" : list[1]), split(list[2].empty() ? "none,deflated,additive,balanced" : list[2]) };
+    const int cells = opt.app()["cells"];
+    const int mu = opt.app()["rhs"];
+    const unsigned int warm = opt.app()["warm_up"];
+    const unsigned int trials = std::max(1, static_cast<int>(opt.app()["trials"]));
+    std::list<int> o;
+    std::vector<std::vector<int>> mapping;
+    HPDDM::MatrixCSR<K>* Mat, *MatNeumann;
+    R* d;
+    K* f;
+    int global;
+    generate(rankWorld, sizeWorld, problem, cells, opt.app()["overlap"], opt.app()["wavenumber"], mu, o, mapping, Mat, MatNeumann, d, f, global);
+    const int ndof = Mat->_n;
+    K* const sol = new K[mu * ndof];
+    const double geneo = opt.val("geneo_nu", 0.0);
+    const unsigned short maxIt = opt.val<unsigned short>("max_it", 100);
+    std::ostringstream json;
+    json << std::scientific;
+#ifdef _OPENMP
+    const int th = omp_get_max_threads();
+#else
+    const int th = 1;
+#endif
+    json << "{\n  \"processes\": " << sizeWorld << ",\n  \"threads\": " << th << ",\n  \"scalar\": \"" << (HPDDM::Wrapper<K>::is_complex ? "complex " : "") << (std::is_same<R, float>::value ? "float" : "double") << "\",\n  \"problem\": \"" << problems[problem] << "\",\n  \"cells\": " << cells << ",\n  \"unknowns\": " << global << ",\n  \"rhs\": " << mu << ",\n  \"warm_up\": " << warm << ",\n  \"trials\": " << trials << ",\n  \"results\": [";
+    bool first = true;
+    for(const std::string& s : methods[1]) {
+        const int m = find(schwarz, s);
+        if(m == 6) {
+            if(rankWorld == 0)
+                std::cerr << "WARNING -- unknown Schwarz method " << s << std::endl;
+            continue;
+        }
+        opt["schwarz_method"] = m;
+        for(const std::string& c : methods[2]) {
+            const int correction = find(coarse, c);
+            if(correction == 4) {
+                if(rankWorld == 0)
+                    std::cerr << "WARNING -- unknown coarse correction " << c << std::endl;
+                continue;
+            }
+            if(correction == 3)
+                opt.remove("schwarz_coarse_correction");
+            else
+                opt["schwarz_coarse_correction"] = correction;
+            HPDDM::Schwarz<SUBDOMAIN, COARSEOPERATOR, symCoarse, K> A;
+            MPI_Barrier(MPI_COMM_WORLD);
+            std::chrono::steady_clock::time_point tBegin = std::chrono::steady_clock::now();
+            A.Subdomain::initialize(new HPDDM::MatrixCSR<K>(ndof, ndof, Mat->_nnz, Mat->_a, Mat->_ia, Mat->_ja, false), o, mapping);
+            A.initialize(d);
+            if(correction != 3) {
+#ifdef EIGENSOLVER
+                if(geneo > 0) {
+                    opt["geneo_nu"] = geneo;
+                    A.solveGEVP<EIGENSOLVER>(MatNeumann);
+                }
+                else
+#endif
+                {
+                    const unsigned short dof = (problem == 1 ? 2 : 1);
+                    K** deflation = new K*[dof];
+                    *deflation = new K[dof * ndof]();
+                    for(unsigned short k = 0; k < dof; ++k) {
+                        deflation[k] = *deflation + k * ndof;
+                        for(int i = k; i < ndof; i += dof)
+                            deflation[k][i] = 1.0;
+                    }
+                    opt["geneo_nu"] = dof;
+                    A.setVectors(deflation);
+                }
+                A.super::initialize(opt["geneo_nu"]);
+                A.buildTwo(MPI_COMM_WORLD);
+            }
+            A.callNumfact();
+            double setup = std::chrono::duration<double>(std::chrono::steady_clock::now() - tBegin).count();
+            MPI_Allreduce(MPI_IN_PLACE, &setup, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+            // every combination uses the same prefix, so nothing cached by a previous solve must leak into the next one
+            const auto reset = [&A]() {
+                if(HPDDM::Recycling<K>::get()->recycling(A.prefix()))
+                    HPDDM::Recycling<K>::get()->destroy(A.prefix());
+                HPDDM::Spectrum<R>::get()->destroy(A.prefix());
+            };
+            for(const std::string& k : methods[0]) {
+                const int method = find(krylov, k);
+                if(method == 12) {
+                    if(rankWorld == 0 && &s == &methods[1].front() && &c == &methods[2].front())
+                        std::cerr << "WARNING -- unknown Krylov method " << k << std::endl;
+                    continue;
+                }
+                if((method == HPDDM_KRYLOV_METHOD_CG || method == HPDDM_KRYLOV_METHOD_BCG || method == HPDDM_KRYLOV_METHOD_BFBCG) && ((m != HPDDM_SCHWARZ_METHOD_SORAS && m != HPDDM_SCHWARZ_METHOD_ASM && m != HPDDM_SCHWARZ_METHOD_NONE) || correction == HPDDM_SCHWARZ_COARSE_CORRECTION_DEFLATED)) {
+                    if(rankWorld == 0)
+                        std::cerr << "WARNING -- skipping " << k << " with " << s << " and coarse correction " << c << ", the preconditioner is not symmetric" << std::endl;
+                    continue;
+                }
+                opt["krylov_method"] = method;
+                int it = 0;
+                for(unsigned int i = 0; i < warm; ++i) {
+                    std::fill_n(sol, mu * ndof, K());
+                    reset();
+                    HPDDM::IterativeMethod::solve(A, f, sol, mu, A.getCommunicator());
+                }
+                std::vector<double> time(trials);
+                for(unsigned int i = 0; i < trials; ++i) {
+                    std::fill_n(sol, mu * ndof, K());
+                    reset();
+                    MPI_Barrier(MPI_COMM_WORLD);
+                    tBegin = std::chrono::steady_clock::now();
+                    it = HPDDM::IterativeMethod::solve(A, f, sol, mu, A.getCommunicator());
+                    time[i] = std::chrono::duration<double>(std::chrono::steady_clock::now() - tBegin).count();
+                }
+                MPI_Allreduce(MPI_IN_PLACE, time.data(), trials, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+                std::vector<R> storage(2 * mu);
+                A.computeResidual(sol, f, storage.data(), mu);
+                R residual = 0.0;
+                for(unsigned short nu = 0; nu < mu; ++nu)
+                    residual = std::max(residual, storage[2 * nu] > HPDDM_EPS ? storage[2 * nu + 1] / storage[2 * nu] : storage[2 * nu + 1]);
+                json << (first ? "\n" : ",\n") << "    { \"krylov_method\": \"" << k << "\", \"schwarz_method\": \"" << s << "\", \"coarse_correction\": \"" << c << "\", \"setup\": " << setup << ", \"iterations\": " << it << ", \"converged\": " << (it < maxIt ? "true" : "false") << ", \"residual\": " << residual << ", \"time\": { \"min\": " << *std::min_element(time.cbegin(), time.cend()) << ", \"avg\": " << std::accumulate(time.cbegin(), time.cend(), 0.0) / trials << ", \"max\": " << *std::max_element(time.cbegin(), time.cend()) << " } }";
+                first = false;
+            }
+            reset();
+        }
+    }
+    json << (first ? "]\n}\n" : "\n  ]\n}\n");
+    if(rankWorld == 0) {
+        const std::string filename = opt.prefix("output");
+        if(filename.empty())
+            std::cout << json.str();
+        else {
+            std::ofstream output { filename };
+            output << json.str();
+        }
+    }
+    delete [] sol;
+    delete [] f;
+    delete [] d;
+    delete MatNeumann;
+    delete Mat;
+    MPI_Finalize();
+    return 0;
+}
@@ -40,6 +40,8 @@
 # include "SuiteSparse.hpp"
 #elif defined(DISSECTIONSUB)
 # include "Dissection.hpp"
+#elif defined(ILUSUB)
+# include "ILU.hpp"
 #endif
 
 #ifdef FORCE_SINGLE
@@ -0,0 +1,288 @@
+/*
+   This file is part of HPDDM.
+
+   Author(s): Pierre Jolivet <pierre.jolivet@enseeiht.fr>
+        Date: 2026-10-18
+
+   Copyright (C) 2026-     Centre National de la Recherche Scientifique
+
+   HPDDM is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published
+   by the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   HPDDM is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with HPDDM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+#include <map>
+#include <sstream>
+#if HPDDM_MKL
+# include <complex>
+# define MKL_Complex16         std::complex<double>
+# define MKL_Complex8          std::complex<float>
+# define MKL_INT               int
+#endif
+#define HPDDM_MINIMAL
+#include <HPDDM.hpp>
+
+#ifdef FORCE_SINGLE
+#ifdef FORCE_COMPLEX
+typedef std::complex<float> K;
+#else
+typedef float K;
+#endif
+#else
+#ifdef FORCE_COMPLEX
+typedef std::complex<double> K;
+#else
+typedef double K;
+#endif
+#endif
+
+typedef HPDDM::underlying_type<K> R;
+
+std::vector<std::string> split(const std::string& list) {
+    std::vector<std::string> v;
+    std::istringstream ss(list);
+    std::string s;
+    while(std::getline(ss, s, ','))
+        if(!s.empty())
+            v.emplace_back(s);
+    return v;
+}
+
+/* Function: triad
+ *  Returns the bandwidth in GB/s of the STREAM triad a = b + s * c, with arrays of a given size, using the current number of OpenMP threads. */
+double triad(const unsigned int size, const unsigned int warm, const unsigned int trials) {
+    double* const a = new double[3 * size];
+    double* const b = a + size;
+    double* const c = b + size;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for(unsigned int i = 0; i < size; ++i) {
+        a[i] = 0.0;
+        b[i] = 1.0;
+        c[i] = 2.0;
+    }
+    double best = std::numeric_limits<double>::max();
+    for(unsigned int k = 0; k < warm + trials; ++k) {
+        const std::chrono::steady_clock::time_point tBegin = std::chrono::steady_clock::now();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+        for(unsigned int i = 0; i < size; ++i)
+            a[i] = b[i] + 3.0 * c[i];
+        if(k >= warm)
+            best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - tBegin).count());
+    }
+    delete [] a;
+    return 3.0 * sizeof(double) * size / best / 1.0e+9;
+}
+
+/* Function: generate
+ *  Assembles the 0-based CSR pattern of a finite difference Laplacian on a structured grid, with 5-point or 7-point stencils. */
+void generate(const int grid, const int dimension, std::vector<std::map<int, K>>& rows) {
+    const int n = dimension == 2 ? grid * grid : grid * grid * grid;
+    rows.resize(n);
+    for(int k = 0; k < (dimension == 2 ? 1 : grid); ++k)
+        for(int j = 0; j < grid; ++j)
+            for(int i = 0; i < grid; ++i) {
+                const int row = (k * grid + j) * grid + i;
+                rows[row][row] = 2.0 * dimension;
+                if(i > 0)
+                    rows[row][row - 1] = -1.0;
+                if(i < grid - 1)
+                    rows[row][row + 1] = -1.0;
+                if(j > 0)
+                    rows[row][row - grid] = -1.0;
+                if(j < grid - 1)
+                    rows[row][row + grid] = -1.0;
+                if(k > 0)
+                    rows[row][row - grid * grid] = -1.0;
+                if(k < grid - 1)
+                    rows[row][row + grid * grid] = -1.0;
+            }
+}
+
+/* Struct: Storage
+ *  Scalar and block values of a matrix stored in CSR format, either in full or with its lower triangular part only, and its pattern with both numberings. */
+struct Storage {
+    std::vector<K>       a;
+    std::vector<K>   block;
+    std::vector<int> ia[2];
+    std::vector<int> ja[2];
+    int                nnz;
+    Storage(const std::vector<std::map<int, K>>& rows, const bool sym, const int bs) : nnz() {
+        ia[0].reserve(rows.size() + 1);
+        ia[0].emplace_back(0);
+        for(int i = 0; i < rows.size(); ++i) {
+            for(const std::pair<const int, K>& p : rows[i])
+                if(!sym || p.first <= i) {
+                    ja[0].emplace_back(p.first);
+                    a.emplace_back(p.second);
+                }
+            ia[0].emplace_back(ja[0].size());
+        }
+        nnz = a.size();
+        block.resize(bs * bs * nnz);
+        for(int i = 0; i < nnz; ++i)
+            for(int j = 0; j < bs; ++j)
+                for(int k = 0; k < bs; ++k)
+                    block[bs * bs * i + j * bs + k] = (j == k ? 1.0 : 0.1) * a[i];
+        ia[1].resize(ia[0].size());
+        ja[1].resize(ja[0].size());
+        std::transform(ia[0].cbegin(), ia[0].cend(), ia[1].begin(), [](int i) { return i + 1; });
+        std::transform(ja[0].cbegin(), ja[0].cend(), ja[1].begin(), [](int j) { return j + 1; });
+    }
+};
+
+template<char N>
+void kernel(const int k, const bool sym, const int n, const int mu, const int bs, const Storage& A, const K* const x, K* const y) {
+    const int* const ia = A.ia[N == 'F'].data();
+    const int* const ja = A.ja[N == 'F'].data();
+    switch(k) {
+        case 0: HPDDM::Wrapper<K>::csrmv<N>(sym, &n, A.a.data(), ia, ja, x, y); break;
+        case 1: HPDDM::Wrapper<K>::csrmm<N>(sym, &n, &mu, A.a.data(), ia, ja, x, y); break;
+        case 2: HPDDM::Wrapper<K>::bsrmv<N>(sym, &n, &bs, A.block.data(), ia, ja, x, y); break;
+        case 3: HPDDM::Wrapper<K>::bsrmm<N>(sym, &n, &mu, &bs, A.block.data(), ia, ja, x, y); break;
+    }
+}
+
+int main(int argc, char** argv) {
+    HPDDM::Option& opt = *HPDDM::Option::get();
+    opt.parse(argc, argv, true, {
+        std::forward_as_tuple("matrix_filename=<input_file>", "Name of the file in which the matrix is stored, a Laplacian is generated otherwise.", HPDDM::Option::Arg::argument),
+        std::forward_as_tuple("grid=<40>", "Number of grid points in each direction of the generated Laplacian.", HPDDM::Option::Arg::positive),
+        std::forward_as_tuple("dimension=<3>", "Dimension of the generated Laplacian.", HPDDM::Option::Arg::positive),
+        std::forward_as_tuple("block_size=<3>", "Size of the dense blocks of the BSR matrix, each scalar entry of the CSR matrix being expanded into a block.", HPDDM::Option::Arg::positive),
+        std::forward_as_tuple("kernels=<csrmv,csrmm,bsrmv,bsrmm>", "Comma-separated list of kernels to benchmark.", HPDDM::Option::Arg::argument),
+        std::forward_as_tuple("mu=<1,2,4,8,16,32>", "Comma-separated list of numbers of vectors for csrmm and bsrmm.", HPDDM::Option::Arg::argument),
+        std::forward_as_tuple("threads=<list>", "Comma-separated list of numbers of OpenMP threads, powers of two up to the maximum number of threads otherwise.", HPDDM::Option::Arg::argument),
+        std::forward_as_tuple("stream_size=<10000000>", "Size of the arrays of the STREAM triad used to probe the memory bandwidth.", HPDDM::Option::Arg::positive),
+        std::forward_as_tuple("warm_up=<1>", "Number of fake runs to prime the pump.", HPDDM::Option::Arg::integer),
+        std::forward_as_tuple("trials=<5>", "Number of trial runs to time.", HPDDM::Option::Arg::integer),
+        std::forward_as_tuple("output=<output_file>", "Name of the file in which the JSON report is saved, standard output otherwise.", HPDDM::Option::Arg::argument)
+    });
+    std::vector<std::map<int, K>> rows;
+    const std::string filename = opt.prefix("matrix_filename");
+    if(filename.empty())
+        generate(opt.app()["grid"], opt.app()["dimension"] == 2 ? 2 : 3, rows);
+    else {
+        std::ifstream t(filename);
+        HPDDM::MatrixCSR<K>* A = new HPDDM::MatrixCSR<K>(t);
+        if(A->_n <= 0 || A->_n != A->_m) {
+            std::cerr << "Cannot read a square matrix from " << filename << std::endl;
+            delete A;
+            return 1;
+        }
+        rows.resize(A->_n);
+        for(int i = 0; i < A->_n; ++i)
+            for(int j = A->_ia[i] - A->_ia[0]; j < A->_ia[i + 1] - A->_ia[0]; ++j) {
+                rows[i][A->_ja[j] - A->_ia[0]] = A->_a[j];
+                if(A->_sym)
+                    rows[A->_ja[j] - A->_ia[0]][i] = A->_a[j];
+            }
+        delete A;
+    }
+    const int n = rows.size();
+    const int bs = opt.app()["block_size"];
+    const Storage storage[2] { Storage(rows, false, bs), Storage(rows, true, bs) };
+    rows.clear();
+    const char* const kernels[] { "csrmv", "csrmm", "bsrmv", "bsrmm" };
+    const std::string list[3] { opt.prefix("kernels"), opt.prefix("mu"), opt.prefix("threads") };
+    std::vector<int> k;
+    for(const std::string& s : split(list[0].empty() ? "csrmv,csrmm,bsrmv,bsrmm" : list[0])) {
+        const int i = std::distance(kernels, std::find_if(kernels, kernels + 4, [&](const char* const name) { return s.compare(name) == 0; }));
+        if(i == 4)
+            std::cerr << "WARNING -- unknown kernel " << s << std::endl;
+        else
+            k.emplace_back(i);
+    }
+    std::vector<int> mu;
+    for(const std::string& s : split(list[1].empty() ? "1,2,4,8,16,32" : list[1]))
+        mu.emplace_back(std::max(1, HPDDM::sto<int>(s)));
+    std::vector<int> threads;
+#ifdef _OPENMP
+    const int max = omp_get_max_threads();
+    if(list[2].empty()) {
+        for(int i = 1; i < max; i *= 2)
+            threads.emplace_back(i);
+        threads.emplace_back(max);
+    }
+    else
+        for(const std::string& s : split(list[2]))
+            threads.emplace_back(std::max(1, HPDDM::sto<int>(s)));
+#else
+    threads.emplace_back(1);
+#endif
+    const unsigned int warm = opt.app()["warm_up"];
+    const unsigned int trials = std::max(1, static_cast<int>(opt.app()["trials"]));
+    const int m = *std::max_element(mu.cbegin(), mu.cend());
+    K* const x = new K[2 * bs * n * m];
+    K* const y = x + bs * n * m;
+    for(int i = 0; i < bs * n * m; ++i)
+        x[i] = 1.0 / (1.0 + (i % 7));
+    std::ostringstream json;
+    json << std::scientific;
+    json << "{\n  \"scalar\": \"" << (HPDDM::Wrapper<K>::is_complex ? "complex " : "") << (std::is_same<R, float>::value ? "float" : "double") << "\",\n  \"rows\": " << n << ",\n  \"nnz\": " << storage[0].nnz << ",\n  \"block_size\": " << bs << ",\n  \"warm_up\": " << warm << ",\n  \"trials\": " << trials << ",\n  \"stream\": [";
+    std::vector<double> stream(threads.size());
+    for(int t = 0; t < threads.size(); ++t) {
+#ifdef _OPENMP
+        omp_set_num_threads(threads[t]);
+#endif
+        stream[t] = triad(opt.app()["stream_size"], warm, trials);
+        json << (t ? ",\n" : "\n") << "    { \"threads\": " << threads[t] << ", \"bandwidth\": " << stream[t] << " }";
+    }
+    json << "\n  ],\n  \"results\": [";
+    bool first = true;
+    for(int t = 0; t < threads.size(); ++t) {
+#ifdef _OPENMP
+        omp_set_num_threads(threads[t]);
+#endif
+        for(const int i : k) {
+            for(const int nu : mu) {
+                if(nu != 1 && (i == 0 || i == 2))
+                    continue;
+                const int b = (i < 2 ? 1 : bs);
+                for(unsigned short sym = 0; sym < 2; ++sym) {
+                    const Storage& A = storage[sym];
+                    for(unsigned short numbering = 0; numbering < 2; ++numbering) {
+                        double best = std::numeric_limits<double>::max();
+                        for(unsigned int j = 0; j < warm + trials; ++j) {
+                            const std::chrono::steady_clock::time_point tBegin = std::chrono::steady_clock::now();
+                            if(numbering == 0)
+                                kernel<'C'>(i, sym, n, nu, bs, A, x, y);
+                            else
+                                kernel<'F'>(i, sym, n, nu, bs, A, x, y);
+                            if(j >= warm)
+                                best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - tBegin).count());
+                        }
+                        const double nnz = sym ? 2.0 * A.nnz - n : A.nnz;
+                        const double flops = (HPDDM::Wrapper<K>::is_complex ? 8.0 : 2.0) * nnz * b * b * nu;
+                        const double bytes = (static_cast<double>(sizeof(K)) * b * b + sizeof(int)) * A.nnz + sizeof(int) * (n + 1.0) + 2.0 * sizeof(K) * b * n * nu;
+                        json << (first ? "\n" : ",\n") << "    { \"kernel\": \"" << kernels[i] << "\", \"symmetric\": " << (sym ? "true" : "false") << ", \"numbering\": \"" << (numbering ? 'F' : 'C') << "\", \"threads\": " << threads[t] << ", \"mu\": " << nu << ", \"time\": " << best << ", \"gflops\": " << flops / best / 1.0e+9 << ", \"bandwidth\": " << bytes / best / 1.0e+9 << ", \"efficiency\": " << bytes / best / 1.0e+9 / stream[t] << " }";
+                        first = false;
+                    }
+                }
+            }
+        }
+    }
+    json << (first ? "]\n}\n" : "\n  ]\n}\n");
+    const std::string output = opt.prefix("output");
+    if(output.empty())
+        std::cout << json.str();
+    else {
+        std::ofstream file { output };
+        file << json.str();
+    }
+    delete [] x;
+    return 0;
+}
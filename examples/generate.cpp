@@ -86,8 +86,9 @@ void generate(int rankWorld, int sizeWorld, std::list<int>& o, std::vector<std::
         }
     }
     else {
+        const unsigned int seed = opt.app()["seed"];
         std::random_device rd;
-        std::mt19937 gen(rd());
+        std::mt19937 gen(seed ? seed + rankWorld : rd());
         std::uniform_real_distribution<HPDDM::underlying_type<K>> dis(0.0, 1.0);
         std::for_each(f, f + mu * ndof, [&](K& x) { assign(gen, dis, x); });
     }
@@ -44,6 +44,14 @@ int main(int argc, char** argv) {
     HPDDM::Option& opt = *HPDDM::Option::get();
     opt.parse(argc, argv, rankWorld == 0, {
         std::forward_as_tuple("overlap=<1>", "Number of grid points in the overlap.", HPDDM::Option::Arg::positive),
+        std::forward_as_tuple("iterative_refinement=(0|1)", "Solve with iterative refinement using a single-precision copy of the preconditioner.", HPDDM::Option::Arg::argument),
+        std::forward_as_tuple("polynomial_degree=<0>", "Degree of the GMRES polynomial applied on top of the Schwarz preconditioner.", HPDDM::Option::Arg::integer),
+        std::forward_as_tuple("batch_size=<0>", "Push right-hand sides one at a time in a queue flushed every given number of right-hand sides.", HPDDM::Option::Arg::integer),
+        std::forward_as_tuple("refactorizations=<0>", "Number of additional factorizations of the local matrices with unchanged sparsity patterns, e.g., to time numerical factorizations reusing symbolic analyses.", HPDDM::Option::Arg::integer),
+        std::forward_as_tuple("coarse_updates=<0>", "Number of in-place updates of the coarse operator after alternately scaling the local matrices of even and odd subdomains, e.g., to time incremental updates of the coarse operator.", HPDDM::Option::Arg::integer),
+        std::forward_as_tuple("coarse_rebuilds=<0>", "Number of additional assemblies of the coarse operator after alternately scaling all local matrices, e.g., to time Galerkin products reusing the coarse sparsity pattern and symbolic factorization.", HPDDM::Option::Arg::integer),
+        std::forward_as_tuple("coarse_from_scratch=(0|1)", "Assemble the coarse operator from scratch in -coarse_updates and -coarse_rebuilds, e.g., to check the results of in-place updates of the coarse operator.", HPDDM::Option::Arg::argument),
+        std::forward_as_tuple("statistics=(0|1)", "Print statistics, setup timings, and memory usage of the preconditioner after the solution.", HPDDM::Option::Arg::argument),
 #ifdef HPDDM_FROMFILE
         std::forward_as_tuple("matrix_filename=<input_file>", "Name of the file in which the matrix is stored.", HPDDM::Option::Arg::argument),
         std::forward_as_tuple("rhs_filename=<input_file>", "Name of the file in which the RHS is stored.", HPDDM::Option::Arg::argument),
@@ -51,6 +59,7 @@ int main(int argc, char** argv) {
         std::forward_as_tuple("Nx=<100>", "Number of grid points in the x-direction.", HPDDM::Option::Arg::positive),
         std::forward_as_tuple("Ny=<100>", "Number of grid points in the y-direction.", HPDDM::Option::Arg::positive),
         std::forward_as_tuple("generate_random_rhs=<0>", "Number of generated random right-hand sides.", HPDDM::Option::Arg::integer),
+        std::forward_as_tuple("seed=<0>", "Seed of the generator of random right-hand sides, e.g., to compare iteration counts between builds, nondeterministic if 0.", HPDDM::Option::Arg::integer),
         std::forward_as_tuple("symmetric_csr=(0|1)", "Assemble symmetric matrices.", HPDDM::Option::Arg::argument),
         std::forward_as_tuple("nonuniform=(0|1)", "Use a different number of eigenpairs to compute on each subdomain.", HPDDM::Option::Arg::argument)
 #endif
@@ -104,12 +113,64 @@ int main(int argc, char** argv) {
             }
             A.super::initialize(nu);
             A.buildTwo(MPI_COMM_WORLD);
+            for(unsigned short i = 0, n = opt.app()["coarse_updates"]; i < n; ++i) {
+                const bool dirty = (rankWorld % 2 == (i / 2) % 2);
+                if(dirty)
+                    std::for_each(Mat->_a, Mat->_a + Mat->_nnz, [&](K& v) { v *= (i % 2 == 0 ? 2.0 : 0.5); });
+                if(opt.app().find("coarse_from_scratch") != opt.app().cend())
+                    A.buildTwo(MPI_COMM_WORLD);
+                else
+                    A.updateTwo(MPI_COMM_WORLD, dirty);
+            }
+            for(unsigned short i = 0, n = opt.app()["coarse_rebuilds"]; i < n; ++i) {
+                std::for_each(Mat->_a, Mat->_a + Mat->_nnz, [&](K& v) { v *= (i % 2 == 0 ? 2.0 : 0.5); });
+                if(opt.app().find("coarse_from_scratch") != opt.app().cend())
+                    A.buildTwo(MPI_COMM_WORLD);
+                else
+                    A.updateTwo(MPI_COMM_WORLD);
+            }
             /*# FactorizationEnd #*/
         }
-        A.callNumfact();
-        /*# Solution #*/
-        int it = HPDDM::IterativeMethod::solve(A, f, sol, mu, A.getCommunicator());
-        /*# SolutionEnd #*/
+        int it;
+#if !defined(SUITESPARSESUB) && !defined(DISSECTIONSUB) && !defined(DSUITESPARSE) && !defined(DHYPRE)
+        if(opt.app().find("iterative_refinement") != opt.app().cend()) {
+            HPDDM::Schwarz<SUBDOMAIN, COARSEOPERATOR, symCoarse, HPDDM::downscaled_type<K, true>> B;
+            HPDDM::underlying_type<HPDDM::downscaled_type<K, true>>* dB = new HPDDM::underlying_type<HPDDM::downscaled_type<K, true>>[ndof];
+            A.downscale(B, dB, MPI_COMM_WORLD);
+            it = HPDDM::IterativeMethod::solve(A, B, f, sol, mu, A.getCommunicator());
+            delete [] dB;
+        }
+        else
+#endif
+        {
+            A.callNumfact();
+            for(unsigned short i = 0, n = opt.app()["refactorizations"]; i < n; ++i)
+                A.callNumfact();
+            const unsigned short degree = opt.app()["polynomial_degree"];
+            if(degree > 0) {
+                HPDDM::Polynomial<decltype(A), K> P(A);
+                P.build(degree, A.getCommunicator());
+                it = HPDDM::IterativeMethod::solve(P, f, sol, mu, A.getCommunicator());
+            }
+            else if(opt.app()["batch_size"] > 0) {
+                HPDDM::Batch<decltype(A), K> B(A, A.getCommunicator(), opt.app()["batch_size"]);
+                std::vector<std::future<int>> futures;
+                futures.reserve(mu);
+                for(unsigned short nu = 0; nu < mu; ++nu)
+                    futures.emplace_back(B.push(f + nu * ndof, sol + nu * ndof));
+                B.flush();
+                it = 0;
+                for(std::future<int>& future : futures)
+                    it = std::max(it, future.get());
+            }
+            else {
+                /*# Solution #*/
+                it = HPDDM::IterativeMethod::solve(A, f, sol, mu, A.getCommunicator());
+                /*# SolutionEnd #*/
+            }
+        }
+        if(opt.app().find("statistics") != opt.app().cend())
+            A.statistics();
         HPDDM::underlying_type<K>* storage = new HPDDM::underlying_type<K>[2 * mu];
         A.computeResidual(sol, f, storage, mu);
         if(rankWorld == 0)
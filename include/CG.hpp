@@ -24,6 +24,7 @@
 #ifndef _HPDDM_CG_
 #define _HPDDM_CG_
 
+#include <random>
 #include "iterative.hpp"
 
 namespace HPDDM {
@@ -33,17 +34,16 @@ inline int IterativeMethod::CG(const Operator& A, const K* const b, K* const x,
     unsigned short it;
     char id[2];
     {
-        const std::string prefix = A.prefix();
-        const Option& opt = *Option::get();
-        if((hpddm_method_id<Operator>::value == 1 || hpddm_method_id<Operator>::value == 4) && (!opt.any_of(prefix + "schwarz_method", { HPDDM_SCHWARZ_METHOD_SORAS, HPDDM_SCHWARZ_METHOD_ASM, HPDDM_SCHWARZ_METHOD_NONE }) || opt.any_of(prefix + "schwarz_coarse_correction", { HPDDM_SCHWARZ_COARSE_CORRECTION_DEFLATED })))
+        const Option::Snapshot& opt = A.snapshot();
+        if((hpddm_method_id<Operator>::value == 1 || hpddm_method_id<Operator>::value == 4) && ((opt.schwarz_method != HPDDM_SCHWARZ_METHOD_SORAS && opt.schwarz_method != HPDDM_SCHWARZ_METHOD_ASM && opt.schwarz_method != HPDDM_SCHWARZ_METHOD_NONE) || opt.schwarz_coarse_correction == HPDDM_SCHWARZ_COARSE_CORRECTION_DEFLATED))
             return GMRES<excluded>(A, b, x, mu, comm);
-        options<2>(prefix, &tol, nullptr, &it, id);
+        options<2>(opt, &tol, nullptr, &it, id);
     }
     const int n = excluded ? 0 : A.getDof();
     const int dim = n * mu;
     underlying_type<K>* res;
     K* trash;
-    allocate(res, trash, n, id[1] == HPDDM_VARIANT_FLEXIBLE ? 2 : 1, it, mu);
+    allocate(A.prefix(), res, trash, n, id[1] == HPDDM_VARIANT_FLEXIBLE ? 2 : 1, it, mu);
     short* const hasConverged = new short[mu];
     std::fill_n(hasConverged, mu, -it);
     underlying_type<K>* const dir = res + mu;
@@ -62,7 +62,7 @@ inline int IterativeMethod::CG(const Operator& A, const K* const b, K* const x,
     Wrapper<K>::diag(n, d, p, trash, mu);
     for(unsigned short nu = 0; nu < mu; ++nu)
         dir[nu] = std::real(Blas<K>::dot(&n, trash + n * nu, &i__1, p + n * nu, &i__1));
-    MPI_Allreduce(MPI_IN_PLACE, dir, mu, Wrapper<K>::mpi_underlying_type(), MPI_SUM, comm);
+    allreduce(MPI_IN_PLACE, dir, mu, Wrapper<K>::mpi_underlying_type(), MPI_SUM, comm);
     std::transform(dir, dir + mu, res, [](const underlying_type<K>& d) { return std::sqrt(d); });
 
     int i = 0;
@@ -74,7 +74,7 @@ inline int IterativeMethod::CG(const Operator& A, const K* const b, K* const x,
                 for(unsigned short k = 0; k < i; ++k)
                     for(unsigned short nu = 0; nu < mu; ++nu)
                         dir[mu + k * mu + nu] = -std::real(Blas<K>::dot(&n, trash + n * nu, &i__1, p + (1 + it + k) * dim + n * nu, &i__1)) / dir[mu + (it + k) * mu + nu];
-                MPI_Allreduce(MPI_IN_PLACE, dir + mu, i * mu, Wrapper<K>::mpi_underlying_type(), MPI_SUM, comm);
+                allreduce(MPI_IN_PLACE, dir + mu, i * mu, Wrapper<K>::mpi_underlying_type(), MPI_SUM, comm);
                 if(!excluded && n) {
                     std::copy_n(z, dim, p);
                     for(unsigned short nu = 0; nu < mu; ++nu) {
@@ -89,7 +89,7 @@ inline int IterativeMethod::CG(const Operator& A, const K* const b, K* const x,
             Wrapper<K>::diag(n, d, p, trash, mu);
             for(unsigned short nu = 0; nu < mu; ++nu)
                 dir[mu + nu] = std::real(Blas<K>::dot(&n, z + n * nu, &i__1, trash + n * nu, &i__1));
-            MPI_Allreduce(MPI_IN_PLACE, dir, 2 * mu, Wrapper<K>::mpi_underlying_type(), MPI_SUM, comm);
+            allreduce(MPI_IN_PLACE, dir, 2 * mu, Wrapper<K>::mpi_underlying_type(), MPI_SUM, comm);
             ++i;
             std::copy_n(dir + mu, mu, dir + (it + i) * mu);
             std::copy_n(p, dim, p + i * dim);
@@ -109,7 +109,7 @@ inline int IterativeMethod::CG(const Operator& A, const K* const b, K* const x,
                 dir[mu + nu] = std::real(Blas<K>::dot(&n, r + n * nu, &i__1, trash + n * nu, &i__1)) / dir[nu];
                 dir[nu] = std::real(Blas<K>::dot(&n, z + n * nu, &i__1, trash + n * nu, &i__1));
             }
-            MPI_Allreduce(MPI_IN_PLACE, dir, 2 * mu, Wrapper<K>::mpi_underlying_type(), MPI_SUM, comm);
+            allreduce(MPI_IN_PLACE, dir, 2 * mu, Wrapper<K>::mpi_underlying_type(), MPI_SUM, comm);
             if(id[1] != HPDDM_VARIANT_FLEXIBLE)
                 for(unsigned short nu = 0; nu < mu; ++nu)
                     Blas<K>::axpby(n, 1.0, z + n * nu, 1, dir[mu + nu], p + n * nu, 1);
@@ -125,31 +125,171 @@ inline int IterativeMethod::CG(const Operator& A, const K* const b, K* const x,
         i = -1;
     ++i;
     convergence<2>(id[0], i, it);
-    delete [] res;
+    Workspace<underlying_type<K>>::get()->deallocate(res, A.prefix());
     if(Wrapper<K>::is_complex)
-        delete [] trash;
+        Workspace<K>::get()->deallocate(trash, A.prefix());
     delete [] hasConverged;
     A.end(allocate);
     return std::min(static_cast<unsigned short>(i), it);
 }
 template<bool excluded, class Operator, class K>
+inline int IterativeMethod::Hessenberg(const Operator& A, const int k, K* const V, K* const H, K* const work, const MPI_Comm& comm) {
+    const int n = excluded ? 0 : A.getDof();
+    const int ldh = k + 1;
+    K* const w = work;
+    K* const t = w + n;
+    K* const z = t + n;
+    std::fill_n(H, ldh * (k + 1), K());
+    const underlying_type<K>* const d = A.getScaling();
+    Wrapper<K>::diag(n, d, V, z);
+    underlying_type<K> norm = std::real(Blas<K>::dot(&n, V, &i__1, z, &i__1));
+    allreduce(MPI_IN_PLACE, &norm, 1, Wrapper<K>::mpi_underlying_type(), MPI_SUM, comm);
+    norm = std::sqrt(norm);
+    std::for_each(V, V + n, [&](K& v) { v /= norm; });
+    K* const c = H + ldh * k;
+    int m = 0;
+    while(m < k) {
+        A.template apply<excluded>(V + m * n, w, 1, z);                                                       // w = M v_m
+        if(!excluded)
+            A.GMV(w, t, 1);                                                                                   // t = A M v_m
+        K* const h = H + m * ldh;
+        int j = m + 1;
+        for(unsigned short i = 0; i < 2; ++i) {
+            Wrapper<K>::diag(n, d, t, z);
+            if(!excluded && n)
+                Blas<K>::gemv(&(Wrapper<K>::transc), &n, &j, &(Wrapper<K>::d__1), V, &n, z, &i__1, &(Wrapper<K>::d__0), c, &i__1);
+            else
+                std::fill_n(c, j, K());
+            allreduce(MPI_IN_PLACE, c, j, Wrapper<K>::mpi_type(), MPI_SUM, comm);
+            if(!excluded && n)
+                Blas<K>::gemv("N", &n, &j, &(Wrapper<K>::d__2), V, &n, c, &i__1, &(Wrapper<K>::d__1), t, &i__1);
+            Blas<K>::axpy(&j, &(Wrapper<K>::d__1), c, &i__1, h, &i__1);
+        }
+        Wrapper<K>::diag(n, d, t, z);
+        norm = std::real(Blas<K>::dot(&n, t, &i__1, z, &i__1));
+        allreduce(MPI_IN_PLACE, &norm, 1, Wrapper<K>::mpi_underlying_type(), MPI_SUM, comm);
+        norm = std::sqrt(norm);
+        h[j] = norm;
+        ++m;
+        if(norm < HPDDM_EPS * Blas<K>::nrm2(&j, h, &i__1))
+            break;
+        std::copy_n(t, n, V + m * n);
+        std::for_each(V + m * n, V + (m + 1) * n, [&](K& v) { v /= norm; });
+    }
+    return m;
+}
+template<bool excluded, class Operator, class K>
+inline bool IterativeMethod::estimateSpectrum(const Operator& A, const int k, underlying_type<K>* const ev, const MPI_Comm& comm) {
+    const int n = excluded ? 0 : A.getDof();
+    const int ldh = k + 1;
+    K* const V = Workspace<K>::get()->allocate((k + 4) * n + ldh * (k + 1), A.prefix(), 1);
+    K* const w = V + (k + 1) * n;
+    K* const H = w + 3 * n;
+    if(!excluded && n) {
+        std::default_random_engine generator;
+        std::uniform_real_distribution<underlying_type<K>> uniform(-1.0, 1.0);
+        std::generate_n(w, n, [&]() { return K(uniform(generator)); });
+        A.GMV(w, V, 1);
+    }
+    int m = Hessenberg<excluded>(A, k, V, H, w, comm);
+    int info = 1;
+    if(m) {
+        K query;
+        int lwork = -1;
+        Lapack<K>::hseqr("E", "N", &m, &i__1, &m, nullptr, &m, nullptr, nullptr, nullptr, &i__1, &query, &lwork, &info);
+        lwork = std::max(static_cast<int>(std::real(query)), m);
+        K* const T = new K[m * m + lwork + (Wrapper<K>::is_complex ? m : 2 * m)];
+        K* const work = T + m * m;
+        K* const theta = work + lwork;
+        for(int i = 0; i < m; ++i)
+            std::copy_n(H + i * ldh, m, T + i * m);
+        Lapack<K>::hseqr("E", "N", &m, &i__1, &m, T, &m, theta, theta + m, nullptr, &i__1, work, &lwork, &info);
+        if(info == 0) {
+            ev[0] = std::numeric_limits<underlying_type<K>>::max();
+            ev[1] = ev[2] = 0.0;
+            for(int i = 0; i < m; ++i) {
+                const std::complex<underlying_type<K>> e = Wrapper<K>::is_complex ? std::complex<underlying_type<K>>(theta[i]) : std::complex<underlying_type<K>>(std::real(theta[i]), std::real(theta[m + i]));
+                ev[0] = std::min(ev[0], std::real(e));
+                ev[1] = std::max(ev[1], std::real(e));
+                ev[2] = std::max(ev[2], std::abs(std::imag(e)));
+            }
+        }
+        delete [] T;
+    }
+    Workspace<K>::get()->deallocate(V, A.prefix(), 1);
+    return info == 0 && ev[0] > 0.0;
+}
+template<bool excluded, class Operator, class K>
+inline int IterativeMethod::Chebyshev(const Operator& A, const K* const b, K* const x, const int& mu, const MPI_Comm& comm) {
+    unsigned short it;
+    int k;
+    char verbosity;
+    {
+        underlying_type<K> d;
+        options<7>(A.snapshot(), &d, &k, &it, &verbosity);
+    }
+    const int n = excluded ? 0 : mu * A.getDof();
+    Spectrum<underlying_type<K>>& spectrum = *Spectrum<underlying_type<K>>::get();
+    const std::pair<underlying_type<K>, underlying_type<K>>* bounds = spectrum.bounds(A.prefix());
+    bool allocate = A.template start<excluded>(b, x, mu);
+    if(!bounds) {
+        underlying_type<K> ev[3];
+        if(!estimateSpectrum<excluded, Operator, K>(A, k, ev, comm)) {
+            A.end(allocate);
+            if(verbosity > 0)
+                std::cout << "WARNING -- the spectrum of the preconditioned operator is not in the right half-plane, now switching to GMRES" << std::endl;
+            return GMRES<excluded>(A, b, x, mu, comm);
+        }
+        bounds = spectrum.set(ev[0], ev[1], A.prefix());
+        if(verbosity > 1)
+            std::cout << "Chebyshev: spectral bounds estimated with " << k << " Arnoldi iteration" << (k > 1 ? "s" : "") << ", [" << ev[0] << ", " << ev[1] << "]" << std::endl;
+        if(verbosity > 0 && ev[2] > 1.0e-2 * ev[1])
+            std::cout << "WARNING -- the preconditioned operator has eigenvalues with imaginary parts up to " << ev[2] << ", Chebyshev iterations assume a symmetric operator and preconditioner" << std::endl;
+    }
+    K* const work = Workspace<K>::get()->allocate(3 * n, A.prefix());
+    K* const r = work + n;
+    K* const p = r + n;
+    if(!excluded)
+        A.GMV(x, r, mu);
+    Blas<K>::axpby(n, 1.0, b, 1, -1.0, r, 1);
+    const underlying_type<K> lower = bounds->first, upper = 1.1 * bounds->second;
+    const underlying_type<K> theta = (upper + lower) / 2.0, delta = (upper - lower) / 2.0;
+    underlying_type<K> rho = delta / theta;
+    A.template apply<excluded>(r, p, mu, work);
+    std::for_each(p, p + n, [&](K& v) { v /= theta; });
+    for(unsigned short j = 0; j < it; ++j) {
+        if(j) {
+            if(!excluded)
+                A.GMV(x, r, mu);
+            Blas<K>::axpby(n, 1.0, b, 1, -1.0, r, 1);
+            A.template apply<excluded>(r, work, mu);
+            const underlying_type<K> factor = 1.0 / (2.0 * theta - rho * delta);
+            Blas<K>::axpby(n, 2.0 * factor, work, 1, rho * delta * factor, p, 1);
+            rho = delta * factor;
+        }
+        Blas<K>::axpy(&n, &(Wrapper<K>::d__1), p, &i__1, x, &i__1);
+    }
+    Workspace<K>::get()->deallocate(work, A.prefix());
+    A.end(allocate);
+    return it;
+}
+template<bool excluded, class Operator, class K>
 inline int IterativeMethod::BCG(const Operator& A, const K* const b, K* const x, const int& mu, const MPI_Comm& comm) {
     underlying_type<K> tol;
     unsigned short m[2];
     char id[2];
     {
-        const std::string prefix = A.prefix();
-        const Option& opt = *Option::get();
-        if((hpddm_method_id<Operator>::value == 1 || hpddm_method_id<Operator>::value == 4) && (!opt.any_of(prefix + "schwarz_method", { HPDDM_SCHWARZ_METHOD_SORAS, HPDDM_SCHWARZ_METHOD_ASM, HPDDM_SCHWARZ_METHOD_NONE }) || opt.any_of(prefix + "schwarz_coarse_correction", { HPDDM_SCHWARZ_COARSE_CORRECTION_DEFLATED })))
+        const Option::Snapshot& opt = A.snapshot();
+        if((hpddm_method_id<Operator>::value == 1 || hpddm_method_id<Operator>::value == 4) && ((opt.schwarz_method != HPDDM_SCHWARZ_METHOD_SORAS && opt.schwarz_method != HPDDM_SCHWARZ_METHOD_ASM && opt.schwarz_method != HPDDM_SCHWARZ_METHOD_NONE) || opt.schwarz_coarse_correction == HPDDM_SCHWARZ_COARSE_CORRECTION_DEFLATED))
             return GMRES<excluded>(A, b, x, mu, comm);
-        options<3>(prefix, &tol, nullptr, m, id);
-        if(opt.val<char>(prefix + "variant", HPDDM_VARIANT_LEFT) == HPDDM_VARIANT_FLEXIBLE)
+        options<3>(opt, &tol, nullptr, m, id);
+        if(opt.variant == HPDDM_VARIANT_FLEXIBLE)
             return CG<excluded>(A, b, x, mu, comm);
-        m[1] = opt.val<unsigned short>(prefix + "enlarge_krylov_subspace", 1);
+        m[1] = std::max(opt.enlarge_krylov_subspace, static_cast<unsigned short>(1));
     }
     const int n = excluded ? 0 : A.getDof();
     const int dim = n * mu;
-    K* const trash = new K[4 * (dim + mu * mu)];
+    K* const trash = Workspace<K>::get()->allocate(4 * (dim + mu * mu), A.prefix());
     K* const z = trash + dim;
     K* const p = z + dim;
     K* const r = z + dim;
@@ -171,7 +311,7 @@ inline int IterativeMethod::BCG(const Operator& A, const K* const b, K* const x,
     }
     else
         std::fill_n(rho, (mu * (mu + 1)) / 2, K());
-    MPI_Allreduce(MPI_IN_PLACE, rho, (mu * (mu + 1)) / 2, Wrapper<K>::mpi_type(), MPI_SUM, comm);
+    allreduce(MPI_IN_PLACE, rho, (mu * (mu + 1)) / 2, Wrapper<K>::mpi_type(), MPI_SUM, comm);
     for(unsigned short nu = mu; nu > 0; --nu)
         std::copy_backward(rho + (nu * (nu - 1)) / 2, rho + (nu * (nu + 1)) / 2, rho + nu * mu - (mu - nu));
     for(unsigned short i = 0; i < mu; ++i)
@@ -180,7 +320,7 @@ inline int IterativeMethod::BCG(const Operator& A, const K* const b, K* const x,
     std::copy_n(rho, mu * mu, rho + mu * mu);
     int info = QR<excluded>(id[1], n, mu, p, gamma, mu, d, trash, comm);
     if(info != mu) {
-        delete [] trash;
+        Workspace<K>::get()->deallocate(trash, A.prefix());
         A.end(allocate);
         return CG<excluded>(A, b, x, mu, comm);
     }
@@ -209,11 +349,11 @@ inline int IterativeMethod::BCG(const Operator& A, const K* const b, K* const x,
         }
         else
             std::fill_n(rhs, (mu * (mu + 1)) / 2, K());
-        MPI_Allreduce(MPI_IN_PLACE, rhs, (mu * (mu + 1)) / 2, Wrapper<K>::mpi_type(), MPI_SUM, comm);
+        allreduce(MPI_IN_PLACE, rhs, (mu * (mu + 1)) / 2, Wrapper<K>::mpi_type(), MPI_SUM, comm);
         Lapack<K>::ppsv("U", &mu, &mu, rhs, rho + mu * mu, &mu, &info);
         if(info) {
             delete [] norm;
-            delete [] trash;
+            Workspace<K>::get()->deallocate(trash, A.prefix());
             A.end(allocate);
             return CG<excluded>(A, b, x, mu, comm);
         }
@@ -241,7 +381,7 @@ inline int IterativeMethod::BCG(const Operator& A, const K* const b, K* const x,
         }
         else
             std::fill_n(rhs - mu / m[1], mu / m[1] + (mu * (mu + 1)) / 2, K());
-        MPI_Allreduce(MPI_IN_PLACE, rhs - mu / m[1], mu / m[1] + (mu * (mu + 1)) / 2, Wrapper<K>::mpi_type(), MPI_SUM, comm);
+        allreduce(MPI_IN_PLACE, rhs - mu / m[1], mu / m[1] + (mu * (mu + 1)) / 2, Wrapper<K>::mpi_type(), MPI_SUM, comm);
         if(mu == checkBlockConvergence<3>(id[0], i, tol, mu, mu, norm, rho + 2 * mu * mu - mu / m[1], 0, trash, m[1]))
             break;
         else if(++i <= m[0]) {
@@ -254,7 +394,7 @@ inline int IterativeMethod::BCG(const Operator& A, const K* const b, K* const x,
             Lapack<K>::posv("U", &mu, &mu, rho, &mu, rhs, &mu, &info);
             if(info) {
                 delete [] norm;
-                delete [] trash;
+                Workspace<K>::get()->deallocate(trash, A.prefix());
                 A.end(allocate);
                 return CG<excluded>(A, b, x, mu, comm);
             }
@@ -265,7 +405,7 @@ inline int IterativeMethod::BCG(const Operator& A, const K* const b, K* const x,
             }
             if(QR<excluded>(id[1], n, mu, p, gamma, mu, d, trash, comm) != mu) {
                 delete [] norm;
-                delete [] trash;
+                Workspace<K>::get()->deallocate(trash, A.prefix());
                 A.end(allocate);
                 return CG<excluded>(A, b, x, mu, comm);
             }
@@ -274,7 +414,7 @@ inline int IterativeMethod::BCG(const Operator& A, const K* const b, K* const x,
     }
     convergence<3>(id[0], i, m[0]);
     delete [] norm;
-    delete [] trash;
+    Workspace<K>::get()->deallocate(trash, A.prefix());
     A.end(allocate);
     return std::min(i, m[0]);
 }
@@ -284,17 +424,16 @@ inline int IterativeMethod::BFBCG(const Operator& A, const K* const b, K* const
     unsigned short m[2];
     char id[2];
     {
-        const std::string prefix = A.prefix();
-        const Option& opt = *Option::get();
-        if((hpddm_method_id<Operator>::value == 1 || hpddm_method_id<Operator>::value == 4) && (!opt.any_of(prefix + "schwarz_method", { HPDDM_SCHWARZ_METHOD_SORAS, HPDDM_SCHWARZ_METHOD_ASM, HPDDM_SCHWARZ_METHOD_NONE }) || opt.any_of(prefix + "schwarz_coarse_correction", { HPDDM_SCHWARZ_COARSE_CORRECTION_DEFLATED })))
+        const Option::Snapshot& opt = A.snapshot();
+        if((hpddm_method_id<Operator>::value == 1 || hpddm_method_id<Operator>::value == 4) && ((opt.schwarz_method != HPDDM_SCHWARZ_METHOD_SORAS && opt.schwarz_method != HPDDM_SCHWARZ_METHOD_ASM && opt.schwarz_method != HPDDM_SCHWARZ_METHOD_NONE) || opt.schwarz_coarse_correction == HPDDM_SCHWARZ_COARSE_CORRECTION_DEFLATED))
             return GMRES<excluded>(A, b, x, mu, comm);
-        options<6>(prefix, tol, nullptr, m, id);
-        if(opt.val<char>(prefix + "variant", HPDDM_VARIANT_LEFT) == HPDDM_VARIANT_FLEXIBLE)
+        options<6>(opt, tol, nullptr, m, id);
+        if(opt.variant == HPDDM_VARIANT_FLEXIBLE)
             return CG<excluded>(A, b, x, mu, comm);
     }
     const int n = excluded ? 0 : A.getDof();
     const int dim = n * mu;
-    K* const trash = new K[5 * dim + (mu * (3 * mu + 1)) / 2 + mu / m[1]];
+    K* const trash = Workspace<K>::get()->allocate(5 * dim + (mu * (3 * mu + 1)) / 2 + mu / m[1], A.prefix());
     K* const q = trash + dim;
     K* const r = q + dim;
     K* const p = r + dim;
@@ -342,7 +481,7 @@ inline int IterativeMethod::BFBCG(const Operator& A, const K* const b, K* const
         }
         else
             std::fill_n(gamma, (deflated * (deflated + 1)) / 2 + deflated * mu, K());
-        MPI_Allreduce(MPI_IN_PLACE, gamma, (deflated * (deflated + 1)) / 2 + deflated * mu, Wrapper<K>::mpi_type(), MPI_SUM, comm);
+        allreduce(MPI_IN_PLACE, gamma, (deflated * (deflated + 1)) / 2 + deflated * mu, Wrapper<K>::mpi_type(), MPI_SUM, comm);
         Lapack<K>::pptrf("U", &deflated, gamma, &info);
         Lapack<K>::pptrs("U", &deflated, &mu, gamma, alpha, &deflated, &info);
         if(!excluded && n) {
@@ -368,7 +507,7 @@ inline int IterativeMethod::BFBCG(const Operator& A, const K* const b, K* const
         }
         else
              std::fill_n(alpha, deflated * mu + mu / m[1], K());
-        MPI_Allreduce(MPI_IN_PLACE, alpha, deflated * mu + mu / m[1], Wrapper<K>::mpi_type(), MPI_SUM, comm);
+        allreduce(MPI_IN_PLACE, alpha, deflated * mu + mu / m[1], Wrapper<K>::mpi_type(), MPI_SUM, comm);
         if(mu == checkBlockConvergence<6>(id[0], i, tol[0], mu, deflated, norm, res, 0, trash, m[1]))
             break;
         else if(++i <= m[0]) {
@@ -398,7 +537,7 @@ inline int IterativeMethod::BFBCG(const Operator& A, const K* const b, K* const
     convergence<6>(id[0], i, m[0]);
     delete [] norm;
     delete [] piv;
-    delete [] trash;
+    Workspace<K>::get()->deallocate(trash, A.prefix());
     A.end(allocate);
     return std::min(i, m[0]);
 }
@@ -407,7 +546,7 @@ inline int IterativeMethod::PCG(const Operator& A, const K* const f, K* const x,
     underlying_type<K> tol;
     unsigned short it;
     char verbosity;
-    options<8>(A.prefix(), &tol, nullptr, &it, &verbosity);
+    options<8>(A.snapshot(), &tol, nullptr, &it, &verbosity);
     typedef typename std::conditional<std::is_pointer<typename std::remove_reference<decltype(*A.getScaling())>::type>::value, K**, K*>::type ptr_type;
     const int n = std::is_same<ptr_type, K*>::value ? A.getDof() : A.getMult();
     const int offset = std::is_same<ptr_type, K*>::value ? A.getEliminated() : 0;
@@ -443,7 +582,7 @@ inline int IterativeMethod::PCG(const Operator& A, const K* const f, K* const x,
             A.template project<excluded, 'N'>(zCurr, pCurr);                                       //     p_i = P z_i
             for(unsigned short k = 0; k < i - 1; ++k)
                 alpha[it + k] = dot(&n, z[k], &i__1, pCurr, &i__1);
-            MPI_Allreduce(MPI_IN_PLACE, alpha + it, i - 1, Wrapper<K>::mpi_type(), MPI_SUM, comm); // alpha_k = < z_k, p_i >
+            allreduce(MPI_IN_PLACE, alpha + it, i - 1, Wrapper<K>::mpi_type(), MPI_SUM, comm); // alpha_k = < z_k, p_i >
             for(unsigned short k = 0; k < i - 1; ++k) {
                 alpha[it + k] /= -alpha[k];
                 axpy(&n, alpha + it + k, p[k], &i__1, pCurr, &i__1);                               //     p_i = p_i - sum < z_k, p_i > / < z_k, p_k > p_k
@@ -460,7 +599,7 @@ inline int IterativeMethod::PCG(const Operator& A, const K* const f, K* const x,
                 alpha[i - 1] = dot(&n, z.back(), &i__1, pCurr, &i__1);
                 alpha[i]     = dot(&n, storage[0], &i__1, pCurr, &i__1);
             }
-            MPI_Allreduce(MPI_IN_PLACE, alpha + i - 1, 2, Wrapper<K>::mpi_type(), MPI_SUM, comm);
+            allreduce(MPI_IN_PLACE, alpha + i - 1, 2, Wrapper<K>::mpi_type(), MPI_SUM, comm);
             alpha[it] = alpha[i] / alpha[i - 1];
             if(std::is_same<ptr_type, K*>::value)
                 axpy(&n, alpha + it, pCurr, &i__1, x + offset, &i__1);
@@ -476,9 +615,9 @@ inline int IterativeMethod::PCG(const Operator& A, const K* const f, K* const x,
         else {
             A.template project<excluded, 'N'>(zCurr, pCurr);
             std::fill_n(alpha, i - 1, K());
-            MPI_Allreduce(MPI_IN_PLACE, alpha, i - 1, Wrapper<K>::mpi_type(), MPI_SUM, comm);
+            allreduce(MPI_IN_PLACE, alpha, i - 1, Wrapper<K>::mpi_type(), MPI_SUM, comm);
             std::fill_n(alpha, 2, K());
-            MPI_Allreduce(MPI_IN_PLACE, alpha, 2, Wrapper<K>::mpi_type(), MPI_SUM, comm);
+            allreduce(MPI_IN_PLACE, alpha, 2, Wrapper<K>::mpi_type(), MPI_SUM, comm);
             A.template project<excluded, 'T'>(storage[0]);
         }
         A.template computeDot<excluded>(&resRel, zCurr, zCurr, comm);
@@ -26,10 +26,37 @@
 #include "GMRES.hpp"
 
 namespace HPDDM {
+template<class T>
+class has_getVersion {
+    private:
+        typedef char one;
+        typedef one (&two)[2];
+        template<class C> static one test(decltype(&C::getVersion));
+        template<class C> static two test(...);
+    public:
+        static constexpr bool value = (sizeof(test<T>(0)) == sizeof(one));
+};
+template<class Operator, typename std::enable_if<has_getVersion<Operator>::value>::type* = nullptr>
+inline std::size_t hashOperator(const Operator& A) {
+    if(!A.getMatrix() || !A.getMatrix()->_a)
+        return 0;
+    std::size_t seed = A.getMatrix()->hashValues();
+    const unsigned int version = A.getVersion();
+    hash_range(seed, &version, &version + 1);
+    const char method[2] = { A.snapshot().schwarz_method, A.snapshot().schwarz_coarse_correction };
+    hash_range(seed, method, method + 2);
+    return seed;
+}
+template<class Operator, typename std::enable_if<!has_getVersion<Operator>::value>::type* = nullptr>
+inline std::size_t hashOperator(const Operator&) { return 0; }
+
 template<class K>
 class Recycling : private Singleton {
     private:
         std::unordered_map<std::string, K*> _storage;
+        /* Variable: hash
+         *  Hashes of the local matrices and of the versions of the operators used during the last solve of each prefix. */
+        std::unordered_map<std::string, std::size_t> _hash;
     public:
         template<int N>
         Recycling(Singleton::construct_key<N>) { }
@@ -44,6 +71,7 @@ class Recycling : private Singleton {
                 K* pt = _storage.at(key);
                 delete [] pt;
                 _storage.erase(key);
+                _hash.erase(key);
                 if(reset) {
                     Option& opt = *Option::get();
                     unsigned short k = opt.val<unsigned short>(key + "recycle_same_system");
@@ -55,6 +83,29 @@ class Recycling : private Singleton {
                 std::cerr << "out_of_range error: " << oor.what() << " (key: " << key << ")" << std::endl;
             }
         }
+        /* Function: unchanged
+         *
+         *  Stores a hash of the local matrix, of the version of an operator, and of the options of its preconditioner, and returns true if the operator has not changed on any process since the previous call, in which case the recycled subspace is still valid, see <Iterative method::GCRODR>.
+         *  Only operators with a getVersion member function which changes whenever their preconditioner is updated, e.g., <Schwarz::getVersion>, may be detected as unchanged, and never in single precision, in which recomputing C = A U at each solve is needed to keep it orthonormal. Other operators must set recycle_same_system instead.
+         *
+         * Template Parameter:
+         *    excluded       - True if the master processes are excluded from the domain decomposition, false otherwise.
+         *
+         * Parameters:
+         *    A              - Global operator.
+         *    comm           - Global MPI communicator. */
+        template<bool excluded, class Operator>
+        bool unchanged(const Operator& A, const MPI_Comm& comm) {
+            const std::string key = A.prefix();
+            const std::size_t hash = excluded ? 0 : hashOperator(A);
+            std::size_t& previous = _hash[key];
+            int same = !std::is_same<underlying_type<K>, float>::value && (excluded || (hash && hash == previous));
+            previous = hash;
+            if(!recycling(key))
+                return false;
+            IterativeMethod::allreduce(MPI_IN_PLACE, &same, 1, MPI_INT, MPI_MIN, comm);
+            return same;
+        }
         bool recycling(const std::string& key = "") const {
             return _storage.find(key) != _storage.cend();
         }
@@ -114,7 +165,7 @@ inline int IterativeMethod::GCRODR(const Operator& A, const K* const b, K* const
     int k;
     unsigned short m[2];
     char id[5];
-    options<4>(A.prefix(), &tol, &k, m, id);
+    options<4>(A.snapshot(), &tol, &k, m, id);
     if(k <= 0) {
         if(id[0])
             std::cout << "WARNING -- please choose a positive number of Ritz vectors to compute, now switching to GMRES" << std::endl;
@@ -124,7 +175,7 @@ inline int IterativeMethod::GCRODR(const Operator& A, const K* const b, K* const
     const int ldh = mu * (m[1] + 1);
     K** const H = new K*[m[1] * (id[1] == HPDDM_VARIANT_FLEXIBLE ? 4 : 3) + 1];
     K** const save = H + m[1];
-    *save = new K[ldh * m[1]];
+    *save = Workspace<K>::get()->allocate(ldh * m[1], A.prefix(), 1);
     K** const v = save + m[1];
     const underlying_type<K>* const d = A.getScaling();
     const int ldv = mu * n;
@@ -134,7 +185,9 @@ inline int IterativeMethod::GCRODR(const Operator& A, const K* const b, K* const
         k = recycled.k(A.prefix());
         C = U + k * ldv;
     }
-    K* const s = new K[mu * ((m[1] + 1) * (m[1] + 1) + n * ((id[1] == HPDDM_VARIANT_RIGHT ? 3 : 2) + m[1] * (id[1] == HPDDM_VARIANT_FLEXIBLE ? 2 : 1)) + (!Wrapper<K>::is_complex ? m[1] + 1 : (m[1] + 2) / 2)) + (d && U && id[1] == HPDDM_VARIANT_RIGHT && id[4] / 4 == 0 ? n * std::max(k - mu * (m[1] - k + 2), 0) : 0)];
+    if(id[4] / 4 == 0 && recycled.template unchanged<excluded>(A, comm))
+        id[4] += 4;
+    K* const s = Workspace<K>::get()->allocate(mu * ((m[1] + 1) * (m[1] + 1) + n * ((id[1] == HPDDM_VARIANT_RIGHT ? 3 : 2) + m[1] * (id[1] == HPDDM_VARIANT_FLEXIBLE ? 2 : 1)) + (!Wrapper<K>::is_complex ? m[1] + 1 : (m[1] + 2) / 2)) + (d && U && id[1] == HPDDM_VARIANT_RIGHT && id[4] / 4 == 0 ? n * std::max(k - mu * (m[1] - k + 2), 0) : 0), A.prefix());
     *H = s + ldh;
     for(unsigned short i = 1; i < m[1]; ++i) {
         H[i] = *H + i * ldh;
@@ -211,7 +264,7 @@ inline int IterativeMethod::GCRODR(const Operator& A, const K* const b, K* const
             for(unsigned short nu = 0; nu < mu; ++nu)
                 sn[nu] = std::real(Blas<K>::dot(&n, v[i] + nu * n, &i__1, v[i] + nu * n, &i__1));
         if(j == 1) {
-            MPI_Allreduce(MPI_IN_PLACE, norm, 2 * mu, Wrapper<K>::mpi_underlying_type(), MPI_SUM, comm);
+            allreduce(MPI_IN_PLACE, norm, 2 * mu, Wrapper<K>::mpi_underlying_type(), MPI_SUM, comm);
             for(unsigned short nu = 0; nu < mu; ++nu) {
                 norm[nu] = std::sqrt(norm[nu]);
                 if(norm[nu] < HPDDM_EPS)
@@ -227,7 +280,7 @@ inline int IterativeMethod::GCRODR(const Operator& A, const K* const b, K* const
             }
         }
         else
-            MPI_Allreduce(MPI_IN_PLACE, sn, mu, Wrapper<K>::mpi_underlying_type(), MPI_SUM, comm);
+            allreduce(MPI_IN_PLACE, sn, mu, Wrapper<K>::mpi_underlying_type(), MPI_SUM, comm);
         for(unsigned short nu = 0; nu < mu; ++nu) {
             if(hasConverged[nu] > 0)
                 hasConverged[nu] = 0;
@@ -251,7 +304,8 @@ inline int IterativeMethod::GCRODR(const Operator& A, const K* const b, K* const
             }
             if(U)
                 orthogonalization<excluded>(id[2] & 3, n, k, mu, C, v[i + 1], H[i], d, Ax, comm);
-            Arnoldi<excluded>(id[2], m[1], H, v, s, sn, n, i++, mu, d, Ax, comm, save, U ? k : 0);
+            Arnoldi<excluded>(id[2], m[1], H, v, v[i + 1], s, sn, n, i, mu, d, Ax, comm, save, U ? k : 0);
+            ++i;
             checkConvergence<4>(id[0], j, i, tol, mu, norm, s + i * mu, hasConverged, m[1]);
             if(std::find(hasConverged, hasConverged + mu, -m[1]) == hasConverged + mu) {
                 i += (U ? m[1] - k : m[1]);
@@ -277,7 +331,7 @@ inline int IterativeMethod::GCRODR(const Operator& A, const K* const b, K* const
                 }
             }
         }
-        updateSolRecycling<excluded>(A, id[1], n, x, H, s, v, sn, C, U, hasConverged, k, mu, Ax, comm);
+        updateSolRecycling<excluded>(A, id[1], id[4] / 4 != 0, n, x, H, s, v, sn, C, U, hasConverged, k, mu, Ax, comm);
         if(i == m[1]) {
             if(U)
                 i -= k;
@@ -376,7 +430,7 @@ inline int IterativeMethod::GCRODR(const Operator& A, const K* const b, K* const
                 if(excluded || !n) {
                     if(id[4] % 4 != HPDDM_RECYCLE_STRATEGY_B) {
                         std::fill_n(prod, k * active * (m[1] + 2), K());
-                        MPI_Allreduce(MPI_IN_PLACE, prod, k * active * (m[1] + 2), Wrapper<K>::mpi_type(), MPI_SUM, comm);
+                        allreduce(MPI_IN_PLACE, prod, k * active * (m[1] + 2), Wrapper<K>::mpi_type(), MPI_SUM, comm);
                     }
                 }
                 else {
@@ -399,7 +453,7 @@ inline int IterativeMethod::GCRODR(const Operator& A, const K* const b, K* const
                                     prod[k * active * info + k * nu + i] = Blas<K>::dot(&n, U + activeSet[nu] * n + i * ldv, &i__1, U + activeSet[nu] * n + i * ldv, &i__1);
                             }
                         }
-                        MPI_Allreduce(MPI_IN_PLACE, prod, k * active * (m[1] + 2), Wrapper<K>::mpi_type(), MPI_SUM, comm);
+                        allreduce(MPI_IN_PLACE, prod, k * active * (m[1] + 2), Wrapper<K>::mpi_type(), MPI_SUM, comm);
                         std::for_each(prod + k * active * (m[1] + 1), prod + k * active * (m[1] + 2), [](K& u) { u = 1.0 / std::sqrt(std::real(u)); });
                     }
                     for(unsigned short nu = 0; nu < active; ++nu) {
@@ -503,23 +557,290 @@ inline int IterativeMethod::GCRODR(const Operator& A, const K* const b, K* const
         if(converged)
             break;
     }
-    if(j != 0 && j != m[0] + 1 && id[4] / 4)
+    if(j != 0 && j != m[0] + 1 && A.snapshot().recycle_same_system)
         (*Option::get())[A.prefix("recycle_same_system")] += 1;
     convergence<4>(id[0], j, m[0]);
     delete [] hasConverged;
     A.end(allocate);
-    delete [] s;
-    delete [] *save;
+    Workspace<K>::get()->deallocate(s, A.prefix());
+    Workspace<K>::get()->deallocate(*save, A.prefix(), 1);
     delete [] H;
     return std::min(j, m[0]);
 }
 template<bool excluded, class Operator, class K>
+inline int IterativeMethod::GMRESDR(const Operator& A, const K* const b, K* const x, const int& mu, const MPI_Comm& comm) {
+    underlying_type<K> tol;
+    int k;
+    unsigned short m[2];
+    char id[4];
+    options<9>(A.snapshot(), &tol, &k, m, id);
+    if(k <= 0) {
+        if(id[0])
+            std::cout << "WARNING -- please choose a positive number of Ritz vectors to keep, now switching to GMRES" << std::endl;
+        return GMRES<excluded>(A, b, x, mu, comm);
+    }
+    const int n = excluded ? 0 : A.getDof();
+    const int ldv = mu * n;
+    const int ldh = m[1] + 1;
+    K** const v = new K*[m[1] * (id[1] == HPDDM_VARIANT_FLEXIBLE ? 2 : 1) + 1];
+    K* const H = Workspace<K>::get()->allocate(mu * ldh * (m[1] + 3) + ldv * (m[1] * (id[1] == HPDDM_VARIANT_FLEXIBLE ? 2 : 1) + 3) + (Wrapper<K>::is_complex ? mu : 2 * mu), A.prefix());
+    K* const c = H + mu * ldh * m[1];
+    K* const s = c + mu * ldh;
+    K* const y = s + mu * ldh;
+    *v = y + mu * ldh;
+    for(unsigned short i = 1; i < m[1] * (id[1] == HPDDM_VARIANT_FLEXIBLE ? 2 : 1) + 1; ++i)
+        v[i] = *v + i * ldv;
+    K* const Ax = *v + (m[1] * (id[1] == HPDDM_VARIANT_FLEXIBLE ? 2 : 1) + 1) * ldv;
+    underlying_type<K>* const norm = reinterpret_cast<underlying_type<K>*>(Ax + 2 * ldv);
+    underlying_type<K>* const sn = norm + mu;
+    const underlying_type<K>* const d = A.getScaling();
+    short* const hasConverged = new short[mu];
+    std::fill_n(hasConverged, mu, -m[1]);
+    unsigned short* const shift = new unsigned short[2 * mu]();
+    unsigned short* const kept = shift + mu;
+    underlying_type<K>* const rwork = Wrapper<K>::is_complex ? new underlying_type<K>[2 * m[1]] : nullptr;
+    int info, lwork = -1;
+    {
+        int row = m[1] + 1;
+        int dim = m[1];
+        K query;
+        Lapack<K>::geqrf(&row, &dim, nullptr, &row, nullptr, &query, &lwork, &info);
+        int size = std::max(static_cast<int>(std::real(query)), 4 * row);
+        Lapack<K>::mqr("L", "N", &row, &dim, &dim, nullptr, &row, nullptr, nullptr, &row, &query, &lwork, &info);
+        size = std::max(static_cast<int>(std::real(query)), size);
+        Lapack<K>::geev("N", "V", &dim, nullptr, &dim, nullptr, nullptr, nullptr, &i__1, nullptr, &dim, &query, &lwork, rwork, &info);
+        size = std::max(static_cast<int>(std::real(query)), size);
+        if(!excluded && n) {
+            Lapack<K>::mqr("R", "N", &n, &row, &dim, nullptr, &row, nullptr, nullptr, &ldv, &query, &lwork, &info);
+            size = std::max(static_cast<int>(std::real(query)), size);
+        }
+        lwork = size;
+    }
+    K* const work = new K[ldh * m[1] + m[1] + lwork];
+    const auto leastSquares = [&](unsigned short nu, int dim, K* const z) {
+        int row = dim + 1;
+        K* const tau = work + row * dim;
+        for(unsigned short i = 0; i < dim; ++i)
+            std::copy_n(H + nu * ldh * m[1] + i * ldh, row, work + i * row);
+        std::copy_n(c + nu * ldh, row, z);
+        Lapack<K>::geqrf(&row, &dim, work, &row, tau, tau + dim, &lwork, &info);
+        Lapack<K>::mqr("L", &(Wrapper<K>::transc), &row, &i__1, &dim, work, &row, tau, z, &row, tau + dim, &lwork, &info);
+        const underlying_type<K> res = std::abs(z[dim]);
+        Lapack<K>::trtrs("U", "N", "N", &dim, &i__1, work, &row, z, &row, &info);
+        return res;
+    };
+    unsigned short i = 0;
+    const auto columns = [&](unsigned short nu) { return (hasConverged[nu] < 0 ? i : (hasConverged[nu] > 0 ? hasConverged[nu] : shift[nu])) - shift[nu]; };
+    bool allocate = initializeNorm<excluded>(A, id[1], b, x, *v, n, Ax, norm, mu, 1);
+    if(!excluded)
+        A.GMV(x, id[1] == HPDDM_VARIANT_LEFT ? Ax : *v, mu);
+    Blas<K>::axpby(ldv, 1.0, b, 1, -1.0, id[1] == HPDDM_VARIANT_LEFT ? Ax : *v, 1);
+    if(id[1] == HPDDM_VARIANT_LEFT)
+        A.template apply<excluded>(Ax, *v, mu);
+    for(unsigned short nu = 0; nu < mu; ++nu) {
+        sn[nu] = 0.0;
+        for(unsigned int j = 0; j < n; ++j)
+            sn[nu] += (d ? d[j] : 1.0) * std::norm(v[0][nu * n + j]);
+    }
+    allreduce(MPI_IN_PLACE, norm, 2 * mu, Wrapper<K>::mpi_underlying_type(), MPI_SUM, comm);
+    unsigned short j = 1;
+    for(unsigned short nu = 0; nu < mu; ++nu) {
+        norm[nu] = std::sqrt(norm[nu]);
+        if(norm[nu] < HPDDM_EPS)
+            norm[nu] = 1.0;
+        if(100 * sn[nu] < std::numeric_limits<underlying_type<K>>::epsilon()) {
+            j = 0;
+            break;
+        }
+    }
+    if(j == 0)
+        std::fill_n(hasConverged, mu, 0);
+    else {
+        std::fill_n(H, mu * ldh * (m[1] + 1), K());
+        for(unsigned short nu = 0; nu < mu; ++nu) {
+            c[nu * ldh] = std::sqrt(sn[nu]);
+            std::for_each(*v + nu * n, *v + (nu + 1) * n, [&](K& z) { z /= c[nu * ldh]; });
+        }
+    }
+    while(j != 0) {
+        while(i < m[1] && j <= m[0]) {
+            if(id[1] == HPDDM_VARIANT_LEFT) {
+                if(!excluded)
+                    A.GMV(v[i], Ax, mu);
+                A.template apply<excluded>(Ax, v[i + 1], mu);
+            }
+            else {
+                A.template apply<excluded>(v[i], id[1] == HPDDM_VARIANT_FLEXIBLE ? v[i + m[1] + 1] : Ax, mu, v[i + 1]);
+                if(!excluded)
+                    A.GMV(id[1] == HPDDM_VARIANT_FLEXIBLE ? v[i + m[1] + 1] : Ax, v[i + 1], mu);
+            }
+            orthogonalization<excluded>(id[2] & 3, n, i + 1, mu, *v, v[i + 1], s, d, Ax, comm);
+            for(unsigned short nu = 0; nu < mu; ++nu) {
+                sn[nu] = 0.0;
+                for(unsigned int l = 0; l < n; ++l)
+                    sn[nu] += (d ? d[l] : 1.0) * std::norm(v[i + 1][nu * n + l]);
+            }
+            allreduce(MPI_IN_PLACE, sn, mu, Wrapper<K>::mpi_underlying_type(), MPI_SUM, comm);
+            for(unsigned short nu = 0; nu < mu; ++nu) {
+                K* const h = H + nu * ldh * m[1] + (i - shift[nu]) * ldh;
+                for(unsigned short l = shift[nu]; l < i + 1; ++l)
+                    h[l - shift[nu]] = s[l * mu + nu];
+                h[i + 1 - shift[nu]] = std::sqrt(sn[nu]);
+                std::for_each(v[i + 1] + nu * n, v[i + 1] + (nu + 1) * n, [&](K& z) { z /= h[i + 1 - shift[nu]]; });
+            }
+            ++i;
+            for(unsigned short nu = 0; nu < mu; ++nu)
+                s[nu] = leastSquares(nu, i - shift[nu], y + nu * ldh);
+            checkConvergence<9>(id[0], j, i, tol, mu, norm, s, hasConverged, m[1]);
+            if(std::find(hasConverged, hasConverged + mu, -m[1]) == hasConverged + mu)
+                break;
+            else
+                ++j;
+        }
+        const bool converged = (j == m[0] + 1 || std::find(hasConverged, hasConverged + mu, -m[1]) == hasConverged + mu);
+        for(unsigned short nu = 0; nu < mu; ++nu) {
+            int dim = columns(nu);
+            if(dim)
+                leastSquares(nu, dim, y + nu * ldh);
+            if(!excluded && n) {
+                if(id[1] == HPDDM_VARIANT_RIGHT)
+                    Blas<K>::gemv("N", &n, &dim, &(Wrapper<K>::d__1), v[shift[nu]] + nu * n, &ldv, y + nu * ldh, &i__1, &(Wrapper<K>::d__0), Ax + nu * n, &i__1);
+                else if(dim)
+                    Blas<K>::gemv("N", &n, &dim, &(Wrapper<K>::d__1), v[shift[nu] + (id[1] == HPDDM_VARIANT_FLEXIBLE ? m[1] + 1 : 0)] + nu * n, &ldv, y + nu * ldh, &i__1, &(Wrapper<K>::d__1), x + nu * n, &i__1);
+            }
+        }
+        if(id[1] == HPDDM_VARIANT_RIGHT) {
+            A.template apply<excluded>(Ax, Ax + ldv, mu);
+            if(!excluded && n)
+                for(unsigned short nu = 0; nu < mu; ++nu)
+                    if(columns(nu))
+                        Blas<K>::axpy(&n, &(Wrapper<K>::d__1), Ax + ldv + nu * n, &i__1, x + nu * n, &i__1);
+        }
+        if(converged)
+            break;
+        K* const T = new K[ldh * (5 * ldh + 5)];
+        K* const vr = T + ldh * ldh;
+        K* const P = vr + ldh * ldh;
+        K* const E = P + ldh * ldh;
+        K* const prod = E + ldh * ldh;
+        K* const w = prod + ldh * ldh;
+        K* const f = w + 2 * ldh;
+        K* const tau = f + ldh;
+        K* const r = tau + ldh;
+        int* const ipiv = new int[m[1]];
+        for(unsigned short nu = 0; nu < mu; ++nu) {
+            int dim = m[1] - shift[nu];
+            int row = dim + 1;
+            K* const h = H + nu * ldh * m[1];
+            leastSquares(nu, dim, y + nu * ldh);
+            std::copy_n(c + nu * ldh, row, r);
+            Blas<K>::gemv("N", &row, &dim, &(Wrapper<K>::d__2), h, &ldh, y + nu * ldh, &i__1, &(Wrapper<K>::d__1), r, &i__1);
+            for(unsigned short l = 0; l < dim; ++l)
+                std::copy_n(h + l * ldh, dim, T + l * dim);
+            Lapack<K>::getrf(&dim, &dim, T, &dim, ipiv, &info);
+            std::fill_n(f, dim, K());
+            f[dim - 1] = Wrapper<K>::d__1;
+            Lapack<K>::getrs(&(Wrapper<K>::transc), &dim, &i__1, T, &dim, ipiv, f, &dim, &info);
+            for(unsigned short l = 0; l < dim; ++l)
+                std::copy_n(h + l * ldh, dim, T + l * dim);
+            K alpha = std::norm(h[dim + (dim - 1) * ldh]);
+            Blas<K>::axpy(&dim, &alpha, f, &i__1, T + (dim - 1) * dim, &i__1);
+            Lapack<K>::geev("N", "V", &dim, T, &dim, w, w + dim, nullptr, &i__1, vr, &dim, work, &lwork, rwork, &info);
+            std::vector<std::pair<unsigned short, std::complex<underlying_type<K>>>> q;
+            q.reserve(dim);
+            selectNu(id[3], q, dim, w, w + dim);
+            int l = 0;
+            for(typename decltype(q)::const_iterator it = q.cbegin(); it < q.cend() && l < k; ++it) {
+                if(Wrapper<K>::is_complex || std::real(w[dim + it->first]) == underlying_type<K>())
+                    ipiv[l++] = it->first;
+                else {
+                    const int first = it->first - (std::real(w[dim + it->first]) < underlying_type<K>() ? 1 : 0);
+                    if(std::find(ipiv, ipiv + l, first) == ipiv + l) {
+                        if(l + 2 > std::min(k + 1, m[1] - 1))
+                            break;
+                        ipiv[l++] = first;
+                        ipiv[l++] = first + 1;
+                    }
+                }
+            }
+            kept[nu] = l;
+            int col = l + 1;
+            for(unsigned short z = 0; z < l; ++z) {
+                std::copy_n(vr + ipiv[z] * dim, dim, P + z * row);
+                P[z * row + dim] = K();
+            }
+            std::copy_n(r, row, P + l * row);
+            Lapack<K>::geqrf(&row, &col, P, &row, tau, work, &lwork, &info);
+            std::fill_n(E, row * col, K());
+            for(unsigned short z = 0; z < col; ++z)
+                E[z * (row + 1)] = Wrapper<K>::d__1;
+            Lapack<K>::mqr("L", "N", &row, &col, &col, P, &row, tau, E, &row, work, &lwork, &info);
+            std::fill_n(c + nu * ldh, ldh, K());
+            Blas<K>::gemv(&(Wrapper<K>::transc), &row, &col, &(Wrapper<K>::d__1), E, &row, r, &i__1, &(Wrapper<K>::d__0), c + nu * ldh, &i__1);
+            if(l)
+                Blas<K>::gemm("N", "N", &row, &l, &dim, &(Wrapper<K>::d__1), h, &ldh, E, &row, &(Wrapper<K>::d__0), prod, &row);
+            std::fill_n(h, ldh * m[1], K());
+            if(l)
+                Blas<K>::gemm(&(Wrapper<K>::transc), "N", &col, &l, &row, &(Wrapper<K>::d__1), E, &row, prod, &row, &(Wrapper<K>::d__0), h, &ldh);
+            if(!excluded && n) {
+                Lapack<K>::mqr("R", "N", &n, &row, &col, P, &row, tau, v[shift[nu]] + nu * n, &ldv, work, &lwork, &info);
+                if(id[1] == HPDDM_VARIANT_FLEXIBLE && l) {
+                    for(unsigned short z = 0; z < l; ++z)
+                        std::copy_n(E + z * row, dim, T + z * dim);
+                    Lapack<K>::geqrf(&dim, &l, T, &dim, tau, work, &lwork, &info);
+                    Lapack<K>::mqr("R", "N", &n, &dim, &l, T, &dim, tau, v[shift[nu] + m[1] + 1] + nu * n, &ldv, work, &lwork, &info);
+                    Blas<K>::trmm("R", "U", "N", "N", &n, &l, &(Wrapper<K>::d__1), T, &dim, v[shift[nu] + m[1] + 1] + nu * n, &ldv);
+                }
+            }
+        }
+        delete [] ipiv;
+        delete [] T;
+        i = *std::max_element(kept, kept + mu);
+        for(unsigned short nu = 0; nu < mu; ++nu) {
+            const unsigned short o = i - kept[nu];
+            if(!excluded && n && o != shift[nu]) {
+                for(unsigned short l = 0; l < kept[nu] + 1; ++l) {
+                    const unsigned short z = (o > shift[nu] ? kept[nu] - l : l);
+                    std::copy_n(v[shift[nu] + z] + nu * n, n, v[o + z] + nu * n);
+                    if(id[1] == HPDDM_VARIANT_FLEXIBLE && z < kept[nu])
+                        std::copy_n(v[shift[nu] + z + m[1] + 1] + nu * n, n, v[o + z + m[1] + 1] + nu * n);
+                }
+                for(unsigned short l = 0; l < o; ++l)
+                    std::fill_n(v[l] + nu * n, n, K());
+            }
+            shift[nu] = o;
+            if(hasConverged[nu] > 0)
+                hasConverged[nu] = 0;
+        }
+        if(!excluded)
+            A.GMV(x, id[1] == HPDDM_VARIANT_LEFT ? Ax + ldv : Ax, mu);
+        Blas<K>::axpby(ldv, 1.0, b, 1, -1.0, id[1] == HPDDM_VARIANT_LEFT ? Ax + ldv : Ax, 1);
+        if(id[1] == HPDDM_VARIANT_LEFT)
+            A.template apply<excluded>(Ax + ldv, Ax, mu);
+        orthogonalization<excluded>(id[2] & 3, n, i + 1, mu, *v, Ax, s, d, Ax + ldv, comm);
+        for(unsigned short nu = 0; nu < mu; ++nu)
+            for(unsigned short l = shift[nu]; l < i + 1; ++l)
+                c[nu * ldh + l - shift[nu]] = s[l * mu + nu];
+        if(id[0] > 1)
+            std::cout << "GMRES-DR restart(" << m[1] << ", " << k << ")" << std::endl;
+    }
+    convergence<9>(id[0], j, m[0]);
+    delete [] rwork;
+    delete [] work;
+    delete [] shift;
+    delete [] hasConverged;
+    A.end(allocate);
+    Workspace<K>::get()->deallocate(H, A.prefix());
+    delete [] v;
+    return std::min(j, m[0]);
+}
+template<bool excluded, class Operator, class K>
 inline int IterativeMethod::BGCRODR(const Operator& A, const K* const b, K* const x, const int& mu, const MPI_Comm& comm) {
     underlying_type<K> tol[2];
     int k;
     unsigned short m[3];
     char id[5];
-    options<5>(A.prefix(), tol, &k, m, id);
+    options<5>(A.snapshot(), tol, &k, m, id);
     if(k <= 0) {
         if(id[0])
             std::cout << "WARNING -- please choose a positive number of Ritz vectors to compute, now switching to BGMRES" << std::endl;
@@ -529,7 +850,8 @@ inline int IterativeMethod::BGCRODR(const Operator& A, const K* const b, K* cons
     int ldh = mu * (m[1] + 1);
     K** const H = new K*[m[1] * (id[1] == HPDDM_VARIANT_FLEXIBLE ? 4 : 3) + 1];
     K** const save = H + m[1];
-    *save = new K[ldh * mu * m[1]]();
+    *save = Workspace<K>::get()->allocate(ldh * mu * m[1], A.prefix(), 1);
+    std::fill_n(*save, ldh * mu * m[1], K());
     K** const v = save + m[1];
     int info;
     int N = 2 * mu;
@@ -541,15 +863,17 @@ inline int IterativeMethod::BGCRODR(const Operator& A, const K* const b, K* cons
         k = recycled.k(A.prefix());
         C = U + k * ldv;
     }
+    if(id[4] / 4 == 0 && recycled.template unchanged<excluded>(A, comm))
+        id[4] += 4;
     int lwork = mu * (d ? (n + (id[1] == HPDDM_VARIANT_RIGHT ? std::max(n, ldh) : ldh)) : std::max((id[1] == HPDDM_VARIANT_RIGHT ? 2 : 1) * n, ldh));
-    *H = new K[lwork + (d && U && id[1] == HPDDM_VARIANT_RIGHT && id[4] / 4 == 0 ? mu * n * std::max(2 * k - m[1] - 2, 0) : 0) + mu * ((m[1] + 1) * ldh + n * (m[1] * (id[1] == HPDDM_VARIANT_FLEXIBLE ? 2 : 1) + 1) + 2 * m[1]) + (Wrapper<K>::is_complex ? (mu + 1) / 2 : mu)];
+    *H = Workspace<K>::get()->allocate(lwork + (d && U && id[1] == HPDDM_VARIANT_RIGHT && id[4] / 4 == 0 ? mu * n * std::max(2 * k - m[1] - 2, 0) : 0) + mu * ((m[1] + 1) * ldh + n * (m[1] * (id[1] == HPDDM_VARIANT_FLEXIBLE ? 2 : 1) + 1) + 2 * m[1]) + (Wrapper<K>::is_complex ? (mu + 1) / 2 : mu), A.prefix());
     *v = *H + m[1] * mu * ldh;
     K* const Ax = *v + ldv * (m[1] * (id[1] == HPDDM_VARIANT_FLEXIBLE ? 2 : 1) + 1);
     K* const s = Ax + lwork + (d && U && id[1] == HPDDM_VARIANT_RIGHT && id[4] / 4 == 0 ? mu * n * std::max(2 * k - m[1] - 2, 0) : 0);
     K* const tau = s + mu * ldh;
     underlying_type<K>* const norm = reinterpret_cast<underlying_type<K>*>(tau + m[1] * N);
     bool allocate = initializeNorm<excluded>(A, id[1], b, x, *v, n, Ax, norm, mu, m[2]);
-    MPI_Allreduce(MPI_IN_PLACE, norm, mu / m[2], Wrapper<K>::mpi_underlying_type(), MPI_SUM, comm);
+    allreduce(MPI_IN_PLACE, norm, mu / m[2], Wrapper<K>::mpi_underlying_type(), MPI_SUM, comm);
     for(unsigned short nu = 0; nu < mu / m[2]; ++nu) {
         norm[nu] = std::sqrt(norm[nu]);
         if(norm[nu] < HPDDM_EPS)
@@ -688,7 +1012,7 @@ inline int IterativeMethod::BGCRODR(const Operator& A, const K* const b, K* cons
                     dim = deflated * (rem + (U ? k : 0));
             }
         }
-        updateSolRecycling<excluded>(A, id[1], n, x, H, s, v, s, C, U, &dim, k, mu, Ax, comm, deflated);
+        updateSolRecycling<excluded>(A, id[1], id[4] / 4 != 0, n, x, H, s, v, s, C, U, &dim, k, mu, Ax, comm, deflated);
         if(tol[1] > -0.9)
             Lapack<K>::lapmt(&i__0, &n, &mu, x, &n, piv);
         if(i == m[1] && ((id[2] >> 2) & 7) == 0) {
@@ -764,7 +1088,7 @@ inline int IterativeMethod::BGCRODR(const Operator& A, const K* const b, K* cons
                 if(excluded || !n) {
                     if(id[4] % 4 != 1) {
                         std::fill_n(prod, bK * (dim + deflated + 1), K());
-                        MPI_Allreduce(MPI_IN_PLACE, prod, bK * (dim + deflated + 1), Wrapper<K>::mpi_type(), MPI_SUM, comm);
+                        allreduce(MPI_IN_PLACE, prod, bK * (dim + deflated + 1), Wrapper<K>::mpi_type(), MPI_SUM, comm);
                     }
                 }
                 else {
@@ -788,7 +1112,7 @@ inline int IterativeMethod::BGCRODR(const Operator& A, const K* const b, K* cons
                             for(unsigned short nu = 0; nu < bK; ++nu)
                                 prod[bK * (dim + deflated) + nu] = Blas<K>::dot(&n, U + nu * n, &i__1, U + nu * n, &i__1);
                         }
-                        MPI_Allreduce(MPI_IN_PLACE, prod, bK * (dim + deflated + 1), Wrapper<K>::mpi_type(), MPI_SUM, comm);
+                        allreduce(MPI_IN_PLACE, prod, bK * (dim + deflated + 1), Wrapper<K>::mpi_type(), MPI_SUM, comm);
                         for(unsigned short nu = 0; nu < bK; ++nu) {
                             prod[bK * (dim + deflated) + nu] = 1.0 / std::sqrt(std::real(prod[bK * (dim + deflated) + nu]));
                             Blas<K>::scal(&n, prod + bK * (dim + deflated) + nu, U + nu * n, &i__1);
@@ -885,12 +1209,12 @@ inline int IterativeMethod::BGCRODR(const Operator& A, const K* const b, K* cons
         if(converged)
             break;
     }
-    if(j != 0 && j != m[0] + 1 && id[4] / 4)
+    if(j != 0 && j != m[0] + 1 && A.snapshot().recycle_same_system)
         (*Option::get())[A.prefix("recycle_same_system")] += 1;
     delete [] piv;
     A.end(allocate);
-    delete [] *H;
-    delete [] *save;
+    Workspace<K>::get()->deallocate(*H, A.prefix());
+    Workspace<K>::get()->deallocate(*save, A.prefix(), 1);
     delete [] H;
     if(j != 0 || deflated == -1) {
         convergence<5>(id[0], j, m[0]);
@@ -27,47 +27,54 @@
 #include "iterative.hpp"
 
 namespace HPDDM {
-template<bool excluded, class Operator, class K>
+template<bool excluded, class Operator, class K, class T>
 inline int IterativeMethod::GMRES(const Operator& A, const K* const b, K* const x, const int& mu, const MPI_Comm& comm) {
     underlying_type<K> tol;
     unsigned short m[2];
-    char id[3];
-    options<0>(A.prefix(), &tol, nullptr, m, id);
+    char id[4];
+    options<0>(A.snapshot(), &tol, nullptr, m, id);
+    if(std::is_same<K, T>::value && id[3] == HPDDM_GMRES_BASIS_PRECISION_REDUCED && !std::is_same<downscaled_type<K, true>, K>::value)
+        return GMRES<excluded, Operator, K, downscaled_type<K, true>>(A, b, x, mu, comm);
     const int n = excluded ? 0 : A.getDof();
-    K** const H = new K*[m[1] * (id[1] == HPDDM_VARIANT_FLEXIBLE ? 3 : 2) + 1];
-    K** const v = H + m[1];
-    K* const s = new K[mu * ((m[1] + 1) * (m[1] + 1) + n * (2 + m[1] * (id[1] == HPDDM_VARIANT_FLEXIBLE ? 2 : 1)) + (!Wrapper<K>::is_complex ? m[1] + 1 : (m[1] + 2) / 2))];
+    K** const H = new K*[m[1]];
+    T** const v = new T*[m[1] * (id[1] == HPDDM_VARIANT_FLEXIBLE ? 2 : 1) + 1];
+    // a basis stored in a lower precision has its own workspace, and three vectors in the working precision are needed instead
+    K* const s = Workspace<K>::get()->allocate(mu * ((m[1] + 1) * (m[1] + 1) + n * (std::is_same<K, T>::value ? 2 + m[1] * (id[1] == HPDDM_VARIANT_FLEXIBLE ? 2 : 1) : 3) + (!Wrapper<K>::is_complex ? m[1] + 1 : (m[1] + 2) / 2)), A.prefix());
     K* const Ax = s + mu * (m[1] + 1);
-    *H = Ax + mu * n;
+    K* const u = std::is_same<K, T>::value ? nullptr : Ax + mu * n;
+    K* const w = std::is_same<K, T>::value ? nullptr : u + mu * n;
+    *H = Ax + (std::is_same<K, T>::value ? 1 : 3) * mu * n;
     for(unsigned short i = 1; i < m[1]; ++i)
         H[i] = *H + i * mu * (m[1] + 1);
-    *v = *H + m[1] * mu * (m[1] + 1);
+    K* const last = *H + m[1] * mu * (m[1] + 1);
+    *v = std::is_same<K, T>::value ? reinterpret_cast<T*>(last) : Workspace<T>::get()->allocate((m[1] * (id[1] == HPDDM_VARIANT_FLEXIBLE ? 2 : 1) + 1) * mu * n, A.prefix());
     for(unsigned short i = 1; i < m[1] * (id[1] == HPDDM_VARIANT_FLEXIBLE ? 2 : 1) + 1; ++i)
         v[i] = *v + i * mu * n;
-    underlying_type<K>* const norm = reinterpret_cast<underlying_type<K>*>(*v + (m[1] * (id[1] == HPDDM_VARIANT_FLEXIBLE ? 2 : 1) + 1) * mu * n);
+    underlying_type<K>* const norm = reinterpret_cast<underlying_type<K>*>(last + (std::is_same<K, T>::value ? (m[1] * (id[1] == HPDDM_VARIANT_FLEXIBLE ? 2 : 1) + 1) * mu * n : 0));
     underlying_type<K>* const sn = norm + mu;
     const underlying_type<K>* const d = A.getScaling();
     short* const hasConverged = new short[mu];
     std::fill_n(hasConverged, mu, -m[1]);
-    bool allocate = initializeNorm<excluded>(A, id[1], b, x, *v, n, Ax, norm, mu, 1);
+    K* const r = working(*v, w);
+    bool allocate = initializeNorm<excluded>(A, id[1], b, x, r, n, Ax, norm, mu, 1);
     unsigned short j = 1;
     while(j <= m[0]) {
         if(!excluded)
-            A.GMV(x, id[1] == HPDDM_VARIANT_LEFT ? Ax : *v, mu);
-        Blas<K>::axpby(mu * n, 1.0, b, 1, -1.0, id[1] == HPDDM_VARIANT_LEFT ? Ax : *v, 1);
+            A.GMV(x, id[1] == HPDDM_VARIANT_LEFT ? Ax : r, mu);
+        Blas<K>::axpby(mu * n, 1.0, b, 1, -1.0, id[1] == HPDDM_VARIANT_LEFT ? Ax : r, 1);
         if(id[1] == HPDDM_VARIANT_LEFT)
-            A.template apply<excluded>(Ax, *v, mu);
+            A.template apply<excluded>(Ax, r, mu);
         if(d)
             for(unsigned short nu = 0; nu < mu; ++nu) {
                 sn[nu] = 0.0;
                 for(unsigned int j = 0; j < n; ++j)
-                    sn[nu] += d[j] * std::norm(v[0][nu * n + j]);
+                    sn[nu] += d[j] * std::norm(r[nu * n + j]);
             }
         else
             for(unsigned short nu = 0; nu < mu; ++nu)
-                sn[nu] = std::real(Blas<K>::dot(&n, *v + nu * n, &i__1, *v + nu * n, &i__1));
+                sn[nu] = std::real(Blas<K>::dot(&n, r + nu * n, &i__1, r + nu * n, &i__1));
         if(j == 1) {
-            MPI_Allreduce(MPI_IN_PLACE, norm, 2 * mu, Wrapper<K>::mpi_underlying_type(), MPI_SUM, comm);
+            allreduce(MPI_IN_PLACE, norm, 2 * mu, Wrapper<K>::mpi_underlying_type(), MPI_SUM, comm);
             for(unsigned short nu = 0; nu < mu; ++nu) {
                 norm[nu] = std::sqrt(norm[nu]);
                 if(norm[nu] < HPDDM_EPS)
@@ -79,7 +86,7 @@ inline int IterativeMethod::GMRES(const Operator& A, const K* const b, K* const
             }
         }
         else
-            MPI_Allreduce(MPI_IN_PLACE, sn, mu, Wrapper<K>::mpi_underlying_type(), MPI_SUM, comm);
+            allreduce(MPI_IN_PLACE, sn, mu, Wrapper<K>::mpi_underlying_type(), MPI_SUM, comm);
         if(j == 0) {
             std::fill_n(hasConverged, mu, 0);
             break;
@@ -88,21 +95,29 @@ inline int IterativeMethod::GMRES(const Operator& A, const K* const b, K* const
             if(hasConverged[nu] > 0)
                 hasConverged[nu] = 0;
             s[nu] = std::sqrt(sn[nu]);
-            std::for_each(*v + nu * n, *v + (nu + 1) * n, [&](K& y) { y /= s[nu]; });
+            std::transform(r + nu * n, r + (nu + 1) * n, *v + nu * n, [&](const K& y) { return y / s[nu]; });
         }
         unsigned short i = 0;
         while(i < m[1] && j <= m[0]) {
+            const K* const vi = upcast(v[i], mu * n, u);
+            K* const wi = working(v[i + 1], w);
             if(id[1] == HPDDM_VARIANT_LEFT) {
                 if(!excluded)
-                    A.GMV(v[i], Ax, mu);
-                A.template apply<excluded>(Ax, v[i + 1], mu);
+                    A.GMV(vi, Ax, mu);
+                A.template apply<excluded>(Ax, wi, mu);
             }
             else {
-                A.template apply<excluded>(v[i], id[1] == HPDDM_VARIANT_FLEXIBLE ? v[i + m[1] + 1] : Ax, mu, v[i + 1]);
+                K* const z = id[1] == HPDDM_VARIANT_FLEXIBLE ? working(v[i + m[1] + 1], Ax) : Ax;
+                A.template apply<excluded>(vi, z, mu, wi);
+                if(id[1] == HPDDM_VARIANT_FLEXIBLE && !std::is_same<K, T>::value) {
+                    // the operator is applied to the rounded preconditioned vectors, which are the ones used by updateSol
+                    std::copy_n(Ax, mu * n, v[i + m[1] + 1]);
+                    std::copy_n(v[i + m[1] + 1], mu * n, Ax);
+                }
                 if(!excluded)
-                    A.GMV(id[1] == HPDDM_VARIANT_FLEXIBLE ? v[i + m[1] + 1] : Ax, v[i + 1], mu);
+                    A.GMV(z, wi, mu);
             }
-            Arnoldi<excluded>(id[2], m[1], H, v, s, sn, n, i++, mu, d, Ax, comm);
+            Arnoldi<excluded>(id[2], m[1], H, v, wi, s, sn, n, i++, mu, d, Ax, comm);
             checkConvergence<0>(id[0], j, i, tol, mu, norm, s + i * mu, hasConverged, m[1]);
             if(std::find(hasConverged, hasConverged + mu, -m[1]) == hasConverged + mu) {
                 i = 0;
@@ -127,7 +142,10 @@ inline int IterativeMethod::GMRES(const Operator& A, const K* const b, K* const
     convergence<0>(id[0], j, m[0]);
     delete [] hasConverged;
     A.end(allocate);
-    delete [] s;
+    if(!std::is_same<K, T>::value)
+        Workspace<T>::get()->deallocate(*v, A.prefix());
+    delete [] v;
+    Workspace<K>::get()->deallocate(s, A.prefix());
     delete [] H;
     return std::min(j, m[0]);
 }
@@ -136,7 +154,7 @@ inline int IterativeMethod::BGMRES(const Operator& A, const K* const b, K* const
     underlying_type<K> tol[2];
     unsigned short m[3];
     char id[3];
-    options<1>(A.prefix(), tol, nullptr, m, id);
+    options<1>(A.snapshot(), tol, nullptr, m, id);
     const int n = excluded ? 0 : A.getDof();
     K** const H = new K*[m[1] * (id[1] == HPDDM_VARIANT_FLEXIBLE ? 3 : 2) + 1];
     K** const v = H + m[1];
@@ -145,14 +163,14 @@ inline int IterativeMethod::BGMRES(const Operator& A, const K* const b, K* const
     int N = 2 * mu;
     const underlying_type<K>* const d = A.getScaling();
     int lwork = mu * (d ? n + ldh : std::max(n, ldh));
-    *H = new K[lwork + mu * ((m[1] + 1) * ldh + n * (m[1] * (id[1] == HPDDM_VARIANT_FLEXIBLE ? 2 : 1) + 1) + 2 * m[1]) + (Wrapper<K>::is_complex ? (mu + 1) / 2 : mu)];
+    *H = Workspace<K>::get()->allocate(lwork + mu * ((m[1] + 1) * ldh + n * (m[1] * (id[1] == HPDDM_VARIANT_FLEXIBLE ? 2 : 1) + 1) + 2 * m[1]) + (Wrapper<K>::is_complex ? (mu + 1) / 2 : mu), A.prefix());
     *v = *H + m[1] * mu * ldh;
     K* const s = *v + mu * n * (m[1] * (id[1] == HPDDM_VARIANT_FLEXIBLE ? 2 : 1) + 1);
     K* const tau = s + mu * ldh;
     K* const Ax = tau + m[1] * N;
     underlying_type<K>* const norm = reinterpret_cast<underlying_type<K>*>(Ax + lwork);
     bool allocate = initializeNorm<excluded>(A, id[1], b, x, *v, n, Ax, norm, mu, m[2]);
-    MPI_Allreduce(MPI_IN_PLACE, norm, mu / m[2], Wrapper<K>::mpi_underlying_type(), MPI_SUM, comm);
+    allreduce(MPI_IN_PLACE, norm, mu / m[2], Wrapper<K>::mpi_underlying_type(), MPI_SUM, comm);
     for(unsigned short nu = 0; nu < mu / m[2]; ++nu) {
         norm[nu] = std::sqrt(norm[nu]);
         if(norm[nu] < HPDDM_EPS)
@@ -247,7 +265,7 @@ inline int IterativeMethod::BGMRES(const Operator& A, const K* const b, K* const
     }
     delete [] piv;
     A.end(allocate);
-    delete [] *H;
+    Workspace<K>::get()->deallocate(*H, A.prefix());
     delete [] H;
     if(j != 0 || deflated == -1) {
         convergence<1>(id[0], j, m[0]);
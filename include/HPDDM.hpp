@@ -44,6 +44,7 @@
  *    HPDDM_PETSC         - PETSc KSP interface enabled.
  *    HPDDM_QR            - If not set to zero, pseudo-inverses of Schur complements are computed using dense QR decompositions (with pivoting if set to one, without pivoting otherwise).
  *    HPDDM_ICOLLECTIVE   - If possible, use nonblocking MPI collective operations.
+ *    HPDDM_TRACE         - Timelines of the main phases may be recorded, see the option trace.
  *    HPDDM_MIXED_PRECISION - Use mixed precision arithmetic for the assembly of coarse operators.
  *    HPDDM_INEXACT_COARSE_OPERATOR - Solve coarse systems using a Krylov method.
  *    HPDDM_LIBXSMM       - Block sparse matrices products are computed using LIBXSMM. */
@@ -101,6 +102,9 @@ static_assert(HPDDM_NUMBERING == 'C' || HPDDM_NUMBERING == 'F', "Unknown numberi
 #ifndef HPDDM_ICOLLECTIVE
 # define HPDDM_ICOLLECTIVE    0
 #endif
+#ifndef HPDDM_TRACE
+# define HPDDM_TRACE          0
+#endif
 #ifndef HPDDM_MIXED_PRECISION
 # define HPDDM_MIXED_PRECISION 0
 #endif
@@ -185,6 +189,7 @@ static_assert(HPDDM_NUMBERING == 'C' || HPDDM_NUMBERING == 'F', "Unknown numberi
 # include <numeric>
 # include <functional>
 # include <memory>
+# include <atomic>
 # if !__cpp_rtti && !defined(__GXX_RTTI) && !defined(__INTEL_RTTI__) && !defined(_CPPRTTI)
 #  pragma message("Consider enabling RTTI support with your C++ compiler")
 # endif
@@ -288,8 +293,8 @@ template<class T>
 using underlying_type = typename underlying_type_spec<T>::type;
 template<class T>
 using pod_type = typename std::conditional<std::is_same<underlying_type<T>, T>::value, T, void*>::type;
-template<class T>
-using downscaled_type = typename std::conditional<HPDDM_MIXED_PRECISION && std::is_same<underlying_type<T>, T>::value, float, typename std::conditional<HPDDM_MIXED_PRECISION, std::complex<float>, T>::type>::type;
+template<class T, bool B = HPDDM_MIXED_PRECISION>
+using downscaled_type = typename std::conditional<B && std::is_same<underlying_type<T>, T>::value, float, typename std::conditional<B, std::complex<float>, T>::type>::type;
 
 template<class>
 struct hpddm_method_id { static constexpr char value = 0; };
@@ -302,6 +307,12 @@ inline void hash_range(std::size_t& seed, T begin, T end) {
     while(begin != end)
         seed ^= hasher(*begin++) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
 }
+/* Function: nextVersion
+ *  Returns a new value of a counter shared by all operators of the process, so that two operators never have the same version, see <Recycling::unchanged>. */
+inline unsigned int nextVersion() {
+    static std::atomic<unsigned int> version(0);
+    return ++version;
+}
 } // HPDDM
 # if (!defined(__clang__) && defined(__GNUC__)) || (defined(__INTEL_COMPILER) && defined(__GNUC__))
 #  if (__GNUC__ * 10000 + __GNUC_MINOR__ * 100) < 40900
@@ -360,6 +371,9 @@ inline void hash_range(std::size_t& seed, T begin, T end) {
 #  ifdef DISSECTIONSUB
 #   include "Dissection.hpp"
 #  endif
+#  ifdef ILUSUB
+#   include "ILU.hpp"
+#  endif
 #  if defined(DLAPACK) || defined(LAPACKSUB)
 #   include "LAPACK.hpp"
 #  endif
@@ -397,6 +411,7 @@ inline void hash_range(std::size_t& seed, T begin, T end) {
 
 #  if !HPDDM_MPI
 #   define MPI_Allreduce(a, b, c, d, e, f) (void)f
+#   define allreduce(a, b, c, d, e, f) (void)f
 #   define MPI_Comm_size(a, b) *b = 1
 #   define MPI_Comm_rank(a, b) *b = 0
 #   define MPI_COMM_SELF 0
@@ -405,12 +420,16 @@ typedef int MPI_Request;
 #  endif
 #  include "GCRODR.hpp"
 #  include "CG.hpp"
+#  include "IDR.hpp"
+#  include "polynomial.hpp"
 #  if !HPDDM_MPI
 #   undef MPI_COMM_SELF
 #   undef MPI_Comm_rank
 #   undef MPI_Comm_size
 #   undef MPI_Allreduce
+#   undef allreduce
 #  else
+#   include "batch.hpp"
 #   include "schwarz.hpp"
 template<class K = double, char S = 'S'>
 using HpSchwarz = HPDDM::Schwarz<
@@ -0,0 +1,362 @@
+ /*
+   This file is part of HPDDM.
+
+   Author(s): Pierre Jolivet <pierre.jolivet@enseeiht.fr>
+        Date: 2026-10-18
+
+   Copyright (C) 2026-     Centre National de la Recherche Scientifique
+
+   HPDDM is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published
+   by the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   HPDDM is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with HPDDM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _HPDDM_IDR_
+#define _HPDDM_IDR_
+
+#include <random>
+#include "iterative.hpp"
+
+namespace HPDDM {
+template<bool excluded, class Operator, class K>
+inline int IterativeMethod::IDR(const Operator& A, const K* const b, K* const x, const int& mu, const MPI_Comm& comm) {
+    underlying_type<K> tol;
+    unsigned short m[2];
+    char id[2];
+    options<10>(A.snapshot(), &tol, nullptr, m, id);
+    const int n = excluded ? 0 : A.getDof();
+    const int dim = n * mu;
+    const int s = m[1];
+    K* const P = Workspace<K>::get()->allocate(s * n + 2 * s * dim + 4 * dim + mu * (s * s + 3 * s + 5), A.prefix());
+    K* const G = P + s * n;
+    K* const U = G + s * dim;
+    K* const r = U + s * dim;
+    K* const v = r + dim;
+    K* const t = v + dim;
+    K* const Ax = t + dim;
+    K* const M = Ax + dim;
+    K* const f = M + mu * s * s;
+    K* const c = f + mu * s;
+    K* const red = c + mu * s;
+    K* const om = red + mu * (s + 2);
+    underlying_type<K>* const norm = reinterpret_cast<underlying_type<K>*>(om + mu);
+    underlying_type<K>* const res = norm + mu;
+    const underlying_type<K>* const d = A.getScaling();
+    const auto inner = [&](const K* const u, const K* const w) -> K {
+        if(!d)
+            return Blas<K>::dot(&n, u, &i__1, w, &i__1);
+        K val = K();
+        for(int i = 0; i < n; ++i)
+            val += d[i] * Wrapper<K>::conj(u[i]) * w[i];
+        return val;
+    };
+    const auto mat = [&](const K* const in, K* const out) {
+        if(id[1] == HPDDM_VARIANT_LEFT) {
+            if(!excluded)
+                A.GMV(in, Ax, mu);
+            A.template apply<excluded>(Ax, out, mu);
+        }
+        else if(!excluded)
+            A.GMV(in, out, mu);
+    };
+    short* const hasConverged = new short[mu];
+    std::fill_n(hasConverged, mu, -m[0]);
+    bool allocate = initializeNorm<excluded>(A, id[1], b, x, v, n, Ax, norm, mu, 1);
+    if(!excluded)
+        A.GMV(x, id[1] == HPDDM_VARIANT_LEFT ? Ax : r, mu);
+    Blas<K>::axpby(dim, 1.0, b, 1, -1.0, id[1] == HPDDM_VARIANT_LEFT ? Ax : r, 1);
+    if(id[1] == HPDDM_VARIANT_LEFT)
+        A.template apply<excluded>(Ax, r, mu);
+    if(!excluded && n) {
+        std::default_random_engine generator;
+        std::uniform_real_distribution<underlying_type<K>> uniform(-1.0, 1.0);
+        std::generate_n(P, s * n, [&]() { return K(uniform(generator)); });
+    }
+    QR<excluded>(HPDDM_QR_CHOLQR, n, s, P, M, s, d, G, comm);
+    std::fill_n(G, 2 * s * dim, K());
+    std::fill_n(M, mu * s * s, K());
+    for(unsigned short nu = 0; nu < mu; ++nu) {
+        for(int i = 0; i < s; ++i)
+            M[nu * s * s + i * (s + 1)] = K(1.0);
+        om[nu] = K(1.0);
+    }
+    unsigned short j = 0;
+    while(true) {
+        for(unsigned short nu = 0; nu < mu; ++nu) {
+            for(int i = 0; i < s; ++i)
+                red[nu * (s + 1) + i] = inner(P + i * n, r + nu * n);
+            red[nu * (s + 1) + s] = inner(r + nu * n, r + nu * n);
+        }
+        if(j == 0) {
+            std::copy_n(norm, mu, red + mu * (s + 1));
+            allreduce(MPI_IN_PLACE, red, mu * (s + 2), Wrapper<K>::mpi_type(), MPI_SUM, comm);
+            for(unsigned short nu = 0; nu < mu; ++nu) {
+                norm[nu] = std::sqrt(std::real(red[mu * (s + 1) + nu]));
+                if(norm[nu] < HPDDM_EPS)
+                    norm[nu] = 1.0;
+            }
+        }
+        else
+            allreduce(MPI_IN_PLACE, red, mu * (s + 1), Wrapper<K>::mpi_type(), MPI_SUM, comm);
+        for(unsigned short nu = 0; nu < mu; ++nu)
+            res[nu] = std::sqrt(std::real(red[nu * (s + 1) + s]));
+        checkConvergence<10>(id[0], j, j, tol, mu, norm, res, hasConverged, m[0]);
+        if(j >= m[0] || std::find(hasConverged, hasConverged + mu, -m[0]) == hasConverged + mu)
+            break;
+        for(unsigned short nu = 0; nu < mu; ++nu)
+            std::copy_n(red + nu * (s + 1), s, f + nu * s);
+        for(int k = 0; k < s && j < m[0]; ++k, ++j) {
+            const int len = s - k;
+            K* const z = (id[1] == HPDDM_VARIANT_LEFT ? v : t);
+            if(!excluded && n)
+                for(unsigned short nu = 0; nu < mu; ++nu) {
+                    if(hasConverged[nu] == -m[0]) {
+                        std::copy_n(f + nu * s + k, len, c + nu * s);
+                        Blas<K>::trsv("L", "N", "N", &len, M + nu * s * s + k * (s + 1), &s, c + nu * s, &i__1);
+                        std::copy_n(r + nu * n, n, v + nu * n);
+                        Blas<K>::gemv("N", &n, &len, &(Wrapper<K>::d__2), G + k * dim + nu * n, &dim, c + nu * s, &i__1, &(Wrapper<K>::d__1), v + nu * n, &i__1);
+                    }
+                    else
+                        std::fill_n(v + nu * n, n, K());
+                }
+            if(id[1] != HPDDM_VARIANT_LEFT)
+                A.template apply<excluded>(v, t, mu);
+            if(!excluded && n)
+                for(unsigned short nu = 0; nu < mu; ++nu) {
+                    if(hasConverged[nu] == -m[0]) {
+                        Blas<K>::gemv("N", &n, &len, &(Wrapper<K>::d__1), U + k * dim + nu * n, &dim, c + nu * s, &i__1, om + nu, z + nu * n, &i__1);
+                        std::copy_n(z + nu * n, n, U + k * dim + nu * n);
+                    }
+                    else
+                        std::fill_n(U + k * dim + nu * n, n, K());
+                }
+            mat(U + k * dim, G + k * dim);
+            for(unsigned short nu = 0; nu < mu; ++nu)
+                for(int i = 0; i < s; ++i)
+                    red[nu * s + i] = inner(P + i * n, G + k * dim + nu * n);
+            allreduce(MPI_IN_PLACE, red, mu * s, Wrapper<K>::mpi_type(), MPI_SUM, comm);
+            if(!excluded && n)
+                for(unsigned short nu = 0; nu < mu; ++nu) {
+                    if(hasConverged[nu] == -m[0]) {
+                        K* const alpha = red + nu * s;
+                        if(k) {
+                            Blas<K>::trsv("L", "N", "N", &k, M + nu * s * s, &s, alpha, &i__1);
+                            Blas<K>::gemv("N", &n, &k, &(Wrapper<K>::d__2), G + nu * n, &dim, alpha, &i__1, &(Wrapper<K>::d__1), G + k * dim + nu * n, &i__1);
+                            Blas<K>::gemv("N", &n, &k, &(Wrapper<K>::d__2), U + nu * n, &dim, alpha, &i__1, &(Wrapper<K>::d__1), U + k * dim + nu * n, &i__1);
+                            Blas<K>::gemv("N", &len, &k, &(Wrapper<K>::d__2), M + nu * s * s + k, &s, alpha, &i__1, &(Wrapper<K>::d__1), alpha + k, &i__1);
+                        }
+                        std::copy_n(alpha + k, len, M + nu * s * s + k * (s + 1));
+                        K beta = f[nu * s + k] / M[nu * s * s + k * (s + 1)];
+                        Blas<K>::axpy(&n, &beta, U + k * dim + nu * n, &i__1, x + nu * n, &i__1);
+                        beta = -beta;
+                        Blas<K>::axpy(&n, &beta, G + k * dim + nu * n, &i__1, r + nu * n, &i__1);
+                        if(len > 1) {
+                            const int diff = len - 1;
+                            Blas<K>::axpy(&diff, &beta, M + nu * s * s + k * (s + 1) + 1, &i__1, f + nu * s + k + 1, &i__1);
+                        }
+                    }
+                }
+        }
+        if(j < m[0]) {
+            if(id[1] == HPDDM_VARIANT_LEFT)
+                mat(r, t);
+            else {
+                A.template apply<excluded>(r, v, mu, t);
+                mat(v, t);
+            }
+            for(unsigned short nu = 0; nu < mu; ++nu) {
+                red[3 * nu] = inner(t + nu * n, t + nu * n);
+                red[3 * nu + 1] = inner(t + nu * n, r + nu * n);
+                red[3 * nu + 2] = inner(r + nu * n, r + nu * n);
+            }
+            allreduce(MPI_IN_PLACE, red, 3 * mu, Wrapper<K>::mpi_type(), MPI_SUM, comm);
+            for(unsigned short nu = 0; nu < mu; ++nu) {
+                if(hasConverged[nu] == -m[0] && std::real(red[3 * nu]) > 0.0) {
+                    om[nu] = red[3 * nu + 1] / red[3 * nu];
+                    const underlying_type<K> rho = std::abs(red[3 * nu + 1]) / std::sqrt(std::real(red[3 * nu]) * std::real(red[3 * nu + 2]));
+                    if(rho > HPDDM_EPS && rho < 0.7)
+                        om[nu] *= 0.7 / rho;
+                    Blas<K>::axpy(&n, om + nu, (id[1] == HPDDM_VARIANT_LEFT ? r : v) + nu * n, &i__1, x + nu * n, &i__1);
+                    const K alpha = -om[nu];
+                    Blas<K>::axpy(&n, &alpha, t + nu * n, &i__1, r + nu * n, &i__1);
+                }
+            }
+            ++j;
+        }
+    }
+    if(std::find(hasConverged, hasConverged + mu, -m[0]) != hasConverged + mu)
+        j = m[0] + 1;
+    convergence<10>(id[0], j, m[0]);
+    delete [] hasConverged;
+    A.end(allocate);
+    Workspace<K>::get()->deallocate(P, A.prefix());
+    return std::min(j, m[0]);
+}
+template<bool excluded, class Operator, class K>
+inline int IterativeMethod::BiCGStab(const Operator& A, const K* const b, K* const x, const int& mu, const MPI_Comm& comm) {
+    underlying_type<K> tol;
+    unsigned short m[2];
+    char id[2];
+    options<11>(A.snapshot(), &tol, nullptr, m, id);
+    const int n = excluded ? 0 : A.getDof();
+    const int dim = n * mu;
+    const int l = m[1];
+    const int ldz = l + 1;
+    K* const r = Workspace<K>::get()->allocate((2 * l + 4 + (id[1] != HPDDM_VARIANT_LEFT)) * dim + mu * (ldz * ldz + l + 5), A.prefix());
+    K* const u = r + ldz * dim;
+    K* const rt = u + ldz * dim;
+    K* const Ax = rt + dim;
+    K* const y = (id[1] == HPDDM_VARIANT_LEFT ? x : Ax + dim);
+    K* const Z = Ax + (id[1] == HPDDM_VARIANT_LEFT ? 1 : 2) * dim;
+    K* const gamma = Z + mu * ldz * ldz;
+    K* const rho = gamma + mu * l;
+    K* const alpha = rho + mu;
+    K* const omega = alpha + mu;
+    underlying_type<K>* const norm = reinterpret_cast<underlying_type<K>*>(omega + mu);
+    underlying_type<K>* const res = norm + mu;
+    int* const piv = new int[l];
+    const underlying_type<K>* const d = A.getScaling();
+    const auto inner = [&](const K* const v, const K* const w) -> K {
+        if(!d)
+            return Blas<K>::dot(&n, v, &i__1, w, &i__1);
+        K val = K();
+        for(int i = 0; i < n; ++i)
+            val += d[i] * Wrapper<K>::conj(v[i]) * w[i];
+        return val;
+    };
+    const auto op = [&](const K* const in, K* const out) {
+        if(id[1] == HPDDM_VARIANT_LEFT) {
+            if(!excluded)
+                A.GMV(in, Ax, mu);
+            A.template apply<excluded>(Ax, out, mu);
+        }
+        else {
+            A.template apply<excluded>(in, Ax, mu, out);
+            if(!excluded)
+                A.GMV(Ax, out, mu);
+        }
+    };
+    short* const hasConverged = new short[mu];
+    std::fill_n(hasConverged, mu, -m[0]);
+    bool allocate = initializeNorm<excluded>(A, id[1], b, x, rt, n, Ax, norm, mu, 1);
+    if(!excluded)
+        A.GMV(x, id[1] == HPDDM_VARIANT_LEFT ? Ax : r, mu);
+    Blas<K>::axpby(dim, 1.0, b, 1, -1.0, id[1] == HPDDM_VARIANT_LEFT ? Ax : r, 1);
+    if(id[1] == HPDDM_VARIANT_LEFT)
+        A.template apply<excluded>(Ax, r, mu);
+    else
+        std::fill_n(y, dim, K());
+    std::copy_n(r, dim, rt);
+    std::fill_n(u, dim, K());
+    std::fill_n(rho, mu, K(1.0));
+    std::fill_n(alpha, mu, K());
+    std::fill_n(omega, mu, K(1.0));
+    unsigned short j = 0;
+    while(true) {
+        for(unsigned short nu = 0; nu < mu; ++nu) {
+            Z[2 * nu] = inner(rt + nu * n, r + nu * n);
+            Z[2 * nu + 1] = inner(r + nu * n, r + nu * n);
+        }
+        if(j == 0) {
+            std::copy_n(norm, mu, Z + 2 * mu);
+            allreduce(MPI_IN_PLACE, Z, 3 * mu, Wrapper<K>::mpi_type(), MPI_SUM, comm);
+            for(unsigned short nu = 0; nu < mu; ++nu) {
+                norm[nu] = std::sqrt(std::real(Z[2 * mu + nu]));
+                if(norm[nu] < HPDDM_EPS)
+                    norm[nu] = 1.0;
+            }
+        }
+        else
+            allreduce(MPI_IN_PLACE, Z, 2 * mu, Wrapper<K>::mpi_type(), MPI_SUM, comm);
+        for(unsigned short nu = 0; nu < mu; ++nu) {
+            res[nu] = std::sqrt(std::real(Z[2 * nu + 1]));
+            gamma[nu] = Z[2 * nu];
+            if(hasConverged[nu] == -m[0])
+                rho[nu] *= -omega[nu];
+        }
+        checkConvergence<11>(id[0], j, j, tol, mu, norm, res, hasConverged, m[0]);
+        if(j >= m[0] || std::find(hasConverged, hasConverged + mu, -m[0]) == hasConverged + mu)
+            break;
+        int i = 0;
+        while(i < l && j < m[0]) {
+            if(i) {
+                for(unsigned short nu = 0; nu < mu; ++nu)
+                    gamma[nu] = inner(rt + nu * n, r + i * dim + nu * n);
+                allreduce(MPI_IN_PLACE, gamma, mu, Wrapper<K>::mpi_type(), MPI_SUM, comm);
+            }
+            for(unsigned short nu = 0; nu < mu; ++nu) {
+                if(hasConverged[nu] == -m[0]) {
+                    const K beta = alpha[nu] * gamma[nu] / rho[nu];
+                    rho[nu] = gamma[nu];
+                    for(int k = 0; k <= i; ++k)
+                        Blas<K>::axpby(n, 1.0, r + k * dim + nu * n, 1, -beta, u + k * dim + nu * n, 1);
+                }
+            }
+            op(u + i * dim, u + (i + 1) * dim);
+            for(unsigned short nu = 0; nu < mu; ++nu)
+                gamma[nu] = inner(rt + nu * n, u + (i + 1) * dim + nu * n);
+            allreduce(MPI_IN_PLACE, gamma, mu, Wrapper<K>::mpi_type(), MPI_SUM, comm);
+            for(unsigned short nu = 0; nu < mu; ++nu) {
+                if(hasConverged[nu] == -m[0]) {
+                    alpha[nu] = rho[nu] / gamma[nu];
+                    const K beta = -alpha[nu];
+                    for(int k = 0; k <= i; ++k)
+                        Blas<K>::axpy(&n, &beta, u + (k + 1) * dim + nu * n, &i__1, r + k * dim + nu * n, &i__1);
+                    Blas<K>::axpy(&n, alpha + nu, u + nu * n, &i__1, y + nu * n, &i__1);
+                }
+            }
+            op(r + i * dim, r + (i + 1) * dim);
+            ++i;
+            ++j;
+        }
+        if(i == l) {
+            std::fill_n(Z, mu * ldz * ldz, K());
+            for(unsigned short nu = 0; nu < mu; ++nu)
+                for(int k = 0; k < ldz; ++k)
+                    for(int h = 0; h <= k; ++h)
+                        Z[nu * ldz * ldz + h + k * ldz] = inner(r + h * dim + nu * n, r + k * dim + nu * n);
+            allreduce(MPI_IN_PLACE, Z, mu * ldz * ldz, Wrapper<K>::mpi_type(), MPI_SUM, comm);
+            if(!excluded && n)
+                for(unsigned short nu = 0; nu < mu; ++nu) {
+                    if(hasConverged[nu] == -m[0]) {
+                        K* const z = Z + nu * ldz * ldz;
+                        for(int k = 1; k < ldz; ++k)
+                            gamma[nu * l + k - 1] = Wrapper<K>::conj(z[k * ldz]);
+                        for(int k = 1; k < ldz; ++k)
+                            for(int h = 0; h < k; ++h)
+                                z[k + h * ldz] = Wrapper<K>::conj(z[h + k * ldz]);
+                        int info;
+                        Lapack<K>::getrf(&l, &l, z + ldz + 1, &ldz, piv, &info);
+                        Lapack<K>::getrs("N", &l, &i__1, z + ldz + 1, &ldz, piv, gamma + nu * l, &l, &info);
+                        omega[nu] = gamma[nu * l + l - 1];
+                        Blas<K>::gemv("N", &n, &l, &(Wrapper<K>::d__2), u + dim + nu * n, &dim, gamma + nu * l, &i__1, &(Wrapper<K>::d__1), u + nu * n, &i__1);
+                        Blas<K>::gemv("N", &n, &l, &(Wrapper<K>::d__1), r + nu * n, &dim, gamma + nu * l, &i__1, &(Wrapper<K>::d__1), y + nu * n, &i__1);
+                        Blas<K>::gemv("N", &n, &l, &(Wrapper<K>::d__2), r + dim + nu * n, &dim, gamma + nu * l, &i__1, &(Wrapper<K>::d__1), r + nu * n, &i__1);
+                    }
+                }
+        }
+    }
+    if(id[1] != HPDDM_VARIANT_LEFT) {
+        A.template apply<excluded>(y, Ax, mu);
+        Blas<K>::axpy(&dim, &(Wrapper<K>::d__1), Ax, &i__1, x, &i__1);
+    }
+    if(std::find(hasConverged, hasConverged + mu, -m[0]) != hasConverged + mu)
+        j = m[0] + 1;
+    convergence<11>(id[0], j, m[0]);
+    delete [] hasConverged;
+    delete [] piv;
+    A.end(allocate);
+    Workspace<K>::get()->deallocate(r, A.prefix());
+    return std::min(j, m[0]);
+}
+} // HPDDM
+#endif // _HPDDM_IDR_
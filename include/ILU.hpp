@@ -0,0 +1,317 @@
+ /*
+   This file is part of HPDDM.
+
+   Author(s): Pierre Jolivet <pierre.jolivet@enseeiht.fr>
+        Date: 2026-10-18
+
+   Copyright (C) 2026-     Centre National de la Recherche Scientifique
+
+   HPDDM is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published
+   by the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   HPDDM is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with HPDDM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _HPDDM_ILU_
+#define _HPDDM_ILU_
+
+#ifdef ILUSUB
+#undef HPDDM_CHECK_COARSEOPERATOR
+#define HPDDM_CHECK_SUBDOMAIN
+#include "preprocessor_check.hpp"
+#define SUBDOMAIN HPDDM::IluSub
+namespace HPDDM {
+/* Class: IluSub
+ *
+ *  A class for computing incomplete LU factorizations with a level of fill k, ILU(k), of the subdomain matrices, see the option ilu_level.
+ *  Symmetric matrices are expanded to full storage, so that the factorization is then equivalent to an incomplete Cholesky factorization, ICC(k), with a scaled diagonal.
+ *  Triangular solves are parallelized with OpenMP using level sets: rows in the same level only depend on rows in previous levels.
+ *
+ * Template Parameter:
+ *    K              - Scalar type. */
+template<class K>
+class IluSub {
+    private:
+        /* Variable: li
+         *  Row pointers of the strictly lower triangular factor, with an implicit unit diagonal. */
+        int*                 _li;
+        /* Variable: lj
+         *  Column indices of the strictly lower triangular factor. */
+        int*                 _lj;
+        /* Variable: la
+         *  Values of the strictly lower triangular factor. */
+        K*                   _la;
+        /* Variable: ui
+         *  Row pointers of the strictly upper triangular factor. */
+        int*                 _ui;
+        /* Variable: uj
+         *  Column indices of the strictly upper triangular factor. */
+        int*                 _uj;
+        /* Variable: ua
+         *  Values of the strictly upper triangular factor. */
+        K*                   _ua;
+        /* Variable: d
+         *  Inverse of the diagonal of the upper triangular factor. */
+        K*                    _d;
+        /* Variable: lrow
+         *  Rows of the lower triangular factor, sorted by level sets. */
+        int*               _lrow;
+        /* Variable: lset
+         *  Offsets of the level sets of the lower triangular factor in <IluSub::lrow>. */
+        int*               _lset;
+        /* Variable: urow
+         *  Rows of the upper triangular factor, sorted by level sets. */
+        int*               _urow;
+        /* Variable: uset
+         *  Offsets of the level sets of the upper triangular factor in <IluSub::urow>. */
+        int*               _uset;
+        /* Variable: lsets
+         *  Number of level sets of the lower triangular factor. */
+        int               _lsets;
+        /* Variable: usets
+         *  Number of level sets of the upper triangular factor. */
+        int               _usets;
+        /* Variable: n
+         *  Number of rows of the subdomain matrix. */
+        int                   _n;
+        /* Variable: fill
+         *  Level of fill of the symbolic factorization. */
+        int                _fill;
+        /* Function: levels
+         *
+         *  Computes the level sets of a triangular factor.
+         *
+         * Template Parameter:
+         *    upper          - True if the factor is upper triangular, i.e., if rows are eliminated in decreasing order.
+         *
+         * Parameters:
+         *    ia             - Row pointers of the factor.
+         *    ja             - Column indices of the factor.
+         *    row            - Rows sorted by level sets.
+         *    set            - Offsets of the level sets in row.
+         *
+         * Returns the number of level sets. */
+        template<bool upper>
+        int levels(const int* const ia, const int* const ja, int*& row, int*& set) const {
+            std::vector<int> level(_n);
+            int max = 0;
+            for(int k = 0; k < _n; ++k) {
+                const int i = upper ? _n - 1 - k : k;
+                int l = 0;
+                for(int j = ia[i]; j < ia[i + 1]; ++j)
+                    l = std::max(l, level[ja[j]] + 1);
+                level[i] = l;
+                max = std::max(max, l);
+            }
+            set = new int[max + 2]();
+            for(int i = 0; i < _n; ++i)
+                ++set[level[i] + 1];
+            std::partial_sum(set, set + max + 2, set);
+            row = new int[_n];
+            std::vector<int> offset(set, set + max + 1);
+            for(int i = 0; i < _n; ++i)
+                row[offset[level[i]]++] = i;
+            return max + 1;
+        }
+        void clear() {
+            for(int** const pt : { &_li, &_lj, &_ui, &_uj, &_lrow, &_lset, &_urow, &_uset }) {
+                delete [] *pt;
+                *pt = nullptr;
+            }
+            for(K** const pt : { &_la, &_ua, &_d }) {
+                delete [] *pt;
+                *pt = nullptr;
+            }
+        }
+    public:
+        IluSub() : _li(), _lj(), _la(), _ui(), _uj(), _ua(), _d(), _lrow(), _lset(), _urow(), _uset(), _lsets(), _usets(), _n(), _fill() { }
+        IluSub(const IluSub&) = delete;
+        ~IluSub() { clear(); }
+        static constexpr char _numbering = 'C';
+        /* Function: numfact
+         *
+         *  Computes the symbolic and numerical incomplete factorizations of a subdomain matrix, and the level sets of both triangular factors.
+         *  When called again with the same level of fill, the sparsity pattern of the matrix is assumed unchanged, and only the numerical factorization is computed.
+         *
+         * Template Parameter:
+         *    N              - 0- or 1-based indexing of the input matrix.
+         *
+         * Parameter:
+         *    A              - Matrix to factorize. */
+        template<char N = HPDDM_NUMBERING, bool = false>
+        void numfact(MatrixCSR<K>* const& A, bool = false, K* const& = nullptr) {
+            static_assert(N == 'C' || N == 'F', "Unknown numbering");
+            const int fill = std::max(0, Option::get()->val<int>("ilu_level", 0));
+            const bool symbolic = (!_li || A->_n != _n || fill != _fill);
+            _n = A->_n;
+            std::vector<std::vector<std::pair<int, K>>> rows(_n);
+            for(int i = 0; i < _n; ++i)
+                for(int j = A->_ia[i] - (N == 'F'); j < A->_ia[i + 1] - (N == 'F'); ++j) {
+                    const int col = A->_ja[j] - (N == 'F');
+                    rows[i].emplace_back(col, A->_a[j]);
+                    if(A->_sym && col != i)
+                        rows[col].emplace_back(i, A->_a[j]);
+                }
+            if(symbolic) {
+                clear();
+                _fill = fill;
+                _li = new int[_n + 1];
+                _ui = new int[_n + 1];
+                _li[0] = _ui[0] = 0;
+                std::vector<int> lj, uj, ulevel;
+                std::vector<int> level(_n, std::numeric_limits<int>::max());
+                std::vector<int> next(_n);
+                for(int i = 0; i < _n; ++i) {
+                    std::sort(rows[i].begin(), rows[i].end(), [](const std::pair<int, K>& lhs, const std::pair<int, K>& rhs) { return lhs.first < rhs.first; });
+                    int head = _n, tail = -1;
+                    auto append = [&](const int j) {
+                        if(level[j] != 0) {
+                            level[j] = 0;
+                            if(tail == -1)
+                                head = j;
+                            else
+                                next[tail] = j;
+                            tail = j;
+                        }
+                    };
+                    for(const std::pair<int, K>& v : rows[i]) {
+                        if(v.first >= i)
+                            append(i);
+                        append(v.first);
+                    }
+                    append(i);
+                    next[tail] = _n;
+                    for(int k = head; k < i; k = next[k])
+                        for(int p = _ui[k]; p < _ui[k + 1]; ++p) {
+                            const int j = uj[p];
+                            const int l = level[k] + ulevel[p] + 1;
+                            if(l <= fill) {
+                                if(level[j] == std::numeric_limits<int>::max()) {
+                                    int q = k;
+                                    while(next[q] < j)
+                                        q = next[q];
+                                    next[j] = next[q];
+                                    next[q] = j;
+                                    level[j] = l;
+                                }
+                                else
+                                    level[j] = std::min(level[j], l);
+                            }
+                        }
+                    for(int k = head; k != _n; k = next[k]) {
+                        if(k < i)
+                            lj.emplace_back(k);
+                        else if(k > i) {
+                            uj.emplace_back(k);
+                            ulevel.emplace_back(level[k]);
+                        }
+                        level[k] = std::numeric_limits<int>::max();
+                    }
+                    _li[i + 1] = lj.size();
+                    _ui[i + 1] = uj.size();
+                }
+                _lj = new int[lj.size()];
+                std::copy(lj.cbegin(), lj.cend(), _lj);
+                _uj = new int[uj.size()];
+                std::copy(uj.cbegin(), uj.cend(), _uj);
+                _la = new K[lj.size()];
+                _ua = new K[uj.size()];
+                _d = new K[_n];
+                _lsets = levels<false>(_li, _lj, _lrow, _lset);
+                _usets = levels<true>(_ui, _uj, _urow, _uset);
+            }
+            std::vector<K> w(_n);
+            std::vector<int> marker(_n, -1);
+            for(int i = 0; i < _n; ++i) {
+                for(int p = _li[i]; p < _li[i + 1]; ++p) {
+                    w[_lj[p]] = K();
+                    marker[_lj[p]] = i;
+                }
+                for(int p = _ui[i]; p < _ui[i + 1]; ++p) {
+                    w[_uj[p]] = K();
+                    marker[_uj[p]] = i;
+                }
+                w[i] = K();
+                marker[i] = i;
+                for(const std::pair<int, K>& v : rows[i])
+                    w[v.first] += v.second;
+                std::vector<std::pair<int, K>>().swap(rows[i]);
+                for(int p = _li[i]; p < _li[i + 1]; ++p) {
+                    const int k = _lj[p];
+                    const K factor = w[k] * _d[k];
+                    _la[p] = factor;
+                    for(int q = _ui[k]; q < _ui[k + 1]; ++q)
+                        if(marker[_uj[q]] == i)
+                            w[_uj[q]] -= factor * _ua[q];
+                }
+                for(int p = _ui[i]; p < _ui[i + 1]; ++p)
+                    _ua[p] = w[_uj[p]];
+                if(std::abs(w[i]) < HPDDM_EPS)
+                    w[i] = HPDDM_EPS;
+                _d[i] = K(1.0) / w[i];
+            }
+        }
+        template<char N = HPDDM_NUMBERING>
+        int inertia(MatrixCSR<K>* const&) { return 0; }
+        unsigned short deficiency() const { return 0; }
+        /* Function: solve
+         *
+         *  Solves the system in-place with forward and backward substitutions, one level set at a time.
+         *
+         * Parameters:
+         *    x              - Input right-hand sides, solution vectors are stored in-place.
+         *    n              - Number of right-hand sides. */
+        void solve(K* const x, const unsigned short& n = 1) const {
+#ifdef _OPENMP
+            /* do not spawn threads when level sets are too narrow to amortize the synchronizations */
+#pragma omp parallel if(_n * n >= 64 * std::max(_lsets, _usets))
+#endif
+            {
+                for(int l = 0; l < _lsets; ++l) {
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+                    for(int r = _lset[l]; r < _lset[l + 1]; ++r) {
+                        const int i = _lrow[r];
+                        for(unsigned short nu = 0; nu < n; ++nu) {
+                            K* const y = x + nu * _n;
+                            K s = y[i];
+                            for(int p = _li[i]; p < _li[i + 1]; ++p)
+                                s -= _la[p] * y[_lj[p]];
+                            y[i] = s;
+                        }
+                    }
+                }
+                for(int l = 0; l < _usets; ++l) {
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+                    for(int r = _uset[l]; r < _uset[l + 1]; ++r) {
+                        const int i = _urow[r];
+                        for(unsigned short nu = 0; nu < n; ++nu) {
+                            K* const y = x + nu * _n;
+                            K s = y[i];
+                            for(int p = _ui[i]; p < _ui[i + 1]; ++p)
+                                s -= _ua[p] * y[_uj[p]];
+                            y[i] = s * _d[i];
+                        }
+                    }
+                }
+            }
+        }
+        void solve(const K* const b, K* const x, const unsigned short& n = 1) const {
+            std::copy_n(b, n * _n, x);
+            solve(x, n);
+        }
+};
+} // HPDDM
+#endif // ILUSUB
+#endif // _HPDDM_ILU_
@@ -347,8 +347,15 @@ class LapackTRSub {
         static constexpr char _numbering = 'F';
         template<char N = HPDDM_NUMBERING, bool transpose = false>
         void numfact(MatrixCSR<K>* const& A, bool detection = false, K* const& schur = nullptr) {
-            _n = A->_n;
-            _a = new K[_n * _n]();
+            if(!_a || _n != A->_n) {
+                delete [] _a;
+                delete [] _ipiv;
+                _ipiv = nullptr;
+                _n = A->_n;
+                _a = new K[_n * _n]();
+            }
+            else
+                std::fill_n(_a, _n * _n, K());
             if(A->_nnz == _n * _n) {
                 if(N == 'C')
                     Wrapper<K>::template omatcopy<'T'>(_n, _n, A->_a, _n, _a, _n);
@@ -367,7 +374,8 @@ class LapackTRSub {
             }
             int info;
             if(!A->_sym) {
-                _ipiv = new int[_n];
+                if(!_ipiv)
+                    _ipiv = new int[_n];
                 Lapack<K>::getrf(&_n, &_n, _a, &_n, _ipiv, &info);
             }
             else {
@@ -375,13 +383,15 @@ class LapackTRSub {
                 if(_type == 1) {
                     K* work;
                     int lwork = -1;
-                    _ipiv = new int[_n];
+                    if(!_ipiv)
+                        _ipiv = new int[_n];
                     K wkopt;
                     Lapack<K>::sytrf("L", &_n, _a, &_n, _ipiv, &wkopt, &lwork, &info);
                     if(info == 0) {
                         lwork = static_cast<int>(std::real(wkopt));
                         work = new K[lwork];
                         Lapack<K>::sytrf("L", &_n, _a, &_n, _ipiv, work, &lwork, &info);
+                        delete [] work;
                     }
                 }
                 else
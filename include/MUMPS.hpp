@@ -85,7 +85,7 @@ class Mumps : public DMatrix {
         }
         /* Function: numfact
          *
-         *  Initializes <Mumps::id> and factorizes the supplied matrix.
+         *  Initializes <Mumps::id> and factorizes the supplied matrix. If <Mumps::id> is already initialized, the supplied matrix must have the same sparsity pattern as the previous one, and only a numerical factorization is performed.
          *
          * Template Parameter:
          *    S              - 'S'ymmetric or 'G'eneral factorization.
@@ -97,11 +97,26 @@ class Mumps : public DMatrix {
          *    C              - Array of data. */
         template<char S>
         void numfact(unsigned int nz, int* I, int* J, K* C) {
+            const Option& opt = *Option::get();
+            if(_id) {
+                _id->nz_loc = nz;
+                _id->irn_loc = I;
+                _id->jcn_loc = J;
+                _id->a_loc = reinterpret_cast<typename MUMPS_STRUC_C<K>::mumps_type*>(C);
+                _id->job = 2;
+                if(opt.val<char>("verbosity", 0) >= 3)
+                    _id->icntl[2] = 6;
+                MUMPS_STRUC_C<K>::mumps_c(_id);
+                if(DMatrix::_rank == 0 && _id->infog[0] != 0)
+                    std::cerr << "BUG MUMPS, INFOG(1) = " << _id->infog[0] << std::endl;
+                _id->icntl[2] = 0;
+                delete [] I;
+                return;
+            }
             _id = new typename MUMPS_STRUC_C<K>::trait();
             _id->job = -1;
             _id->par = 1;
             _id->comm_fortran = MPI_Comm_c2f(DMatrix::_communicator);
-            const Option& opt = *Option::get();
             if(S == 'S')
                 _id->sym = opt.val<char>("master_spd", 0) ? 1 : 2;
             else
@@ -117,6 +117,9 @@ class SuiteSparse : public DMatrix {
         /* Variable: E
          *  Dense workspace matrix of CHOLMOD. */
         cholmod_dense*          _E;
+        /* Variable: symbolic
+         *  Opaque object for the symbolic analysis of UMFPACK. */
+        void*            _symbolic;
         /* Variable: numeric
          *  Opaque object for the numerical factorization of UMFPACK. */
         void*             _numeric;
@@ -137,7 +140,7 @@ class SuiteSparse : public DMatrix {
          *  0-based indexing. */
         static constexpr char _numbering = 'C';
     public:
-        SuiteSparse() : _L(), _c(), _b(), _x(), _Y(), _E(), _numeric(), _control(), _pattern(), _W(), _tmp() { }
+        SuiteSparse() : _L(), _c(), _b(), _x(), _Y(), _E(), _symbolic(), _numeric(), _control(), _pattern(), _W(), _tmp() { }
         ~SuiteSparse() {
             delete [] _tmp;
             _W = nullptr;
@@ -153,15 +156,30 @@ class SuiteSparse : public DMatrix {
             else {
                 delete [] _pattern;
                 delete [] _control;
+                stsprs<K>::umfpack_free_symbolic(&_symbolic);
                 stsprs<K>::umfpack_free_numeric(&_numeric);
             }
         }
+        /* Function: numfact
+         *
+         *  Factorizes the supplied matrix. If a factorization has already been computed, the supplied matrix must have the same sparsity pattern as the previous one, and its symbolic analysis is reused.
+         *
+         * Template Parameter:
+         *    S              - 'S'ymmetric or 'G'eneral factorization.
+         *
+         * Parameters:
+         *    ncol           - Number of columns.
+         *    I              - Array of column pointers.
+         *    J              - Array of row indices.
+         *    C              - Array of data. */
         template<char S>
         void numfact(unsigned int ncol, int* I, int* J, K* C) {
             if(S == 'S') {
-                _c = new cholmod_common;
-                cholmod_start(_c);
-                _c->print = 3;
+                if(!_c) {
+                    _c = new cholmod_common;
+                    cholmod_start(_c);
+                    _c->print = 3;
+                }
                 cholmod_sparse* M = static_cast<cholmod_sparse*>(cholmod_malloc(1, sizeof(cholmod_sparse), _c));
                 M->nrow = ncol;
                 M->ncol = ncol;
@@ -175,41 +193,48 @@ class SuiteSparse : public DMatrix {
                 M->x = C;
                 M->dtype = std::is_same<double, underlying_type<K>>::value ? CHOLMOD_DOUBLE : CHOLMOD_SINGLE;
                 M->itype = CHOLMOD_INT;
-                _L = cholmod_analyze(M, _c);
-                if(Option::get()->val<char>("verbosity", 0) > 2)
-                    cholmod_print_common(NULL, _c);
+                if(!_L) {
+                    _L = cholmod_analyze(M, _c);
+                    if(Option::get()->val<char>("verbosity", 0) > 2)
+                        cholmod_print_common(NULL, _c);
+                }
                 cholmod_factorize(M, _L, _c);
-                _b = static_cast<cholmod_dense*>(cholmod_malloc(1, sizeof(cholmod_dense), _c));
-                _b->nrow = M->nrow;
-                _b->xtype = M->xtype;
-                _b->dtype = M->dtype;
-                _b->d = _b->nrow;
-                _tmp = new K[_b->nrow];
-                _x = static_cast<cholmod_dense*>(cholmod_malloc(1, sizeof(cholmod_dense), _c));
-                _x->nrow = M->nrow;
-                _x->x = NULL;
-                _x->xtype = M->xtype;
-                _x->dtype = M->dtype;
-                _x->d = _x->nrow;
+                if(!_b) {
+                    _b = static_cast<cholmod_dense*>(cholmod_malloc(1, sizeof(cholmod_dense), _c));
+                    _b->nrow = M->nrow;
+                    _b->xtype = M->xtype;
+                    _b->dtype = M->dtype;
+                    _b->d = _b->nrow;
+                    _tmp = new K[_b->nrow];
+                    _x = static_cast<cholmod_dense*>(cholmod_malloc(1, sizeof(cholmod_dense), _c));
+                    _x->nrow = M->nrow;
+                    _x->x = NULL;
+                    _x->xtype = M->xtype;
+                    _x->dtype = M->dtype;
+                    _x->d = _x->nrow;
+                }
                 cholmod_free(1, sizeof(cholmod_sparse), M, _c);
             }
             else {
-                _control = new double[UMFPACK_CONTROL];
-                stsprs<K>::umfpack_defaults(_control);
-                _control[UMFPACK_PRL] = 2;
-                _control[UMFPACK_IRSTEP] = 0;
                 double* info = new double[UMFPACK_INFO];
-                _pattern = new int[ncol];
-                _tmp = new K[6 * ncol];
-                _W = _tmp + ncol;
-                _numeric = NULL;
-
-                void* symbolic;
-                stsprs<K>::umfpack_symbolic(ncol, ncol, I, J, C, &symbolic, _control, info);
-                stsprs<K>::umfpack_numeric(I, J, C, symbolic, &_numeric, _control, info);
+                if(!_control) {
+                    _control = new double[UMFPACK_CONTROL];
+                    stsprs<K>::umfpack_defaults(_control);
+                    _control[UMFPACK_PRL] = 2;
+                    _control[UMFPACK_IRSTEP] = 0;
+                    _pattern = new int[ncol];
+                    _tmp = new K[6 * ncol];
+                    _W = _tmp + ncol;
+                    _numeric = NULL;
+                    stsprs<K>::umfpack_symbolic(ncol, ncol, I, J, C, &_symbolic, _control, info);
+                }
+                else {
+                    stsprs<K>::umfpack_free_numeric(&_numeric);
+                    _numeric = NULL;
+                }
+                stsprs<K>::umfpack_numeric(I, J, C, _symbolic, &_numeric, _control, info);
                 if(Option::get()->val<char>("verbosity", 0) > 2)
                     stsprs<K>::umfpack_report_info(_control, info);
-                stsprs<K>::umfpack_free_symbolic(&symbolic);
                 delete [] info;
             }
             delete [] I;
@@ -247,13 +272,14 @@ class SuiteSparseSub {
         mutable cholmod_dense*  _x;
         mutable cholmod_dense*  _Y;
         mutable cholmod_dense*  _E;
+        void*            _symbolic;
         void*             _numeric;
         double*           _control;
         int*              _pattern;
         K*                      _W;
         K*                    _tmp;
     public:
-        SuiteSparseSub() : _L(), _c(), _b(), _x(), _Y(), _E(), _numeric(), _control(), _pattern(), _W(), _tmp() { }
+        SuiteSparseSub() : _L(), _c(), _b(), _x(), _Y(), _E(), _symbolic(), _numeric(), _control(), _pattern(), _W(), _tmp() { }
         SuiteSparseSub(const SuiteSparseSub&) = delete;
         ~SuiteSparseSub() {
             delete [] _tmp;
@@ -272,6 +298,7 @@ class SuiteSparseSub {
                 delete [] _pattern;
                 delete [] _control;
                 _control = nullptr;
+                stsprs<K>::umfpack_free_symbolic(&_symbolic);
                 stsprs<K>::umfpack_free_numeric(&_numeric);
             }
         }
@@ -297,9 +324,8 @@ class SuiteSparseSub {
                 M->x = A->_a;
                 M->dtype = std::is_same<double, underlying_type<K>>::value ? CHOLMOD_DOUBLE : CHOLMOD_SINGLE;
                 M->itype = CHOLMOD_INT;
-                if(_L)
-                    cholmod_free_factor(&_L, _c);
-                _L = cholmod_analyze(M, _c);
+                if(!_L)
+                    _L = cholmod_analyze(M, _c);
                 cholmod_factorize(M, _L, _c);
                 if(!_b) {
                     _b = static_cast<cholmod_dense*>(cholmod_malloc(1, sizeof(cholmod_dense), _c));
@@ -328,7 +354,6 @@ class SuiteSparseSub {
                     _W = _tmp + A->_m;
                 }
                 double* info = new double[UMFPACK_INFO];
-                void* symbolic = NULL;
                 K* a;
                 int* ia;
                 int* ja;
@@ -345,11 +370,9 @@ class SuiteSparseSub {
                     nnz = 0;
                     for(unsigned int i = 0; i < A->_n; ++i) {
                         for(unsigned int j = A->_ia[i]; j < A->_ia[i + 1] - 1; ++j) {
-                            if(std::abs(A->_a[j]) > HPDDM_EPS) {
-                                v[i].emplace_back(A->_ja[j], A->_a[j]);
-                                v[A->_ja[j]].emplace_back(i, A->_a[j]);
-                                nnz += 2;
-                            }
+                            v[i].emplace_back(A->_ja[j], A->_a[j]);
+                            v[A->_ja[j]].emplace_back(i, A->_a[j]);
+                            nnz += 2;
                         }
                         v[i].emplace_back(i, A->_a[A->_ia[i + 1] - 1]);
                         ++nnz;
@@ -373,14 +396,14 @@ class SuiteSparseSub {
                         ia[i + 1] = nnz;
                     }
                 }
-                stsprs<K>::umfpack_symbolic(A->_m, A->_n, ia, ja, a, &symbolic, _control, info);
+                if(!_symbolic)
+                    stsprs<K>::umfpack_symbolic(A->_m, A->_n, ia, ja, a, &_symbolic, _control, info);
                 if(_numeric) {
                     stsprs<K>::umfpack_free_numeric(&_numeric);
                     _numeric = NULL;
                 }
-                stsprs<K>::umfpack_numeric(ia, ja, a, symbolic, &_numeric, _control, info);
+                stsprs<K>::umfpack_numeric(ia, ja, a, _symbolic, &_numeric, _control, info);
                 stsprs<K>::umfpack_report_info(_control, info);
-                stsprs<K>::umfpack_free_symbolic(&symbolic);
                 if(A->_sym) {
                     delete [] ja;
                     delete [] a;
@@ -0,0 +1,125 @@
+ /*
+   This file is part of HPDDM.
+
+   Author(s): Pierre Jolivet <pierre.jolivet@enseeiht.fr>
+        Date: 2026-10-18
+
+   Copyright (C) 2026-     Centre National de la Recherche Scientifique
+
+   HPDDM is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published
+   by the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   HPDDM is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with HPDDM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _HPDDM_BATCH_
+#define _HPDDM_BATCH_
+
+#include <future>
+#include <chrono>
+#include "iterative.hpp"
+
+namespace HPDDM {
+/* Class: Batch
+ *
+ *  A class that queues independent right-hand sides and solves them together with a single call to <Iterative method::solve>, so that block methods, matrix-matrix products, and exchanges are used instead of one solve per right-hand side.
+ *  All public member functions are collective, i.e., every process of the communicator must push the same number of right-hand sides in the same order.
+ *
+ * Template Parameters:
+ *    Operator       - Global operator.
+ *    K              - Scalar type.
+ *    excluded       - True if the master processes are excluded from the domain decomposition, false otherwise. */
+template<class Operator, class K, bool excluded = false>
+class Batch {
+    private:
+        /* Variable: A
+         *  Reference to the global operator. */
+        const Operator&                                         _A;
+        /* Variable: comm
+         *  Global MPI communicator. */
+        const MPI_Comm                                       _comm;
+        /* Variable: queue
+         *  Pending right-hand sides, solution vectors, and promises of the number of iterations. */
+        std::vector<std::tuple<const K*, K*, std::promise<int>>> _queue;
+        /* Variable: start
+         *  Time at which the first pending right-hand side was pushed. */
+        std::chrono::steady_clock::time_point               _start;
+        /* Variable: latency
+         *  Maximum time in seconds during which a right-hand side may stay in the queue, or 0 to only flush full batches. It is only checked by <Batch::push>, so a partially filled queue is solved by the next push after the threshold, or by <Batch::flush> and the destructor. */
+        const double                                       _latency;
+        /* Variable: size
+         *  Number of right-hand sides that triggers a flush. */
+        const unsigned short                                  _size;
+    public:
+        Batch(const Operator& A, const MPI_Comm& comm, const unsigned short size, const double latency = 0.0) : _A(A), _comm(comm), _latency(latency), _size(std::max(size, static_cast<unsigned short>(1))) {
+            _queue.reserve(_size);
+        }
+        Batch(const Batch&) = delete;
+        ~Batch() {
+            flush();
+        }
+        /* Function: pending
+         *  Returns the number of right-hand sides waiting to be solved. */
+        unsigned short pending() const { return _queue.size(); }
+        /* Function: push
+         *
+         *  Adds a right-hand side to the queue, and flushes it if it is full or if the oldest right-hand side has been waiting for longer than the latency threshold on any process. The vectors must not be freed before the returned future is ready.
+         *
+         * Parameters:
+         *    b              - Right-hand side.
+         *    x              - Initial guess on input, solution vector on output.
+         *
+         * Returns: a future holding the number of iterations of the solve in which the right-hand side is included. */
+        std::future<int> push(const K* const b, K* const x) {
+            if(_queue.empty())
+                _start = std::chrono::steady_clock::now();
+            _queue.emplace_back(b, x, std::promise<int>());
+            std::future<int> future = std::get<2>(_queue.back()).get_future();
+            if(_queue.size() >= _size)
+                flush();
+            else if(_latency > 0.0) {
+                int expired = std::chrono::duration<double>(std::chrono::steady_clock::now() - _start).count() > _latency;
+                MPI_Allreduce(MPI_IN_PLACE, &expired, 1, MPI_INT, MPI_MAX, _comm);
+                if(expired)
+                    flush();
+            }
+            return future;
+        }
+        /* Function: flush
+         *
+         *  Solves all pending right-hand sides with a single call to <Iterative method::solve> and fulfills their futures. */
+        void flush() {
+            const int mu = _queue.size();
+            if(mu == 0)
+                return;
+            int it;
+            if(mu == 1)
+                it = IterativeMethod::solve<excluded>(_A, std::get<0>(_queue.front()), std::get<1>(_queue.front()), 1, _comm);
+            else {
+                const int n = excluded ? 0 : _A.getDof();
+                K* const b = new K[2 * mu * n];
+                K* const x = b + mu * n;
+                for(unsigned short nu = 0; nu < mu; ++nu) {
+                    std::copy_n(std::get<0>(_queue[nu]), n, b + nu * n);
+                    std::copy_n(std::get<1>(_queue[nu]), n, x + nu * n);
+                }
+                it = IterativeMethod::solve<excluded>(_A, b, x, mu, _comm);
+                for(unsigned short nu = 0; nu < mu; ++nu)
+                    std::copy_n(x + nu * n, n, std::get<1>(_queue[nu]));
+                delete [] b;
+            }
+            for(std::tuple<const K*, K*, std::promise<int>>& t : _queue)
+                std::get<2>(t).set_value(it);
+            _queue.clear();
+        }
+};
+} // HPDDM
+#endif // _HPDDM_BATCH_
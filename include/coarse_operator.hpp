@@ -46,6 +46,9 @@ class InexactCoarseOperator;
 #if defined(DMKL_PARDISO) || defined(DSUITESPARSE) || defined(DLAPACK) || defined(DHYPRE) || defined(DELEMENTAL) || HPDDM_INEXACT_COARSE_OPERATOR
 # define HPDDM_CONTIGUOUS
 #endif
+#if (defined(DMUMPS) || defined(DSUITESPARSE) || defined(DLAPACK)) && !HPDDM_INEXACT_COARSE_OPERATOR
+# define HPDDM_UPDATE_CO
+#endif
 
 namespace HPDDM {
 template<template<class> class Solver, char S, class K>
@@ -81,6 +84,35 @@ class CoarseOperator : public coarse_operator_type<Solver, S, downscaled_type<K>
          *  Local size of right-hand sides and solution vectors. */
         unsigned int              _sizeRHS;
         bool                       _offset;
+        /* Variable: keep
+         *  True if <Coarse operator::construction> keeps the data needed by <Coarse operator::update>, false otherwise. */
+        bool                         _keep;
+        /* Variable: timer
+         *  Time spent in, and number of calls to, <Coarse operator::constructionMatrix> and <Coarse operator::callSolver>. */
+        Timer<2>                    _timer;
+        /* Variable: level
+         *  Prefix of the options of the coarse operator, e.g., level_2_ for the second level of a multilevel method, or an empty string, see <Coarse operator::setLevel>. */
+        std::string                 _level;
+#ifdef HPDDM_UPDATE_CO
+        /* Variable: values
+         *  Block rows of the coarse operator computed by the current process, or all block rows assembled by the current master process, see <Coarse operator::update>. */
+        std::vector<K>                                _values;
+        /* Variable: received
+         *  Contributions of the neighboring subdomains to the block rows computed by the current process. */
+        std::vector<K>                              _received;
+        /* Variable: pattern
+         *  Sparsity pattern of the coarse operator assembled by the current master process, as supplied to <Solver>. */
+        std::vector<int>                             _pattern;
+        /* Variable: offsets
+         *  For each neighboring subdomain, its rank, the size of the overlap, its number of coarse degrees of freedom, and the offsets of its contribution in <Coarse operator::values>, in the column indices of the coarse operator, and in <Coarse operator::received>. */
+        std::vector<std::array<unsigned int, 6>>     _offsets;
+        /* Variable: transfers
+         *  Ranks in <Subdomain::communicator>, offsets in <Coarse operator::values>, and sizes of the block rows sent to or received by a master process. */
+        std::vector<std::array<int, 3>>            _transfers;
+        /* Variable: layout
+         *  Value of <Coarse operator::local>, leading dimension and offset of the diagonal block in <Coarse operator::values>, first row of the coarse operator computed by the current process, first argument supplied to <Solver>, and offset of the column indices in <Coarse operator::pattern>. */
+        std::array<int, 6>                            _layout;
+#endif
         /* Function: constructionCommunicator
          *  Builds both <Coarse operator::scatterComm> and <DMatrix::communicator>. */
         template<bool>
@@ -120,6 +152,37 @@ class CoarseOperator : public coarse_operator_type<Solver, S, downscaled_type<K>
         std::pair<MPI_Request, const K*>* constructionMatrix(typename std::enable_if<Operator::_pattern == 'u', Operator>::type&);
         template<char T, unsigned short U, unsigned short excluded, bool blocked>
         void finishSetup(unsigned short*&, const int, const unsigned short, unsigned short**&, const int);
+        /* Function: diagonalBlock
+         *
+         *  Computes the diagonal block of the coarse operator associated to the current subdomain.
+         *
+         * Template Parameter:
+         *    blocked        - True if the coarse operator is stored by blocks, false otherwise.
+         *
+         * Parameters:
+         *    EV             - Deflation vectors.
+         *    work           - Product of the local matrix with the deflation vectors, scaled by the partition of unity.
+         *    n              - Number of rows of the local matrix.
+         *    C              - Block rows of the coarse operator computed by the current process.
+         *    coefficients   - Leading dimension of C.
+         *    before         - Offset of the diagonal block in C. */
+        template<bool blocked>
+        void diagonalBlock(const K* const* const, const K* const, const int, K* const, const int, const unsigned short) const;
+        /* Function: factorize
+         *
+         *  Supplies the coarse operator assembled by a master process to <Solver>.
+         *
+         * Template Parameter:
+         *    blocked        - True if the coarse operator is stored by blocks, false otherwise.
+         *
+         * Parameters:
+         *    n              - Number of rows, or number of nonzero entries if the coarse operator is stored in coordinate format.
+         *    I              - Array of row pointers or row indices, followed by column indices.
+         *    loc2glob       - Global indices of the rows, or lower and upper bounds of the rows, assembled by the current master process.
+         *    J              - Array of column indices.
+         *    C              - Array of values. */
+        template<bool blocked>
+        void factorize(unsigned int, int*, int*, int*, K*);
         /* Function: constructionCommunicatorCollective
          *
          *  Builds both communicators <Coarse operator::gatherComm> and <DMatrix::scatterComm> needed for coarse corrections.
@@ -161,6 +224,32 @@ class CoarseOperator : public coarse_operator_type<Solver, S, downscaled_type<K>
             else if(out)
                 MPI_Comm_dup(in, out);
         }
+        /* Function: replicate
+         *
+         *  Broadcasts the coarse operator assembled on the root of <Coarse operator::gatherComm> to the other processes of this communicator, so that they can factorize it as well, see <DMatrix::REPLICATED>.
+         *
+         * Parameters:
+         *    n              - Number of rows of the coarse operator.
+         *    I              - Array of row pointers followed by column indices, or nullptr if the coarse operator is dense.
+         *    C              - Array of values. */
+        void replicate(unsigned int& n, int*& I, downscaled_type<K>*& C) const {
+            int rank, size[2];
+            MPI_Comm_rank(_gatherComm, &rank);
+            if(rank == 0) {
+                size[0] = n;
+                size[1] = (I ? I[n] : -1);
+            }
+            MPI_Bcast(size, 2, MPI_INT, 0, _gatherComm);
+            if(rank) {
+                n = size[0];
+                if(size[1] != -1)
+                    I = new int[n + 1 + size[1]];
+                C = new downscaled_type<K>[size[1] != -1 ? size[1] : n * n];
+            }
+            if(I)
+                MPI_Bcast(I, n + 1 + size[1], MPI_INT, 0, _gatherComm);
+            MPI_Bcast(C, size[1] != -1 ? size[1] : n * n, Wrapper<downscaled_type<K>>::mpi_type(), 0, _gatherComm);
+        }
         /* Function: transfer
          *
          *  Transfers vectors from the fine grid to the coarse grid, and vice versa.
@@ -217,9 +306,12 @@ class CoarseOperator : public coarse_operator_type<Solver, S, downscaled_type<K>
             }
         }
     public:
-        CoarseOperator() : _gatherComm(MPI_COMM_NULL), _scatterComm(MPI_COMM_NULL), _rankWorld(), _sizeWorld(), _sizeSplit(), _local(), _sizeRHS(), _offset(false) {
+        CoarseOperator() : _gatherComm(MPI_COMM_NULL), _scatterComm(MPI_COMM_NULL), _rankWorld(), _sizeWorld(), _sizeSplit(), _local(), _sizeRHS(), _offset(false), _keep(false) {
             static_assert(S == 'S' || S == 'G', "Unknown symmetry");
             static_assert(!Wrapper<K>::is_complex || S != 'S', "Symmetric complex coarse operators are not supported");
+#ifdef HPDDM_UPDATE_CO
+            _layout.fill(-1);
+#endif
         }
         ~CoarseOperator() {
             int isFinalized;
@@ -241,6 +333,17 @@ class CoarseOperator : public coarse_operator_type<Solver, S, downscaled_type<K>
          *  Wrapper function to call all needed subroutines. */
         template<unsigned short, unsigned short, class Operator>
         std::pair<MPI_Request, const K*>* construction(Operator&&, const MPI_Comm&);
+        /* Function: update
+         *
+         *  Updates in place the coarse operator built by <Coarse operator::construction> after the local matrices or the deflation vectors of some subdomains have changed. Only the block rows and columns of the coarse operator associated to these subdomains are recomputed and sent to the master processes, which then refactorize the coarse operator numerically.
+         *
+         * Parameters:
+         *    v              - Operator used in the definition of the Galerkin matrix.
+         *    dirty          - True if the local matrix or the deflation vectors of the current subdomain have changed, false otherwise.
+         *
+         * Returns false if the coarse operator cannot be updated in place, e.g., if the number of deflation vectors or the neighbors of a subdomain have changed, true otherwise. */
+        template<class Operator>
+        bool update(Operator&&, const bool);
         /* Function: callSolver
          *
          *  Solves a coarse system.
@@ -265,9 +368,34 @@ class CoarseOperator : public coarse_operator_type<Solver, S, downscaled_type<K>
         /* Function: setLocal
          *  Sets the value of <Coarse operator::local>. */
         void setLocal(int l) { _local = l; }
+        /* Function: setKeep
+         *  Sets the value of <Coarse operator::keep>. */
+        void setKeep(bool k) { _keep = k; }
+        /* Function: setLevel
+         *
+         *  Sets the prefix of the options of the coarse operator if the <Preconditioner> which assembles it is a coarse level of a multilevel method, e.g., level_2_master_p instead of master_p. Otherwise, e.g., for a <Preconditioner> with a user-supplied prefix, the options of the coarse operator are not prefixed. Options specific to distributed direct solvers, e.g., master_mumps_icntl_14, are never prefixed.
+         *
+         * Parameter:
+         *    prefix         - Prefix of the <Preconditioner>. */
+        void setLevel(const std::string& prefix) {
+            const std::string::size_type pos = prefix.rfind("level_");
+            if(pos != std::string::npos && prefix.size() > pos + 7 && prefix.back() == '_' && std::all_of(prefix.cbegin() + pos + 6, prefix.cend() - 1, [](const char c) { return std::isdigit(c); }))
+                _level = prefix;
+            else
+                _level.clear();
+#if HPDDM_INEXACT_COARSE_OPERATOR
+            super::setPrefix(_level + "master_");
+#endif
+        }
+        /* Function: getLevel
+         *  Returns the value of <Coarse operator::level>. */
+        const std::string& getLevel() const { return _level; }
         /* Function: getSizeRHS
          *  Returns the value of <Coarse operator::sizeRHS>. */
         unsigned int getSizeRHS() const { return _sizeRHS; }
+        /* Function: getTimer
+         *  Returns a constant reference to <Coarse operator::timer>. */
+        const Timer<2>& getTimer() const { return _timer; }
 };
 } // HPDDM
 #endif // _HPDDM_COARSE_OPERATOR_
@@ -34,17 +34,33 @@ inline void CoarseOperator<Solver, S, K>::constructionCommunicator(const MPI_Com
     MPI_Comm_size(comm, &_sizeWorld);
     MPI_Comm_rank(comm, &_rankWorld);
     Option& opt = *Option::get();
-    unsigned short p = opt.val<unsigned short>("master_p", 1);
+    unsigned short p = opt.val<unsigned short>(_level + "master_p", 1);
 #if !defined(DSUITESPARSE) && !defined(DLAPACK)
     if(p > _sizeWorld / 2 && _sizeWorld > 1) {
-        p = opt["master_p"] = _sizeWorld / 2;
+        p = opt[_level + "master_p"] = _sizeWorld / 2;
         if(_rankWorld == 0)
             std::cout << "WARNING -- the number of master processes was set to a value greater than MPI_Comm_size / 2, the value has been reset to " << p << std::endl;
     }
+    int* pm = nullptr;
+    if(p > 1 && (opt.val<char>(_level + "master_topology", 0) == 3 || opt.val<char>(_level + "master_topology", 0) == 4)) {
+        pm = new int[p];
+        DMatrix::nodeMasters(comm, p, opt.val<char>(_level + "master_topology", 0), pm);
+        opt[_level + "master_p"] = p;
+    }
 #else
-    p = opt["master_p"] = 1;
+    p = opt[_level + "master_p"] = 1;
+    DMatrix::_distribution = (opt.val<char>(_level + "master_distribution", HPDDM_MASTER_DISTRIBUTION_CENTRALIZED) == DMatrix::REPLICATED ? DMatrix::REPLICATED : DMatrix::CENTRALIZED);
+    if(exclude && DMatrix::_distribution == DMatrix::REPLICATED) {
+        opt[_level + "master_distribution"] = HPDDM_MASTER_DISTRIBUTION_CENTRALIZED;
+        DMatrix::_distribution = DMatrix::CENTRALIZED;
+        if(_rankWorld == 0)
+            std::cout << "WARNING -- replicated coarse solves are not supported with master_exclude, master_distribution has been reset to centralized" << std::endl;
+    }
 #endif
     if(p == 1) {
+#if !defined(DSUITESPARSE) && !defined(DLAPACK)
+        delete [] pm;
+#endif
         MPI_Comm_dup(comm, &_scatterComm);
         _gatherComm = _scatterComm;
         if(_rankWorld)
@@ -53,6 +69,17 @@ inline void CoarseOperator<Solver, S, K>::constructionCommunicator(const MPI_Com
             DMatrix::_communicator = MPI_COMM_SELF;
         DMatrix::_rank = 0;
         DMatrix::_ldistribution = new int[1]();
+#if defined(DSUITESPARSE) || defined(DLAPACK)
+        if(DMatrix::_distribution == DMatrix::REPLICATED) {
+            // until the end of the setup, <Coarse operator::gatherComm> is made of the lowest rank of each shared-memory node
+            MPI_Comm node;
+            int rank;
+            MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, _rankWorld, MPI_INFO_NULL, &node);
+            MPI_Comm_rank(node, &rank);
+            MPI_Comm_free(&node);
+            MPI_Comm_split(comm, rank == 0 ? 0 : MPI_UNDEFINED, _rankWorld, &_gatherComm);
+        }
+#endif
     }
     else {
         MPI_Group master, split;
@@ -60,14 +87,21 @@ inline void CoarseOperator<Solver, S, K>::constructionCommunicator(const MPI_Com
         MPI_Comm_group(comm, &world);
         int* ps;
         unsigned int tmp;
+        const char T = opt.val<char>(_level + "master_topology", 0);
+#if !defined(DSUITESPARSE) && !defined(DLAPACK)
+        DMatrix::_ldistribution = (pm ? pm : new int[p]);
+#else
         DMatrix::_ldistribution = new int[p];
-        const char T = opt.val<char>("master_topology", 0);
-        if(T == 2) {
-            // Here, it is assumed that all subdomains have the same number of coarse degrees of freedom as the rank 0 ! (only true when the distribution is uniform)
-            float area = _sizeWorld *_sizeWorld / (2.0 * p);
-            *DMatrix::_ldistribution = 0;
-            for(unsigned short i = 1; i < p; ++i)
-                DMatrix::_ldistribution[i] = static_cast<int>(_sizeWorld - std::sqrt(std::max(_sizeWorld * _sizeWorld - 2 * _sizeWorld * DMatrix::_ldistribution[i - 1] - 2 * area + DMatrix::_ldistribution[i - 1] * DMatrix::_ldistribution[i - 1], 1.0f)) + 0.5);
+#endif
+        if(T == 2 || T == 3 || T == 4) {
+            // with topologies 3 and 4, master processes are the lowest ranks of some shared-memory nodes or sockets, see <DMatrix::nodeMasters>, and the remaining processes are assigned to the closest master process with a lower rank, as with topology 2
+            if(T == 2) {
+                // Here, it is assumed that all subdomains have the same number of coarse degrees of freedom as the rank 0 ! (only true when the distribution is uniform)
+                float area = _sizeWorld *_sizeWorld / (2.0 * p);
+                *DMatrix::_ldistribution = 0;
+                for(unsigned short i = 1; i < p; ++i)
+                    DMatrix::_ldistribution[i] = static_cast<int>(_sizeWorld - std::sqrt(std::max(_sizeWorld * _sizeWorld - 2 * _sizeWorld * DMatrix::_ldistribution[i - 1] - 2 * area + DMatrix::_ldistribution[i - 1] * DMatrix::_ldistribution[i - 1], 1.0f)) + 0.5);
+            }
             int* idx = std::upper_bound(DMatrix::_ldistribution, DMatrix::_ldistribution + p, _rankWorld);
             unsigned short i = idx - DMatrix::_ldistribution;
             tmp = (i == p) ? _sizeWorld - DMatrix::_ldistribution[i - 1] : DMatrix::_ldistribution[i] - DMatrix::_ldistribution[i - 1];
@@ -97,7 +131,7 @@ inline void CoarseOperator<Solver, S, K>::constructionCommunicator(const MPI_Com
 #endif
         else {
             if(T != 0)
-                opt["master_topology"] = 0;
+                opt[_level + "master_topology"] = 0;
             if(_rankWorld < (p - 1) * (_sizeWorld / p))
                 tmp = _sizeWorld / p;
             else
@@ -251,11 +285,14 @@ inline std::pair<MPI_Request, const K*>* CoarseOperator<Solver, S, K>::construct
     if(U == 2 && _local == 0)
         _offset = true;
     MPI_Comm_size(_scatterComm, &_sizeSplit);
-    switch(Option::get()->val<char>("master_topology", 0)) {
+    const Timer<2>::Scope scope(_timer, 0);
+    switch(Option::get()->val<char>(_level + "master_topology", 0)) {
 #ifndef HPDDM_CONTIGUOUS
         case  1: return constructionMatrix<1, U, excluded, Operator>(v);
 #endif
-        case  2: return constructionMatrix<2, U, excluded, Operator>(v);
+        case  2:
+        case  3:
+        case  4: return constructionMatrix<2, U, excluded, Operator>(v);
         default: return constructionMatrix<0, U, excluded, Operator>(v);
     }
 }
@@ -279,14 +316,14 @@ inline std::pair<MPI_Request, const K*>* CoarseOperator<Solver, S, K>::construct
     K*   C;
 
     const Option& opt = *Option::get();
-    const unsigned short p = opt.val<unsigned short>("master_p", 1);
+    const unsigned short p = opt.val<unsigned short>(_level + "master_p", 1);
     constexpr bool blocked =
 #if defined(DMKL_PARDISO) || defined(DELEMENTAL) || HPDDM_INEXACT_COARSE_OPERATOR
                              (U == 1 && Operator::_pattern == 's');
 #else
                              false;
 #endif
-    unsigned short treeDimension = opt.val<unsigned short>("master_assembly_hierarchy"), currentHeight = 0;
+    unsigned short treeDimension = opt.val<unsigned short>(_level + "master_assembly_hierarchy"), currentHeight = 0;
     if(treeDimension <= 1 || treeDimension >= _sizeSplit)
         treeDimension = 0;
     unsigned short treeHeight = treeDimension ? std::ceil(std::log(_sizeSplit) / std::log(treeDimension)) : 0;
@@ -512,6 +549,10 @@ inline std::pair<MPI_Request, const K*>* CoarseOperator<Solver, S, K>::construct
     K** recvNeighbor;
     int coefficients = (U == 1 ? _local * (info[0] + (S != 'S' || blocked)) : std::accumulate(infoNeighbor + first, infoNeighbor + sparsity.size(), S == 'S' ? 0 : _local));
     K* work = nullptr;
+    unsigned short before = 0;
+#ifdef HPDDM_UPDATE_CO
+    const bool keep = (_keep && Operator::_pattern == 's' && excluded == 0 && !blocked && !treeDimension && std::is_same<downscaled_type<K>, K>::value && DMatrix::_distribution != DMatrix::REPLICATED);
+#endif
     if(Operator::_pattern == 's') {
         rqRecv = (rankSplit == 0 && !treeDimension ? new MPI_Request[_sizeSplit - 1 + info[0]] : rqSend + (S != 'S' ? info[0] : first));
         unsigned int accumulate = 0;
@@ -541,17 +582,24 @@ inline std::pair<MPI_Request, const K*>* CoarseOperator<Solver, S, K>::construct
         }
         else
             std::fill_n(rqRecv, info[0], MPI_REQUEST_NULL);
+#ifdef HPDDM_UPDATE_CO
+        if(keep) {
+            _offsets.resize(M.size());
+            for(unsigned short i = 0; i < M.size(); ++i)
+                _offsets[i] = {{ M[i].first, static_cast<unsigned int>(M[i].second.size()), static_cast<unsigned int>(U == 1 ? _local : infoNeighbor[i]), 0, 0, 0 }};
+            for(unsigned short i = first + 1; i < M.size(); ++i)
+                _offsets[i][5] = _offsets[i - 1][5] + _offsets[i - 1][2] * _offsets[i - 1][1];
+        }
+#endif
         if(excluded < 2) {
             const K* const* const& EV = v._p.getVectors();
             const int n = v._p.getDof();
             v.initialize(n * (U == 1 || info[0] == 0 ? _local : std::max(static_cast<unsigned short>(_local), *std::max_element(infoNeighbor + first, infoNeighbor + sparsity.size()))), work, S != 'S' ? info[0] : first);
             v.template applyToNeighbor<S, U == 1>(sendNeighbor, work, rqSend, infoNeighbor);
             if(S != 'S') {
-                unsigned short before = 0;
                 for(unsigned short j = 0; j < info[0] && sparsity[j] < rank; ++j)
                     before += (U == 1 ? (!blocked ? _local : 1) : infoNeighbor[j]);
-                Blas<K>::gemm(&(Wrapper<K>::transc), "N", &_local, &_local, &n, &(Wrapper<K>::d__1), work, &n, *EV, &n, &(Wrapper<K>::d__0), C + before * (!blocked ? 1 : _local * _local), !blocked ? &coefficients : &_local);
-                Wrapper<K>::template imatcopy<'R'>(_local, _local, C + before * (!blocked ? 1 : _local * _local), !blocked ? coefficients : _local, !blocked ? coefficients : _local);
+                diagonalBlock<blocked>(EV, work, n, C, coefficients, before);
                 if(rankSplit == 0) {
                     if(!blocked)
                         for(unsigned short j = 0; j < _local; ++j) {
@@ -572,17 +620,7 @@ inline std::pair<MPI_Request, const K*>* CoarseOperator<Solver, S, K>::construct
                 }
             }
             else {
-                if(blocked || coefficients >= _local) {
-                    Blas<K>::gemm(&(Wrapper<K>::transc), "N", &_local, &_local, &n, &(Wrapper<K>::d__1), *EV, &n, work, &n, &(Wrapper<K>::d__0), C, &_local);
-                    if(!blocked)
-                        for(unsigned short j = _local; j-- > 0; )
-                            std::copy_backward(C + j * (_local + 1), C + (j + 1) * _local, C - (j * (j + 1)) / 2 + j * coefficients + (j + 1) * _local);
-                }
-                else
-                    for(unsigned short j = 0; j < _local; ++j) {
-                        int local = _local - j;
-                        Blas<K>::gemv(&(Wrapper<K>::transc), &n, &local, &(Wrapper<K>::d__1), EV[j], &n, work + n * j, &i__1, &(Wrapper<K>::d__0), C - (j * (j - 1)) / 2 + j * (coefficients + _local), &i__1);
-                    }
+                diagonalBlock<blocked>(EV, work, n, C, coefficients, 0);
                 if(rankSplit == 0) {
                     if(!blocked)
                         for(unsigned short j = _local; j-- > 0; ) {
@@ -638,6 +676,10 @@ inline std::pair<MPI_Request, const K*>* CoarseOperator<Solver, S, K>::construct
                     v.template assembleForMaster<!blocked ? S : 'B', U == 1>(C + offsetArray[index], recvNeighbor[index], coefficients + (S == 'S' && !blocked ? _local - 1 : 0), index + first, blocked && super::_numbering == 'F' ? C + offsetArray[index] * _local : work, infoNeighbor + first + index);
                     if(blocked && super::_numbering == 'C')
                         Wrapper<K>::template omatcopy<'T'>(_local, _local, work, _local, C + offsetArray[index] * _local, _local);
+#ifdef HPDDM_UPDATE_CO
+                    if(keep)
+                        _offsets[first + index][3] = offsetArray[index];
+#endif
                 }
                 delete [] offsetArray;
             }
@@ -653,6 +695,12 @@ inline std::pair<MPI_Request, const K*>* CoarseOperator<Solver, S, K>::construct
             if(!std::is_same<downscaled_type<K>, K>::value)
                 for(unsigned int i = 0; i < size; ++i)
                     pt[i] = C[i];
+#ifdef HPDDM_UPDATE_CO
+            if(keep) {
+                _values.assign(C, C + size);
+                _transfers.push_back({{ 0, 0, static_cast<int>(size) }});
+            }
+#endif
             if(!treeDimension) {
                 if(excluded)
                     MPI_Isend(pt, size, Wrapper<downscaled_type<K>>::mpi_type(), 0, 3, _scatterComm, &ret->first);
@@ -720,6 +768,12 @@ inline std::pair<MPI_Request, const K*>* CoarseOperator<Solver, S, K>::construct
                 else
                     MPI_Irecv(reinterpret_cast<downscaled_type<K>*>(C) + offsetIdx[k - 1], _local * _local * infoSplit[k][0] + (S == 'S' && !blocked ? _local * (_local + 1) / 2 : _local * _local), Wrapper<downscaled_type<K>>::mpi_type(), k, 3, _scatterComm, rqRecv + treeHeight + k - 1);
             }
+#ifdef HPDDM_UPDATE_CO
+            if(keep)
+                for(unsigned short k = 1; k < _sizeSplit; ++k)
+                    if(U == 1 || infoSplit[k][1])
+                        _transfers.push_back({{ k, static_cast<int>(offsetIdx[k - 1]), U != 1 ? infoSplit[k][2] * infoSplit[k][1] + (S == 'S' ? infoSplit[k][1] * (infoSplit[k][1] + 1) / 2 : 0) : _local * _local * infoSplit[k][0] + (S == 'S' ? _local * (_local + 1) / 2 : _local * _local) }});
+#endif
         }
         else {
             std::fill_n(rqTree, treeHeight * (treeDimension - 1), MPI_REQUEST_NULL);
@@ -954,6 +1008,12 @@ inline std::pair<MPI_Request, const K*>* CoarseOperator<Solver, S, K>::construct
                     if(Operator::_pattern == 's') {
                         const unsigned int offset = offsetArray[index][0] / (!blocked ? 1 : _local);
                         v.template applyFromNeighborMaster<!blocked ? S : 'B', super::_numbering, U == 1>(recvNeighbor[index], index + first, I + offset, J + offset, backup + offsetArray[index][0] * (!blocked ? 1 : _local), coefficients + (S == 'S' && !blocked) * (_local - 1), v._max, U == 1 ? nullptr : (offsetArray[index] + 1), work, U == 1 ? nullptr : infoNeighbor + first + index);
+#ifdef HPDDM_UPDATE_CO
+                        if(keep) {
+                            _offsets[first + index][3] = offsetArray[index][0];
+                            _offsets[first + index][4] = (U == 1 ? M[first + index].first * _local + (super::_numbering == 'F') : offsetArray[index][1]);
+                        }
+#endif
 #if HPDDM_INEXACT_COARSE_OPERATOR
                         if(T == 1 && M[first + index].first < p)
                             neighbors[offset] = M[first + index].first;
@@ -1004,7 +1064,7 @@ inline std::pair<MPI_Request, const K*>* CoarseOperator<Solver, S, K>::construct
         }
         delete [] work;
         downscaled_type<K>* pt = reinterpret_cast<downscaled_type<K>*>(C);
-        std::string filename = opt.prefix("master_dump_matrix", true);
+        std::string filename = opt.prefix(_level + "master_dump_matrix", true);
         if(filename.size() > 0) {
             if(excluded == 2)
                 filename += "_excluded";
@@ -1054,7 +1114,7 @@ inline std::pair<MPI_Request, const K*>* CoarseOperator<Solver, S, K>::construct
             }
             delete [] backup;
         }
-        super::_mu = std::min(p, opt.val<unsigned short>("master_aggregate_size", p));
+        super::_mu = std::min(p, opt.val<unsigned short>(_level + "master_aggregate_size", p));
         rank = DMatrix::_n;
         if(super::_mu < p) {
             super::_di = new int[T == 1 ? 3 : 1];
@@ -1101,27 +1161,53 @@ inline std::pair<MPI_Request, const K*>* CoarseOperator<Solver, S, K>::construct
             for(unsigned short i = 1; i < p; ++i)
                 DMatrix::_ldistribution[i] += i;
 #else
-# ifdef HPDDM_CSR_CO
-#  ifndef DHYPRE
-         std::partial_sum(I, I + 1 + nrow / (!blocked ? 1 : _local), I);
-#  endif
-#  if defined(DSUITESPARSE) || defined(DLAPACK)
-        super::template numfact<S>(nrow, I, J, pt);
-        delete [] loc2glob;
-#  elif defined(DMKL_PARDISO) || defined(DELEMENTAL)
-        super::template numfact<S>(!blocked ? 1 : _local, I, loc2glob, J, pt);
-        C = reinterpret_cast<K*>(pt);
+# if defined(HPDDM_CSR_CO) && !defined(DHYPRE)
+        std::partial_sum(I, I + 1 + nrow / (!blocked ? 1 : _local), I);
+# endif
+# ifdef HPDDM_UPDATE_CO
+        if(keep) {
+            _values.assign(C, C + size);
+#  ifdef HPDDM_CSR_CO
+            _pattern.assign(I, I + nrow + 1 + size);
+            _layout[4] = nrow;
+            _layout[5] = nrow + 1;
 #  else
-        super::template numfact<S>(nrow, I, loc2glob, J, pt);
+            _pattern.assign(I, I + 2 * size);
+            _layout[4] = _layout[5] = size;
 #  endif
+            _layout[3] = v._max;
+        }
+# endif
+# ifdef HPDDM_CSR_CO
+        factorize<blocked>(nrow, I, loc2glob, J, C);
 # else
-        super::template numfact<S>(size, I, J, pt);
+        factorize<blocked>(size, I, nullptr, J, C);
 # endif
-        delete [] C;
 #endif
         if(!treeDimension)
             delete [] rqRecv;
     }
+#ifdef HPDDM_UPDATE_CO
+    if(keep) {
+        unsigned int received = 0;
+        for(unsigned short i = first; i < M.size(); ++i)
+            received += _offsets[i][2] * _offsets[i][1];
+        if(received && (U == 1 || _local))
+            _received.assign(*recvNeighbor, *recvNeighbor + received);
+        if(!_transfers.empty()) {
+            MPI_Group world, split;
+            MPI_Comm_group(v._p.getCommunicator(), &world);
+            MPI_Comm_group(_scatterComm, &split);
+            for(std::array<int, 3>& t : _transfers)
+                MPI_Group_translate_ranks(split, 1, &t[0], world, &t[0]);
+            MPI_Group_free(&split);
+            MPI_Group_free(&world);
+        }
+        _layout[0] = _local;
+        _layout[1] = coefficients;
+        _layout[2] = before;
+    }
+#endif
     if(excluded < 2) {
         delete [] *sendNeighbor;
         *sendNeighbor = nullptr;
@@ -1146,7 +1232,7 @@ inline std::pair<MPI_Request, const K*>* CoarseOperator<Solver, S, K>::construct
     unsigned int size = 0;
 
     const Option& opt = *Option::get();
-    const unsigned short p = opt.val<unsigned short>("master_p", 1);
+    const unsigned short p = opt.val<unsigned short>(_level + "master_p", 1);
     constexpr bool blocked = false;
     if(U != 1) {
         infoNeighbor = new unsigned short[info[0]];
@@ -1359,6 +1445,12 @@ inline std::pair<MPI_Request, const K*>* CoarseOperator<Solver, S, K>::construct
             delete [] infoNeighbor;
         const K* const E = v._p.getOperator();
 #if defined(DSUITESPARSE) || defined(DLAPACK)
+        if(DMatrix::_distribution == DMatrix::REPLICATED) {
+            unsigned int n = DMatrix::_n;
+            int* I = nullptr;
+            downscaled_type<K>* pt = const_cast<K*>(E);
+            replicate(n, I, pt);
+        }
         super::template numfact<S>(DMatrix::_n, nullptr, nullptr, const_cast<K*&>(E));
 #elif defined(HPDDM_CONTIGUOUS)
         super::template numfact<S>(!blocked ? 1 : _local, nullptr, loc2glob, nullptr, const_cast<K*&>(E));
@@ -1368,11 +1460,198 @@ inline std::pair<MPI_Request, const K*>* CoarseOperator<Solver, S, K>::construct
     return nullptr;
 }
 
+template<template<class> class Solver, char S, class K>
+template<bool blocked>
+inline void CoarseOperator<Solver, S, K>::diagonalBlock(const K* const* const EV, const K* const work, const int n, K* const C, const int coefficients, const unsigned short before) const {
+    if(S != 'S') {
+        Blas<K>::gemm(&(Wrapper<K>::transc), "N", &_local, &_local, &n, &(Wrapper<K>::d__1), work, &n, *EV, &n, &(Wrapper<K>::d__0), C + before * (!blocked ? 1 : _local * _local), !blocked ? &coefficients : &_local);
+        Wrapper<K>::template imatcopy<'R'>(_local, _local, C + before * (!blocked ? 1 : _local * _local), !blocked ? coefficients : _local, !blocked ? coefficients : _local);
+    }
+    else {
+        if(blocked || coefficients >= _local) {
+            Blas<K>::gemm(&(Wrapper<K>::transc), "N", &_local, &_local, &n, &(Wrapper<K>::d__1), *EV, &n, work, &n, &(Wrapper<K>::d__0), C, &_local);
+            if(!blocked)
+                for(unsigned short j = _local; j-- > 0; )
+                    std::copy_backward(C + j * (_local + 1), C + (j + 1) * _local, C - (j * (j + 1)) / 2 + j * coefficients + (j + 1) * _local);
+        }
+        else
+            for(unsigned short j = 0; j < _local; ++j) {
+                int local = _local - j;
+                Blas<K>::gemv(&(Wrapper<K>::transc), &n, &local, &(Wrapper<K>::d__1), EV[j], &n, work + n * j, &i__1, &(Wrapper<K>::d__0), C - (j * (j - 1)) / 2 + j * (coefficients + _local), &i__1);
+            }
+    }
+}
+
+template<template<class> class Solver, char S, class K>
+template<bool blocked>
+inline void CoarseOperator<Solver, S, K>::factorize(unsigned int n, int* I, int* loc2glob, int* J, K* C) {
+    downscaled_type<K>* pt = reinterpret_cast<downscaled_type<K>*>(C);
+#ifdef HPDDM_CSR_CO
+# if defined(DSUITESPARSE) || defined(DLAPACK)
+    if(DMatrix::_distribution == DMatrix::REPLICATED)
+        replicate(n, I, pt);
+    super::template numfact<S>(n, I, J, pt);
+    delete [] loc2glob;
+# elif defined(DMKL_PARDISO) || defined(DELEMENTAL)
+    super::template numfact<S>(!blocked ? 1 : _local, I, loc2glob, J, pt);
+    C = reinterpret_cast<K*>(pt);
+# else
+    super::template numfact<S>(n, I, loc2glob, J, pt);
+# endif
+#else
+    super::template numfact<S>(n, I, J, pt);
+#endif
+    delete [] C;
+}
+
+template<template<class> class Solver, char S, class K>
+template<class Operator>
+inline bool CoarseOperator<Solver, S, K>::update(Operator&& v, const bool dirty) {
+#ifdef HPDDM_UPDATE_CO
+    if(_layout[0] == -1)
+        return false;
+    const vectorNeighbor& M = v._p.getMap();
+    const MPI_Comm& comm = v._p.getCommunicator();
+    int flag[2] = { _layout[0] == v._p.getLocal() && _offsets.size() == M.size(), !dirty };
+    for(unsigned short i = 0; i < M.size() && flag[0]; ++i)
+        flag[0] = (_offsets[i][0] == M[i].first && _offsets[i][1] == M[i].second.size());
+    MPI_Allreduce(MPI_IN_PLACE, flag, 2, MPI_INT, MPI_MIN, comm);
+    if(!flag[0])
+        return false;
+    if(flag[1])
+        return true;
+    int rank;
+    MPI_Comm_rank(comm, &rank);
+    const unsigned short first = (S == 'S' ? std::distance(M.cbegin(), std::find_if(M.cbegin(), M.cend(), [&](const pairNeighbor& n) { return n.first > rank; })) : 0);
+    const unsigned short sent = (S != 'S' ? M.size() : first);
+    const bool master = !_pattern.empty();
+    std::vector<unsigned short> nu(M.size());
+    int max = _local;
+    for(unsigned short i = 0; i < M.size(); ++i) {
+        nu[i] = _offsets[i][2];
+        if(i >= first)
+            max = std::max(max, static_cast<int>(nu[i]));
+    }
+    MPI_Request* rq = new MPI_Request[sent + M.size() - first + _transfers.size()];
+    MPI_Request* rqRecv = rq + sent;
+    MPI_Request* rqTransfer = rqRecv + M.size() - first;
+    if(master)
+        for(unsigned short k = 0; k < _transfers.size(); ++k)
+            MPI_Irecv(_values.data() + _transfers[k][1], _transfers[k][2], Wrapper<K>::mpi_type(), _transfers[k][0], 3, comm, rqTransfer + k);
+    for(unsigned short i = first; i < M.size(); ++i) {
+        if(_local)
+            MPI_Irecv(_received.data() + _offsets[i][5], nu[i] * _offsets[i][1], Wrapper<K>::mpi_type(), M[i].first, 2, comm, rqRecv + i - first);
+        else
+            rqRecv[i - first] = MPI_REQUEST_NULL;
+    }
+    const int n = v._p.getDof();
+    K* work;
+    K** send = new K*[std::max(sent, static_cast<unsigned short>(1))];
+    *send = nullptr;
+    MPI_Request* rqSend = rq;
+    if(dirty) {
+        unsigned int accumulate = 0;
+        for(unsigned short i = 0; i < sent; ++i)
+            accumulate += _local * M[i].second.size();
+        if(sent) {
+            *send = new K[accumulate];
+            for(unsigned short i = 1; i < sent; ++i)
+                send[i] = send[i - 1] + _local * M[i - 1].second.size();
+        }
+        v.initialize(n * max, work, sent);
+        v.template applyToNeighbor<S, false>(send, work, rqSend, nu.data());
+        if(_local)
+            diagonalBlock<false>(v._p.getVectors(), work, n, _values.data(), _layout[1], _layout[2]);
+    }
+    else {
+        work = new K[2 * n * max];
+        v._work = work + n * max;
+        for(unsigned short i = 0; i < sent; ++i)
+            if(nu[i])
+                MPI_Isend(nullptr, 0, Wrapper<K>::mpi_type(), M[i].first, 2, comm, rqSend++);
+    }
+    std::fill(rqSend, rqRecv, MPI_REQUEST_NULL);
+    bool changed = dirty;
+    for(unsigned short k = first; k < M.size(); ++k) {
+        int index, count = 0;
+        MPI_Status st;
+        MPI_Waitany(M.size() - first, rqRecv, &index, &st);
+        if(index == MPI_UNDEFINED)
+            break;
+        MPI_Get_count(&st, Wrapper<K>::mpi_type(), &count);
+        const unsigned short i = index + first;
+        if(!dirty && count == 0)
+            continue;
+        changed = true;
+        if(master)
+            v.template applyFromNeighborMaster<S, super::_numbering, false>(_received.data() + _offsets[i][5], i, _pattern.data() + _offsets[i][3], _pattern.data() + _layout[5] + _offsets[i][3], _values.data() + _offsets[i][3], _layout[1] + (S == 'S') * (_local - 1), _layout[3], &(_offsets[i][4]), work, nu.data() + i);
+        else
+            v.template assembleForMaster<S, false>(_values.data() + _offsets[i][3], _received.data() + _offsets[i][5], _layout[1] + (S == 'S') * (_local - 1), i, work, nu.data() + i);
+    }
+    if(!master)
+        for(unsigned short k = 0; k < _transfers.size(); ++k)
+            MPI_Isend(_values.data(), changed ? _transfers[k][2] : 0, Wrapper<K>::mpi_type(), _transfers[k][0], 3, comm, rqTransfer + k);
+    MPI_Waitall(sent, rq, MPI_STATUSES_IGNORE);
+    MPI_Waitall(_transfers.size(), rqTransfer, MPI_STATUSES_IGNORE);
+    delete [] *send;
+    delete [] send;
+    delete [] work;
+    delete [] rq;
+    if(master) {
+        int* I = new int[_pattern.size()];
+        std::copy(_pattern.cbegin(), _pattern.cend(), I);
+        K* C = new K[_values.size()];
+        std::copy(_values.cbegin(), _values.cend(), C);
+        factorize<false>(_layout[4], I, nullptr, I + _layout[5], C);
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
 template<template<class> class Solver, char S, class K>
 template<char T, unsigned short U, unsigned short excluded, bool blocked>
 inline void CoarseOperator<Solver, S, K>::finishSetup(unsigned short*& infoWorld, const int rankSplit, const unsigned short p, unsigned short**& infoSplit, const int rank) {
+#if defined(DSUITESPARSE) || defined(DLAPACK)
+    if(DMatrix::_distribution == DMatrix::REPLICATED) {
+        if(_gatherComm != MPI_COMM_NULL) {
+            if(rankSplit) {
+                unsigned int n;
+                int* I = nullptr;
+                downscaled_type<K>* C = nullptr;
+                replicate(n, I, C);
+                super::template numfact<S>(n, I, I ? I + n + 1 : nullptr, C);
+                delete [] C;
+                DMatrix::_communicator = MPI_COMM_SELF;
+            }
+            MPI_Comm_free(&_gatherComm);
+        }
+        _gatherComm = _scatterComm;
+        MPI_Comm_split_type(_gatherComm, MPI_COMM_TYPE_SHARED, _rankWorld, MPI_INFO_NULL, &_scatterComm);
+        DMatrix::_gatherCounts = new int[2 * _sizeWorld];
+        DMatrix::_displs = DMatrix::_gatherCounts + _sizeWorld;
+        DMatrix::_gatherCounts[_rankWorld] = _local;
+        MPI_Allgather(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, DMatrix::_gatherCounts, 1, MPI_INT, _gatherComm);
+        DMatrix::_displs[0] = 0;
+        std::partial_sum(DMatrix::_gatherCounts, DMatrix::_gatherCounts + _sizeWorld - 1, DMatrix::_displs + 1);
+        DMatrix::_n = DMatrix::_displs[_sizeWorld - 1] + DMatrix::_gatherCounts[_sizeWorld - 1];
+        _sizeRHS = DMatrix::_n;
+        if(rankSplit == 0) {
+            delete [] *infoSplit;
+            delete [] infoSplit;
+        }
+        return;
+    }
+#endif
 #if defined(DMUMPS) && !HPDDM_INEXACT_COARSE_OPERATOR
-    DMatrix::_distribution = static_cast<DMatrix::Distribution>(Option::get()->val<char>("master_distribution", HPDDM_MASTER_DISTRIBUTION_CENTRALIZED));
+    DMatrix::_distribution = static_cast<DMatrix::Distribution>(Option::get()->val<char>(_level + "master_distribution", HPDDM_MASTER_DISTRIBUTION_CENTRALIZED));
+    if(DMatrix::_distribution == DMatrix::REPLICATED) {
+        (*Option::get())[_level + "master_distribution"] = HPDDM_MASTER_DISTRIBUTION_CENTRALIZED;
+        DMatrix::_distribution = DMatrix::CENTRALIZED;
+        if(_rankWorld == 0)
+            std::cout << "WARNING -- replicated coarse solves are not supported with MUMPS, master_distribution has been reset to centralized" << std::endl;
+    }
 #endif
     if(U != 2) {
 #if defined(DMUMPS) && !HPDDM_INEXACT_COARSE_OPERATOR
@@ -1512,6 +1791,8 @@ inline void CoarseOperator<Solver, S, K>::finishSetup(unsigned short*& infoWorld
 template<template<class> class Solver, char S, class K>
 template<bool excluded>
 inline void CoarseOperator<Solver, S, K>::callSolver(K* const pt, const unsigned short& mu) {
+    const Timer<2>::Scope scope(_timer, 1);
+    HPDDM_TRACE_SCOPE("callSolver");
     downscaled_type<K>* rhs = reinterpret_cast<downscaled_type<K>*>(pt);
     if(!std::is_same<downscaled_type<K>, K>::value)
         for(unsigned int i = 0; i < mu * _local; ++i)
@@ -1597,6 +1878,24 @@ inline void CoarseOperator<Solver, S, K>::callSolver(K* const pt, const unsigned
             }
         }
 #else
+# if defined(DSUITESPARSE) || defined(DLAPACK)
+            if(DMatrix::_distribution == DMatrix::REPLICATED) {
+                std::for_each(DMatrix::_gatherCounts, DMatrix::_displs + _sizeWorld, [&](int& i) { i *= mu; });
+                if(DMatrix::_displs[_rankWorld])
+                    std::copy_backward(rhs, rhs + mu * _local, rhs + DMatrix::_displs[_rankWorld] + mu * _local);
+                MPI_Allgatherv(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, rhs, DMatrix::_gatherCounts, DMatrix::_displs, Wrapper<downscaled_type<K>>::mpi_type(), _gatherComm);
+                if(DMatrix::_communicator != MPI_COMM_NULL) {
+                    permute<false>(DMatrix::_gatherCounts, _sizeWorld, mu, rhs);
+                    super::solve(rhs, mu);
+                    permute<true>(DMatrix::_gatherCounts, mu, _sizeWorld, rhs);
+                }
+                MPI_Bcast(rhs, mu * DMatrix::_n, Wrapper<downscaled_type<K>>::mpi_type(), 0, _scatterComm);
+                if(DMatrix::_displs[_rankWorld])
+                    std::copy_n(rhs + DMatrix::_displs[_rankWorld], mu * _local, rhs);
+                std::for_each(DMatrix::_gatherCounts, DMatrix::_displs + _sizeWorld, [&](int& i) { i /= mu; });
+            }
+            else
+# endif
             if(DMatrix::_displs) {
                 if(DMatrix::_communicator != MPI_COMM_NULL) {
                     transfer<false>(DMatrix::_gatherSplitCounts, _sizeSplit, mu, rhs);
@@ -1642,6 +1941,16 @@ inline void CoarseOperator<Solver, S, K>::callSolver(K* const pt, const unsigned
 template<template<class> class Solver, char S, class K>
 template<bool excluded>
 inline void CoarseOperator<Solver, S, K>::IcallSolver(K* const pt, const unsigned short& mu, MPI_Request* rq) {
+#if defined(DSUITESPARSE) || defined(DLAPACK)
+    if(DMatrix::_distribution == DMatrix::REPLICATED) {
+        // the solution is broadcast in the buffer that is also the destination of the all-gather, so nothing can be overlapped
+        callSolver<excluded>(pt, mu);
+        rq[0] = rq[1] = MPI_REQUEST_NULL;
+        return;
+    }
+#endif
+    const Timer<2>::Scope scope(_timer, 1);
+    HPDDM_TRACE_SCOPE("IcallSolver");
     downscaled_type<K>* rhs = reinterpret_cast<downscaled_type<K>*>(pt);
     if(!std::is_same<downscaled_type<K>, K>::value)
         for(unsigned int i = 0; i < mu * _local; ++i)
@@ -1758,11 +2067,11 @@ inline void CoarseOperator<Solver, S, K>::IcallSolver(K* const pt, const unsigne
     else if(DMatrix::_communicator != MPI_COMM_NULL) {
 #if defined(DMUMPS) && !HPDDM_INEXACT_COARSE_OPERATOR
         if(DMatrix::_distribution == DMatrix::DISTRIBUTED_SOL)
-            super::template solve<DMatrix::DISTRIBUTED_SOL>(rhs, mu); break;
+            super::template solve<DMatrix::DISTRIBUTED_SOL>(rhs, mu);
         else
-            super::template solve<DMatrix::CENTRALIZED>(rhs, mu); break;
+            super::template solve<DMatrix::CENTRALIZED>(rhs, mu);
 #else
-            super::solve(rhs, mu); break;
+            super::solve(rhs, mu);
 #endif
     }
     if(!std::is_same<downscaled_type<K>, K>::value)
@@ -39,6 +39,9 @@
 #define HPDDM_KRYLOV_METHOD_BFBCG                               6
 #define HPDDM_KRYLOV_METHOD_RICHARDSON                          7
 #define HPDDM_KRYLOV_METHOD_NONE                                8
+#define HPDDM_KRYLOV_METHOD_GMRESDR                             9
+#define HPDDM_KRYLOV_METHOD_IDR                                10
+#define HPDDM_KRYLOV_METHOD_BICGSTABL                          11
 
 #define HPDDM_VARIANT_LEFT                                      0
 #define HPDDM_VARIANT_RIGHT                                     1
@@ -48,6 +51,9 @@
 #define HPDDM_QR_CGS                                            1
 #define HPDDM_QR_MGS                                            2
 
+#define HPDDM_GMRES_BASIS_PRECISION_FULL                        0
+#define HPDDM_GMRES_BASIS_PRECISION_REDUCED                     1
+
 #define HPDDM_RECYCLE_STRATEGY_A                                0
 #define HPDDM_RECYCLE_STRATEGY_B                                1
 
@@ -26,6 +26,9 @@
 #define _HPDDM_DMATRIX_
 
 #include <map>
+#if defined(__linux__)
+# include <sched.h>
+#endif
 
 namespace HPDDM {
 /* Class: DMatrix
@@ -37,10 +40,80 @@ class DMatrix {
          *  Defines the distribution of both right-hand sides and solution vectors.
          *
          * CENTRALIZED             - Neither are distributed, both are centralized on the root of <DMatrix::communicator>.
-         * DISTRIBUTED_SOL         - Right-hand sides are centralized, while solution vectors are distributed on <DMatrix::communicator>. */
-        enum Distribution : bool {
-            CENTRALIZED, DISTRIBUTED_SOL
+         * DISTRIBUTED_SOL         - Right-hand sides are centralized, while solution vectors are distributed on <DMatrix::communicator>.
+         * REPLICATED              - Both are replicated on one process per shared-memory node, which holds its own factorization of the coarse operator. */
+        enum Distribution : char {
+            CENTRALIZED, DISTRIBUTED_SOL, REPLICATED
         };
+        /* Function: nodeMasters
+         *
+         *  Selects master processes among the lowest ranks of shared-memory nodes, or of sockets, so that there is at most one master process per node, or per socket, and so that master processes are spread as evenly as possible among nodes, or sockets.
+         *
+         * Parameters:
+         *    in             - Original communicator.
+         *    p              - Number of master processes, reset to the number of nodes, or sockets, if there are not enough of them.
+         *    T              - Master processes distribution topology, 3 for nodes, 4 for sockets (only available with Open MPI and processes bound to sockets or cores, nodes are used otherwise). On Linux, bound processes are told apart from unbound ones by their affinity masks. Elsewhere, a process alone in its socket is assumed to be unbound, so that nodes are also used when there is exactly one process per socket.
+         *    pm             - Ranks of the master processes, sorted in increasing order. */
+        static void nodeMasters(const MPI_Comm& in, unsigned short& p, const unsigned short& T, int* const pm) {
+            int size, rank, local;
+            MPI_Comm_size(in, &size);
+            MPI_Comm_rank(in, &rank);
+            MPI_Comm node;
+            MPI_Comm_split_type(in, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &node);
+            bool socket = false;
+#ifdef OMPI_COMM_TYPE_NODE
+            if(T == 4) {
+                MPI_Comm split;
+                MPI_Comm_split_type(node, OMPI_COMM_TYPE_SOCKET, rank, MPI_INFO_NULL, &split);
+                int sizes[2] = { 0, 1 };
+                MPI_Comm_size(node, sizes);
+                if(split != MPI_COMM_NULL)
+                    MPI_Comm_size(split, sizes + 1);
+                // unbound processes are alone in their socket, in which case nodes are used instead
+                int unbound = (sizes[0] > 1 && sizes[1] == 1);
+#if defined(__linux__)
+                // so are processes bound to distinct sockets, which, unlike unbound processes, do not share the same affinity mask
+                cpu_set_t mask[2];
+                if(sched_getaffinity(0, sizeof(cpu_set_t), mask) != 0)
+                    std::memset(mask, 0xFF, sizeof(cpu_set_t));
+                mask[1] = mask[0];
+                MPI_Allreduce(MPI_IN_PLACE, mask, sizeof(cpu_set_t) / sizeof(unsigned long), MPI_UNSIGNED_LONG, MPI_BAND, node);
+                MPI_Allreduce(MPI_IN_PLACE, mask + 1, sizeof(cpu_set_t) / sizeof(unsigned long), MPI_UNSIGNED_LONG, MPI_BOR, node);
+                unbound = unbound && CPU_EQUAL(mask, mask + 1);
+#endif
+                MPI_Allreduce(MPI_IN_PLACE, &unbound, 1, MPI_INT, MPI_MIN, node);
+                MPI_Allreduce(MPI_IN_PLACE, &unbound, 1, MPI_INT, MPI_MAX, in);
+                socket = !unbound;
+                if(socket) {
+                    MPI_Comm_free(&node);
+                    node = split;
+                }
+                else {
+                    if(split != MPI_COMM_NULL)
+                        MPI_Comm_free(&split);
+                    if(rank == 0)
+                        std::cout << "WARNING -- processes are not bound to sockets, master processes are selected among nodes" << std::endl;
+                }
+            }
+#endif
+            MPI_Comm_rank(node, &local);
+            MPI_Comm_free(&node);
+            int* leaders = new int[size];
+            local = (local == 0);
+            MPI_Allgather(&local, 1, MPI_INT, leaders, 1, MPI_INT, in);
+            int n = 0;
+            for(int i = 0; i < size; ++i)
+                if(leaders[i])
+                    leaders[n++] = i;
+            if(p > n) {
+                p = n;
+                if(rank == 0)
+                    std::cout << "WARNING -- the number of master processes was set to a value greater than the number of " << (socket ? "sockets" : "nodes") << ", the value has been reset to " << p << std::endl;
+            }
+            for(unsigned short i = 0; i < p; ++i)
+                pm[i] = leaders[(i * n) / p];
+            delete [] leaders;
+        }
         /* Function: splitCommunicator
          *
          *  If requested, splits a communicator into one made of master processes and another one made of slave processes.
@@ -50,7 +123,7 @@ class DMatrix {
          *    out            - Output communicator which may be left untouched.
          *    exclude        - True if the master processes have to be excluded from the original communicator.
          *    p              - Number of master processes.
-         *    T              - Master processes distribution topology. */
+         *    T              - Master processes distribution topology, see <DMatrix::nodeMasters> for topologies 3 and 4. */
         static bool splitCommunicator(const MPI_Comm& in, MPI_Comm& out, const bool& exclude, unsigned short& p, const unsigned short& T) {
             int size, rank;
             MPI_Comm_size(in, &size);
@@ -74,6 +147,8 @@ class DMatrix {
                     for(unsigned short i = 1; i < p; ++i)
                         pm[i] = static_cast<int>(size - std::sqrt(std::max(size * size - 2 * size * pm[i - 1] - 2 * area + pm[i - 1] * pm[i - 1], 1.0f)) + 0.5);
                 }
+                else if(T == 3 || T == 4)
+                    nodeMasters(in, p, T, pm);
                 else
                     for(unsigned short i = 0; i < p; ++i)
                         pm[i] = i * (size / p);
@@ -138,7 +213,7 @@ class DMatrix {
         /* Variable: rank
          *  Rank of the current master process in <Coarse operator::communicator>. */
         int                            _rank;
-#ifdef DMUMPS
+#if defined(DMUMPS) || defined(DSUITESPARSE) || defined(DLAPACK)
         /* Variable: distribution
          *  <Distribution> used for right-hand sides and solution vectors. */
         Distribution           _distribution;
@@ -372,7 +447,7 @@ class DMatrix {
             _mapRecv(), _mapSend(), _mapOwn(), _idistribution(),
 #endif
             _ldistribution(), _gatherCounts(), _gatherSplitCounts(), _displs(), _displsSplit(), _communicator(MPI_COMM_NULL), _n(), _rank()
-#ifdef DMUMPS
+#if defined(DMUMPS) || defined(DSUITESPARSE) || defined(DLAPACK)
                                                                                                                                            , _distribution()
 #endif
                                                                                                                                                              { }
@@ -24,6 +24,9 @@
 #define _HPDDM_INEXACT_COARSE_OPERATOR_
 
 namespace HPDDM {
+#if HPDDM_SCHWARZ
+template<template<class> class, template<class> class, char, class> class Schwarz;
+#endif
 template<template<class> class Solver, char S, class K>
 class InexactCoarseOperator : public OptionsPrefix, public Solver<K> {
     protected:
@@ -43,15 +46,41 @@ class InexactCoarseOperator : public OptionsPrefix, public Solver<K> {
         int               _off;
         int                _bs;
         MPI_Comm _communicator;
+#if HPDDM_SCHWARZ
+        /* Variable: schwarz
+         *  <Schwarz> preconditioner of the next level of a multilevel method, see <Inexact coarse operator::constructionLevel>. */
+        Schwarz<SUBDOMAIN, Solver, S, K>* _schwarz;
+        /* Variable: d
+         *  Boolean partition of unity of the next level. */
+        underlying_type<K>* _d;
+        /* Variable: w
+         *  Workspace array of the next level. */
+        mutable K*          _w;
+        mutable bool   _allocate;
+#endif
         unsigned short     _mu;
         template<char T>
         void numfact(unsigned int nrow, int* I, int* loc2glob, int* J, K* C, unsigned short* neighbors) {
             _da = C;
             _dj = J;
+            if(!OptionsPrefix::_prefix)
+                OptionsPrefix::setPrefix("master_");
             MPI_Comm_dup(DMatrix::_communicator, &_communicator);
             MPI_Comm_size(_communicator, &_off);
             if(_off > 1) {
                 unsigned int accumulate = 0;
+                Option& opt = *Option::get();
+#if HPDDM_SCHWARZ
+                const std::string level = nextLevel();
+                const bool schwarz = opt.template val<char>(OptionsPrefix::prefix("krylov_method"), HPDDM_KRYLOV_METHOD_GMRES) != HPDDM_KRYLOV_METHOD_NONE && opt.set(level + "schwarz_method") && opt.template val<char>(level + "schwarz_method") != HPDDM_SCHWARZ_METHOD_NONE;
+                if(schwarz) {
+                    if(_mu < _off)
+                        delete [] _di;
+                    MPI_Comm_free(&_communicator);
+                    _communicator = DMatrix::_communicator;
+                }
+                else
+#endif
                 {
                     int* ia = nullptr;
                     K* a;
@@ -190,9 +219,8 @@ class InexactCoarseOperator : public OptionsPrefix, public Solver<K> {
                     I[i + 1] += I[i] - (_di[i + 1] - _di[i]);
                 }
                 delete [] neighbors;
-                Option& opt = *Option::get();
                 _dof = on.size();
-                if(opt.template val<char>("master_krylov_method", HPDDM_KRYLOV_METHOD_GMRES) != HPDDM_KRYLOV_METHOD_NONE) {
+                if(opt.template val<char>(OptionsPrefix::prefix("krylov_method"), HPDDM_KRYLOV_METHOD_GMRES) != HPDDM_KRYLOV_METHOD_NONE) {
                     accumulate = 0;
                     if(range.size() > 1) {
                         range.emplace_back(J + I[nrow] + _di[nrow] - (Solver<K>::_numbering == 'F' ? 2 : 0));
@@ -329,8 +357,17 @@ class InexactCoarseOperator : public OptionsPrefix, public Solver<K> {
                     _oa = C + (_di[nrow] - (Solver<K>::_numbering == 'F')) * _bs * _bs;
                     _oj = J + _di[nrow] - (Solver<K>::_numbering == 'F');
                     _off = off.size();
+#if HPDDM_SCHWARZ
+                    if(schwarz) {
+                        std::vector<int> ghosts;
+                        ghosts.reserve(_off);
+                        for(const std::pair<const int, unsigned short>& i : off)
+                            ghosts.emplace_back(i.first - (Solver<K>::_numbering == 'F'));
+                        constructionLevel(level, loc2glob[0] - (Solver<K>::_numbering == 'F'), ghosts);
+                    }
+#endif
                     if(DMatrix::_rank != 0)
-                        opt.remove("master_verbosity");
+                        opt.remove(OptionsPrefix::prefix("verbosity"));
                 }
                 else {
                     delete [] _di;
@@ -359,11 +396,258 @@ class InexactCoarseOperator : public OptionsPrefix, public Solver<K> {
 #endif
             }
             _mu = 0;
-            OptionsPrefix::setPrefix("master_");
         }
+#if HPDDM_SCHWARZ
+        /* Function: nextLevel
+         *  Returns the prefix of the options of the next level of a multilevel method, e.g., level_2_ for the coarse operator of prefix master_, or level_3_ for the coarse operator of prefix level_2_master_. */
+        std::string nextLevel() const {
+            std::string level = OptionsPrefix::prefix();
+            level.erase(level.size() - std::min(level.size(), std::string("master_").size()));
+            const std::string::size_type pos = level.rfind("level_");
+            if(pos != std::string::npos && level.size() > pos + 7 && level.back() == '_' && std::all_of(level.cbegin() + pos + 6, level.cend() - 1, [](const char c) { return std::isdigit(c); }))
+                return level.substr(0, pos) + "level_" + to_string(std::stoi(level.substr(pos + 6)) + 1) + "_";
+            return level + "level_2_";
+        }
+        /* Function: constructionLevel
+         *
+         *  Builds a <Schwarz> preconditioner of the distributed coarse operator, used as the next level of a multilevel method. The subdomain of each process is made of its rows and of the rows of its ghost unknowns, and the partition of unity is Boolean, so that only restricted Schwarz methods may be used. The next level may in turn be deflated, with a coarse operator of its own.
+         *
+         * Parameters:
+         *    prefix         - Prefix of the options of the next level.
+         *    first          - Global index of the first row of the current process.
+         *    ghosts         - Global indices of the ghost unknowns. */
+        void constructionLevel(const std::string& prefix, const int first, const std::vector<int>& ghosts) {
+            constexpr int F = (Solver<K>::_numbering == 'F');
+            const int bs2 = _bs * _bs;
+            std::vector<std::vector<std::pair<int, const K*>>> rows(_dof);
+            std::map<int, unsigned short> owner;
+            for(const std::pair<unsigned short, std::vector<int>>& p : _recv)
+                for(const int& j : p.second)
+                    owner.emplace(ghosts[j], p.first);
+            std::vector<K> transpose(S == 'S' ? (_di[_dof] - _di[0]) * bs2 : 0);
+            std::vector<std::vector<K>> values;
+            std::vector<std::vector<int>> indices;
+            K* t = transpose.data();
+            for(int i = 0; i < _dof; ++i) {
+                for(int j = _di[i] - F; j < _di[i + 1] - F; ++j) {
+                    const int col = _dj[j] - F;
+                    rows[i].emplace_back(first + col, _da + j * bs2);
+                    if(S == 'S' && col != i) {
+                        for(int r = 0; r < _bs; ++r)
+                            for(int c = 0; c < _bs; ++c)
+                                t[r + c * _bs] = _da[j * bs2 + c + r * _bs];
+                        rows[col].emplace_back(first + i, t);
+                        t += bs2;
+                    }
+                }
+                for(int j = _oi[i] - F; j < _oi[i + 1] - F; ++j)
+                    rows[i].emplace_back(ghosts[_oj[j] - F], _oa + j * bs2);
+            }
+            if(S == 'S') {
+                std::vector<unsigned short> where(_off);
+                for(unsigned short i = 0; i < _recv.size(); ++i)
+                    for(const int& j : _recv[i].second)
+                        where[j] = i;
+                values.resize(_recv.size() + _send.size());
+                indices.resize(_recv.size() + _send.size());
+                for(int i = 0; i < _dof; ++i)
+                    for(int j = _oi[i] - F; j < _oi[i + 1] - F; ++j) {
+                        const unsigned short k = where[_oj[j] - F];
+                        indices[k].emplace_back(ghosts[_oj[j] - F]);
+                        indices[k].emplace_back(first + i);
+                        for(int r = 0; r < _bs; ++r)
+                            for(int c = 0; c < _bs; ++c)
+                                values[k].emplace_back(_oa[j * bs2 + c + r * _bs]);
+                    }
+                MPI_Request* rq = new MPI_Request[2 * (_recv.size() + _send.size())];
+                unsigned int* sizes = new unsigned int[_recv.size() + _send.size()];
+                unsigned short i = 0;
+                for(const std::pair<unsigned short, std::vector<int>>& p : _send) {
+                    MPI_Irecv(sizes + _recv.size() + i, 1, MPI_UNSIGNED, p.first, 13, _communicator, rq + i);
+                    ++i;
+                }
+                for(i = 0; i < _recv.size(); ++i) {
+                    sizes[i] = indices[i].size() / 2;
+                    MPI_Isend(sizes + i, 1, MPI_UNSIGNED, _recv[i].first, 13, _communicator, rq + _send.size() + i);
+                }
+                MPI_Waitall(_recv.size() + _send.size(), rq, MPI_STATUSES_IGNORE);
+                i = 0;
+                for(const std::pair<unsigned short, std::vector<int>>& p : _send) {
+                    const unsigned short k = _recv.size() + i;
+                    indices[k].resize(2 * sizes[k]);
+                    values[k].resize(bs2 * sizes[k]);
+                    MPI_Irecv(indices[k].data(), indices[k].size(), MPI_INT, p.first, 14, _communicator, rq + 2 * i);
+                    MPI_Irecv(values[k].data(), values[k].size(), Wrapper<K>::mpi_type(), p.first, 15, _communicator, rq + 2 * i + 1);
+                    ++i;
+                }
+                for(i = 0; i < _recv.size(); ++i) {
+                    MPI_Isend(indices[i].data(), indices[i].size(), MPI_INT, _recv[i].first, 14, _communicator, rq + 2 * (_send.size() + i));
+                    MPI_Isend(values[i].data(), values[i].size(), Wrapper<K>::mpi_type(), _recv[i].first, 15, _communicator, rq + 2 * (_send.size() + i) + 1);
+                }
+                MPI_Waitall(2 * (_recv.size() + _send.size()), rq, MPI_STATUSES_IGNORE);
+                i = 0;
+                for(const std::pair<unsigned short, std::vector<int>>& p : _send) {
+                    const unsigned short k = _recv.size() + i++;
+                    for(unsigned int j = 0; j < sizes[k]; ++j) {
+                        rows[indices[k][2 * j] - first].emplace_back(indices[k][2 * j + 1], values[k].data() + j * bs2);
+                        owner.emplace(indices[k][2 * j + 1], p.first);
+                    }
+                }
+                delete [] sizes;
+                delete [] rq;
+            }
+            std::vector<unsigned short> o;
+            for(const std::pair<const int, unsigned short>& p : owner)
+                o.emplace_back(p.second);
+            std::sort(o.begin(), o.end());
+            o.erase(std::unique(o.begin(), o.end()), o.end());
+            std::vector<std::vector<int>> overlap(o.size());
+            for(int i = 0; i < _dof; ++i)
+                for(const std::pair<int, const K*>& p : rows[i]) {
+                    if(p.first < first || p.first >= first + _dof) {
+                        std::vector<int>& v = overlap[std::distance(o.cbegin(), std::lower_bound(o.cbegin(), o.cend(), owner[p.first]))];
+                        if(v.empty() || v.back() != i)
+                            v.emplace_back(i);
+                    }
+                }
+            MPI_Request* rq = new MPI_Request[4 * o.size()];
+            unsigned int* sizes = new unsigned int[4 * o.size()];
+            std::vector<std::vector<int>> sendIdx(o.size()), recvIdx(o.size());
+            std::vector<std::vector<K>> sendVal(o.size()), recvVal(o.size());
+            for(unsigned short k = 0; k < o.size(); ++k) {
+                MPI_Irecv(sizes + 2 * (o.size() + k), 2, MPI_UNSIGNED, o[k], 16, _communicator, rq + k);
+                for(const int& i : overlap[k]) {
+                    sendIdx[k].emplace_back(first + i);
+                    sendIdx[k].emplace_back(rows[i].size());
+                    for(const std::pair<int, const K*>& p : rows[i]) {
+                        sendIdx[k].emplace_back(p.first);
+                        sendVal[k].insert(sendVal[k].end(), p.second, p.second + bs2);
+                    }
+                }
+                sizes[2 * k] = sendIdx[k].size();
+                sizes[2 * k + 1] = sendVal[k].size();
+                MPI_Isend(sizes + 2 * k, 2, MPI_UNSIGNED, o[k], 16, _communicator, rq + o.size() + k);
+            }
+            MPI_Waitall(2 * o.size(), rq, MPI_STATUSES_IGNORE);
+            for(unsigned short k = 0; k < o.size(); ++k) {
+                recvIdx[k].resize(sizes[2 * (o.size() + k)]);
+                recvVal[k].resize(sizes[2 * (o.size() + k) + 1]);
+                MPI_Irecv(recvIdx[k].data(), recvIdx[k].size(), MPI_INT, o[k], 17, _communicator, rq + 2 * k);
+                MPI_Irecv(recvVal[k].data(), recvVal[k].size(), Wrapper<K>::mpi_type(), o[k], 18, _communicator, rq + 2 * k + 1);
+                MPI_Isend(sendIdx[k].data(), sendIdx[k].size(), MPI_INT, o[k], 17, _communicator, rq + 2 * (o.size() + k));
+                MPI_Isend(sendVal[k].data(), sendVal[k].size(), Wrapper<K>::mpi_type(), o[k], 18, _communicator, rq + 2 * (o.size() + k) + 1);
+            }
+            MPI_Waitall(4 * o.size(), rq, MPI_STATUSES_IGNORE);
+            delete [] sizes;
+            delete [] rq;
+            std::unordered_map<int, int> g2l;
+            g2l.reserve(owner.size());
+            for(const std::pair<const int, unsigned short>& p : owner)
+                g2l.emplace(p.first, _dof + g2l.size());
+            rows.resize(_dof + owner.size());
+            for(unsigned short k = 0; k < o.size(); ++k) {
+                const K* v = recvVal[k].data();
+                for(unsigned int j = 0; j < recvIdx[k].size(); j += 2 + recvIdx[k][j + 1]) {
+                    std::vector<std::pair<int, const K*>>& row = rows[g2l[recvIdx[k][j]]];
+                    for(int l = 0; l < recvIdx[k][j + 1]; ++l, v += bs2) {
+                        const int col = recvIdx[k][j + 2 + l];
+                        if((col >= first && col < first + _dof) || g2l.count(col))
+                            row.emplace_back(col, v);
+                    }
+                }
+            }
+            const int n = rows.size() * _bs;
+            unsigned int nnz = 0;
+            for(const std::vector<std::pair<int, const K*>>& row : rows)
+                nnz += row.size() * bs2;
+            MatrixCSR<K>* A = new MatrixCSR<K>(n, n, nnz, false);
+            A->_ia[0] = (HPDDM_NUMBERING == 'F');
+            nnz = 0;
+            for(unsigned int i = 0; i < rows.size(); ++i) {
+                for(std::pair<int, const K*>& p : rows[i])
+                    p.first = (p.first >= first && p.first < first + _dof ? p.first - first : g2l[p.first]);
+                std::sort(rows[i].begin(), rows[i].end(), [](const std::pair<int, const K*>& lhs, const std::pair<int, const K*>& rhs) { return lhs.first < rhs.first; });
+                for(int r = 0; r < _bs; ++r) {
+                    for(const std::pair<int, const K*>& p : rows[i])
+                        for(int c = 0; c < _bs; ++c) {
+                            A->_ja[nnz] = p.first * _bs + c + (HPDDM_NUMBERING == 'F');
+                            A->_a[nnz++] = p.second[r + c * _bs];
+                        }
+                    A->_ia[i * _bs + r + 1] = nnz + (HPDDM_NUMBERING == 'F');
+                }
+            }
+            std::vector<std::vector<std::pair<int, const K*>>>().swap(rows);
+            std::vector<std::vector<int>> mapping(o.size());
+            for(unsigned short k = 0; k < o.size(); ++k) {
+                std::vector<int> shared;
+                shared.reserve(overlap[k].size());
+                for(const int& i : overlap[k])
+                    shared.emplace_back(first + i);
+                for(const std::pair<const int, unsigned short>& p : owner)
+                    if(p.second == o[k])
+                        shared.emplace_back(p.first);
+                std::sort(shared.begin(), shared.end());
+                mapping[k].reserve(shared.size() * _bs);
+                for(const int& j : shared) {
+                    const int l = (j >= first && j < first + _dof ? j - first : g2l[j]);
+                    for(int c = 0; c < _bs; ++c)
+                        mapping[k].emplace_back(l * _bs + c);
+                }
+            }
+            _schwarz = new Schwarz<SUBDOMAIN, Solver, S, K>;
+            _schwarz->setPrefix(prefix);
+            _schwarz->Subdomain<K>::initialize(A, o, mapping, &_communicator);
+            _d = new underlying_type<K>[n]();
+            std::fill_n(_d, _dof * _bs, underlying_type<K>(1.0));
+            _schwarz->initialize(_d);
+            Option& opt = *Option::get();
+            const char method = opt.val<char>(prefix + "schwarz_method");
+            if(method == HPDDM_SCHWARZ_METHOD_SORAS || method == HPDDM_SCHWARZ_METHOD_ASM) {
+                opt[prefix + "schwarz_method"] = HPDDM_SCHWARZ_METHOD_RAS;
+                if(DMatrix::_rank == 0)
+                    std::cout << "WARNING -- only restricted Schwarz methods may be used on coarse levels, " << prefix << "schwarz_method has been reset to ras" << std::endl;
+            }
+            if(opt.set(prefix + "schwarz_coarse_correction")) {
+                unsigned short nu = _bs;
+#ifdef EIGENSOLVER
+                if(opt.val<unsigned short>(prefix + "geneo_nu", 0) > 0 || opt.set(prefix + "geneo_threshold")) {
+                    MatrixCSR<K>* B = new MatrixCSR<K>(n, n, A->_nnz, false);
+                    std::copy_n(A->_ia, n + 1, B->_ia);
+                    std::copy_n(A->_ja, A->_nnz, B->_ja);
+                    std::copy_n(A->_a, A->_nnz, B->_a);
+                    _schwarz->template solveGEVP<EIGENSOLVER>(B);
+                    delete B;
+                    nu = opt.val<unsigned short>(prefix + "geneo_nu");
+                }
+                else
+#endif
+                {
+                    K** ev = new K*[nu];
+                    *ev = new K[nu * n]();
+                    for(unsigned short i = 0; i < nu; ++i) {
+                        ev[i] = *ev + i * n;
+                        for(int j = i; j < n; j += _bs)
+                            ev[i][j] = K(1.0);
+                    }
+                    _schwarz->setVectors(ev);
+                }
+                static_cast<typename Schwarz<SUBDOMAIN, Solver, S, K>::super&>(*_schwarz).initialize(nu);
+                _schwarz->buildTwo(_communicator);
+            }
+            _schwarz->callNumfact();
+        }
+#endif
     public:
-        InexactCoarseOperator() : OptionsPrefix(), Solver<K>(), _buff(), _x(), _di(), _oi(), _rq(), _off(), _communicator(MPI_COMM_NULL), _mu() { }
+        InexactCoarseOperator() : OptionsPrefix(), Solver<K>(), _buff(), _x(), _di(), _oi(), _rq(), _off(), _communicator(MPI_COMM_NULL),
+#if HPDDM_SCHWARZ
+                                  _schwarz(), _d(), _w(), _allocate(),
+#endif
+                                  _mu() { }
         ~InexactCoarseOperator() {
+#if HPDDM_SCHWARZ
+            delete _schwarz;
+            delete [] _d;
+#endif
             if(_buff) {
                 delete [] *_buff;
                 delete [] _buff;
@@ -403,7 +687,7 @@ class InexactCoarseOperator : public OptionsPrefix, public Solver<K> {
                 _x = new K[n * _dof * _bs]();
                 _mu = n;
             }
-            if(Option::get()->template val<char>("master_krylov_method", HPDDM_KRYLOV_METHOD_GMRES) != HPDDM_KRYLOV_METHOD_NONE)
+            if(_oi && Option::get()->template val<char>(OptionsPrefix::prefix("krylov_method"), HPDDM_KRYLOV_METHOD_GMRES) != HPDDM_KRYLOV_METHOD_NONE)
                 IterativeMethod::template solve<false>(*this, rhs, _x, n, _communicator);
             else
                 Solver<K>::solve(rhs, _x, n);
@@ -422,6 +706,18 @@ class InexactCoarseOperator : public OptionsPrefix, public Solver<K> {
         }
         template<bool>
         void apply(const K* const in, K* const out, const unsigned short& mu = 1, K* = nullptr) const {
+#if HPDDM_SCHWARZ
+            if(_schwarz) {
+                const int n = _schwarz->getDof();
+                for(unsigned short nu = 0; nu < mu; ++nu)
+                    std::copy_n(in + nu * _dof * _bs, _dof * _bs, _w + nu * n);
+                _schwarz->scaledExchange(_w, mu);
+                _schwarz->apply(_w, _w + mu * n, mu);
+                for(unsigned short nu = 0; nu < mu; ++nu)
+                    std::copy_n(_w + (mu + nu) * n, _dof * _bs, out + nu * _dof * _bs);
+                return;
+            }
+#endif
 #ifdef DMUMPS
             if(DMatrix::_n)
 #endif
@@ -429,12 +725,18 @@ class InexactCoarseOperator : public OptionsPrefix, public Solver<K> {
         }
         template<bool = false>
         bool start(const K* const, K* const, const unsigned short& mu = 1) const {
+#if HPDDM_SCHWARZ
+            if(_schwarz) {
+                const int n = _schwarz->getDof();
+                _w = new K[2 * mu * n]();
+                _allocate = _schwarz->start(_w, _w + mu * n, mu);
+            }
+#endif
             if(_off) {
                 unsigned short k = 1;
-                const std::string prefix = OptionsPrefix::prefix();
-                const Option& opt = *Option::get();
-                if(opt.any_of(prefix + "krylov_method", { HPDDM_KRYLOV_METHOD_GCRODR, HPDDM_KRYLOV_METHOD_BGCRODR }) && !opt.val<unsigned short>(prefix + "recycle_same_system"))
-                    k = std::max(opt.val<int>(prefix + "recycle", 1), 1);
+                const Option::Snapshot& snapshot = OptionsPrefix::snapshot();
+                if((snapshot.krylov_method == HPDDM_KRYLOV_METHOD_GCRODR || snapshot.krylov_method == HPDDM_KRYLOV_METHOD_BGCRODR) && !snapshot.recycle_same_system)
+                    k = std::max(snapshot.recycle, 1);
                 _o = new K[mu * k * _off * _bs]();
                 return true;
             }
@@ -442,6 +744,13 @@ class InexactCoarseOperator : public OptionsPrefix, public Solver<K> {
                 return false;
         }
         void end(const bool free) const {
+#if HPDDM_SCHWARZ
+            if(_schwarz) {
+                _schwarz->end(_allocate);
+                delete [] _w;
+                _w = nullptr;
+            }
+#endif
             if(free)
                 delete [] _o;
         }
@@ -25,6 +25,8 @@
 #ifndef _HPDDM_ITERATIVE_
 #define _HPDDM_ITERATIVE_
 
+#include "telemetry.hpp"
+
 namespace HPDDM {
 template<class K>
 struct EmptyOperator : OptionsPrefix {
@@ -46,15 +48,142 @@ template<class K>
 struct CustomOperator<MatrixCSR<K>, K> : EmptyOperator<K> {
     const MatrixCSR<K>* const _A;
     CustomOperator(const MatrixCSR<K>* const A) : EmptyOperator<K>(A ? A->_n : 0), _A(A) { }
+    const MatrixCSR<K>* getMatrix() const { return _A; }
     void GMV(const K* const in, K* const out, const int& mu = 1) const {
+        const Telemetry::Scope scope(Telemetry::SPMV);
+        HPDDM_TRACE_SCOPE("GMV");
         Wrapper<K>::csrmm(_A->_sym, &(EmptyOperator<K>::_n), &mu, _A->_a, _A->_ia, _A->_ja, in, out);
     }
 };
 
+/* Class: Workspace
+ *
+ *  A class to keep the work arrays of iterative methods allocated between subsequent solves, one arena per prefix.
+ *  Each arena is made of slots: 0 for the main work array of Krylov methods, 1 for auxiliary arrays, 2 for the buffers of <Subdomain::exchange>.
+ *
+ * Template Parameter:
+ *    K              - Scalar type. */
+template<class K>
+class Workspace : private Singleton {
+    private:
+        std::unordered_map<std::string, std::vector<std::pair<K*, std::size_t>>> _storage;
+    public:
+        template<int N>
+        Workspace(Singleton::construct_key<N>) { }
+        ~Workspace() {
+            for(std::pair<const std::string, std::vector<std::pair<K*, std::size_t>>>& p : _storage)
+                for(std::pair<K*, std::size_t>& s : p.second)
+                    delete [] s.first;
+            _storage.clear();
+        }
+        /* Function: destroy
+         *  Releases all the slots of an arena. */
+        void destroy(const std::string& key = "") {
+            typename std::unordered_map<std::string, std::vector<std::pair<K*, std::size_t>>>::iterator it = _storage.find(key);
+            if(it != _storage.end()) {
+                for(std::pair<K*, std::size_t>& s : it->second)
+                    delete [] s.first;
+                _storage.erase(it);
+            }
+        }
+        /* Function: allocate
+         *
+         *  Returns an array of at least size elements. If the option reuse_workspace is not set for the given prefix, a new array is allocated, otherwise the slot of the arena is (re)used and only grows.
+         *
+         * Parameters:
+         *    size           - Number of elements.
+         *    key            - Prefix of the arena.
+         *    slot           - Slot of the arena. */
+        K* allocate(std::size_t size, const std::string& key = "", unsigned short slot = 0) {
+            if(!Option::get()->snapshot(key).reuse_workspace)
+                return new K[size];
+            std::vector<std::pair<K*, std::size_t>>& arena = _storage[key];
+            if(arena.size() <= slot)
+                arena.resize(slot + 1, std::make_pair(nullptr, 0));
+            if(arena[slot].second < size || !arena[slot].first) {
+                delete [] arena[slot].first;
+                arena[slot] = std::make_pair(new K[size], size);
+            }
+            return arena[slot].first;
+        }
+        /* Function: deallocate
+         *  Frees an array returned by <Workspace::allocate>, unless it belongs to the arena. */
+        void deallocate(K* const pt, const std::string& key = "", unsigned short slot = 0) {
+            typename std::unordered_map<std::string, std::vector<std::pair<K*, std::size_t>>>::const_iterator it = _storage.find(key);
+            if(it == _storage.cend() || it->second.size() <= slot || it->second[slot].first != pt)
+                delete [] pt;
+        }
+        /* Function: size
+         *  Returns the number of elements kept by an arena. */
+        std::size_t size(const std::string& key = "") const {
+            typename std::unordered_map<std::string, std::vector<std::pair<K*, std::size_t>>>::const_iterator it = _storage.find(key);
+            std::size_t size = 0;
+            if(it != _storage.cend())
+                for(const std::pair<K*, std::size_t>& s : it->second)
+                    size += s.second;
+            return size;
+        }
+        template<int N = 0>
+        static std::shared_ptr<Workspace> get() {
+            return Singleton::get<Workspace, N>();
+        }
+};
+
+/* Class: Spectrum
+ *
+ *  A class to keep the estimates of the extreme eigenvalues of preconditioned operators between subsequent solves, one pair per prefix, see <Iterative method::Chebyshev>.
+ *  Estimates of a <Schwarz> preconditioner are discarded each time its local matrices are factorized or its coarse operator is assembled. For other operators, <Spectrum::destroy> should be called when the operator or the preconditioner of a prefix is modified.
+ *
+ * Template Parameter:
+ *    K              - Real scalar type. */
+template<class K>
+class Spectrum : private Singleton {
+    private:
+        std::unordered_map<std::string, std::pair<K, K>> _storage;
+    public:
+        template<int N>
+        Spectrum(Singleton::construct_key<N>) { }
+        /* Function: destroy
+         *  Discards the estimates of a prefix. */
+        void destroy(const std::string& key = "") {
+            _storage.erase(key);
+        }
+        /* Function: bounds
+         *  Returns a pointer to the lower and upper bounds of a prefix, or nullptr if they have not been estimated yet. */
+        const std::pair<K, K>* bounds(const std::string& key = "") const {
+            typename std::unordered_map<std::string, std::pair<K, K>>::const_iterator it = _storage.find(key);
+            return it != _storage.cend() ? &(it->second) : nullptr;
+        }
+        /* Function: set
+         *  Stores the lower and upper bounds of a prefix. */
+        const std::pair<K, K>* set(const K lower, const K upper, const std::string& key = "") {
+            std::pair<K, K>& p = _storage[key];
+            p = std::make_pair(lower, upper);
+            return &p;
+        }
+        template<int N = 0>
+        static std::shared_ptr<Spectrum> get() {
+            return Singleton::get<Spectrum, N>();
+        }
+};
+
 /* Class: Iterative method
  *  A class that implements various iterative methods. */
 class IterativeMethod {
     private:
+        template<class> friend class Recycling;
+#if HPDDM_MPI
+        /* Function: allreduce
+         *  Calls MPI_Allreduce, and accounts for it in the <Telemetry> of the solve being recorded, if any. */
+        static int allreduce(const void* const in, void* const out, const int count, const MPI_Datatype& type, const MPI_Op& op, const MPI_Comm& comm) {
+            const Telemetry::Scope scope(Telemetry::REDUCTION);
+            HPDDM_TRACE_SCOPE("allreduce");
+            int size;
+            MPI_Type_size(type, &size);
+            scope.reduction(static_cast<unsigned long long>(count) * size);
+            return MPI_Allreduce(in, out, count, type, op, comm);
+        }
+#endif
         /* Function: outputResidual
          *  Prints information about the residual at a given iteration. */
         template<char T, class K>
@@ -62,8 +191,9 @@ class IterativeMethod {
             for(unsigned short nu = 0; nu < mu; ++nu)
                 if(conv[nu] == -sentinel && ((tol > 0.0 && std::abs(res[nu]) / norm[nu] <= tol) || (tol < 0.0 && std::abs(res[nu]) <= -tol)))
                     conv[nu] = i;
-            if(verbosity > 2) {
-                constexpr auto method = (T == 2 ? "CG" : (T == 4 ? "GCRODR" : "GMRES"));
+            const std::shared_ptr<Telemetry> telemetry = Telemetry::get();
+            if(verbosity > 2 || telemetry->recording()) {
+                constexpr auto method = (T == 2 ? "CG" : (T == 4 ? "GCRODR" : (T == 9 ? "GMRES-DR" : (T == 10 ? "IDR" : (T == 11 ? "BiCGStab" : "GMRES")))));
                 unsigned short tmp[2] { 0, 0 };
                 underlying_type<K> beta = std::abs(res[0]);
                 for(unsigned short nu = 0; nu < mu; ++nu) {
@@ -74,6 +204,9 @@ class IterativeMethod {
                         tmp[1] = nu;
                     }
                 }
+                telemetry->sample(j, beta, beta / norm[tmp[1]]);
+                if(verbosity < 3)
+                    return;
                 if(tol > 0.0)
                     std::cout << method << ": " << std::setw(3) << j << " " << beta << " " << norm[tmp[1]] << " " << beta / norm[tmp[1]] << " < " << tol;
                 else
@@ -117,7 +250,8 @@ class IterativeMethod {
                 if(((tol > 0.0 && *pt / *norm <= tol) || (tol < 0.0 && *pt <= -tol)))
                     ++conv;
             }
-            if(verbosity > 2) {
+            const std::shared_ptr<Telemetry> telemetry = Telemetry::get();
+            if(verbosity > 2 || telemetry->recording()) {
                 constexpr auto method = (T == 3 ? "BCG" : (T == 5 ? "BGCRODR" : (T == 6 ? "BFBCG" : "BGMRES")));
                 underlying_type<K>* max;
                 if(tol > 0.0) {
@@ -127,12 +261,18 @@ class IterativeMethod {
                             j = k;
                     }
                     max = pt + j;
-                    std::cout << method << ": " << std::setw(3) << i << " " << *max << " " <<  norm[j] << " " <<  *max / norm[j] << " < " << tol;
+                    telemetry->sample(i, *max, *max / norm[j]);
+                    if(verbosity > 2)
+                        std::cout << method << ": " << std::setw(3) << i << " " << *max << " " <<  norm[j] << " " <<  *max / norm[j] << " < " << tol;
                 }
                 else {
                     max = std::max_element(pt, pt + d / t);
-                    std::cout << method << ": " << std::setw(3) << i << " " << *max << " < " << -tol;
+                    telemetry->sample(i, *max, *max / norm[std::distance(pt, max)]);
+                    if(verbosity > 2)
+                        std::cout << method << ": " << std::setw(3) << i << " " << *max << " < " << -tol;
                 }
+                if(verbosity < 3)
+                    return t * conv;
                 if(d != t || (d == t && t != mu)) {
                     std::cout << " (rhs #" << std::distance(pt, max) + 1;
                     if(conv > d)
@@ -148,7 +288,7 @@ class IterativeMethod {
         template<char T>
         static void convergence(const char verbosity, const unsigned short i, const unsigned short m) {
             if(verbosity) {
-                constexpr auto method = (T == 1 ? "BGMRES" : (T == 2 ? "CG" : (T == 3 ? "BCG" : (T == 4 ? "GCRODR" : (T == 5 ? "BGCRODR" : (T == 6 ? "BFBCG" : (T == 7 ? "PCG" : "GMRES")))))));
+                constexpr auto method = (T == 1 ? "BGMRES" : (T == 2 ? "CG" : (T == 3 ? "BCG" : (T == 4 ? "GCRODR" : (T == 5 ? "BGCRODR" : (T == 6 ? "BFBCG" : (T == 7 ? "PCG" : (T == 9 ? "GMRES-DR" : (T == 10 ? "IDR" : (T == 11 ? "BiCGStab" : "GMRES"))))))))));
                 if(i != m + 1)
                     std::cout << method << " converges after " << i << " iteration" << (i > 1 ? "s" : "") << std::endl;
                 else
@@ -156,31 +296,40 @@ class IterativeMethod {
             }
         }
         template<char T, class K>
-        static void options(const std::string& prefix, K* const d, int* const i, unsigned short* const m, char* const id) {
-            const Option& opt = *Option::get();
-            m[0] = std::min(opt.val<short>(prefix + "max_it", 100), std::numeric_limits<short>::max());
+        static void options(const Option::Snapshot& opt, K* const d, int* const i, unsigned short* const m, char* const id) {
+            m[0] = opt.max_it;
             if(T == 7) {
-                d[0] =  opt.val(prefix + "richardson_damping_factor", 1.0);
+                d[0] = opt.richardson_damping_factor;
+                if(i) {
+                    *i = opt.richardson_chebyshev;
+                    id[0] = opt.verbosity;
+                }
                 return;
             }
-            d[0] = opt.val(prefix + "tol", 1.0e-6);
-            id[0] = opt.val<char>(prefix + "verbosity", 0);
+            d[0] = opt.tol;
+            id[0] = opt.verbosity;
             if(T == 1 || T == 5 || T == 6) {
-                d[1] = opt.val(prefix + "deflation_tol", -1.0);
-                m[1 + (T != 6)] = opt.val<unsigned short>(prefix + "enlarge_krylov_subspace", 1);
+                d[1] = opt.deflation_tol;
+                m[1 + (T != 6)] = std::max(opt.enlarge_krylov_subspace, static_cast<unsigned short>(1));
             }
-            if(T == 0 || T == 1 || T == 4 || T == 5) {
-                id[2] = opt.val<char>(prefix + "orthogonalization", HPDDM_ORTHOGONALIZATION_CGS) + (opt.val<char>(prefix + "qr", HPDDM_QR_CHOLQR) << 2);
-                m[1] = std::min(static_cast<unsigned short>(std::numeric_limits<short>::max()), std::min(opt.val<unsigned short>(prefix + "gmres_restart", 40), m[0]));
+            if(T == 0 || T == 1 || T == 4 || T == 5 || T == 9) {
+                id[2] = opt.orthogonalization + (opt.qr << 2);
+                m[1] = std::min(static_cast<unsigned short>(std::numeric_limits<short>::max()), std::min(opt.gmres_restart, m[0]));
             }
-            if(T == 0 || T == 1 || T == 2 || T == 4 || T == 5)
-                id[1] = opt.val<char>(prefix + "variant", HPDDM_VARIANT_RIGHT);
+            if(T == 0)
+                id[3] = opt.gmres_basis_precision;
+            if(T == 10 || T == 11)
+                m[1] = std::max(static_cast<unsigned short>(1), T == 10 ? opt.idr_s : opt.bicgstab_l);
+            if(T == 0 || T == 1 || T == 2 || T == 4 || T == 5 || T == 9 || T == 10 || T == 11)
+                id[1] = opt.variant;
             if(T == 3 || T == 6)
-                id[1] = opt.val<char>(prefix + "qr", HPDDM_QR_CHOLQR);
+                id[1] = opt.qr;
+            if(T == 4 || T == 5 || T == 9) {
+                *i = std::min(m[1] - 1, opt.recycle);
+                id[3] = opt.recycle_target;
+            }
             if(T == 4 || T == 5) {
-                *i = std::min(m[1] - 1, opt.val<int>(prefix + "recycle", 0));
-                id[3] = opt.val<char>(prefix + "recycle_target", HPDDM_RECYCLE_TARGET_SM);
-                id[4] = opt.val<char>(prefix + "recycle_strategy", HPDDM_RECYCLE_STRATEGY_A) + 4 * (std::min(opt.val<unsigned short>(prefix + "recycle_same_system"), static_cast<unsigned short>(2)));
+                id[4] = opt.recycle_strategy + 4 * (std::min(opt.recycle_same_system, static_cast<unsigned short>(2)));
             }
             if(std::abs(d[0]) < std::numeric_limits<underlying_type<K>>::epsilon()) {
                 if(id[0])
@@ -195,27 +344,48 @@ class IterativeMethod {
         /* Function: allocate
          *  Allocates workspace arrays for <Iterative method::CG>. */
         template<class K, typename std::enable_if<!Wrapper<K>::is_complex>::type* = nullptr>
-        static void allocate(K*& dir, K*& p, const int& n, const unsigned short extra = 0, const unsigned short it = 1, const unsigned short mu = 1) {
+        static void allocate(const std::string& prefix, K*& dir, K*& p, const int& n, const unsigned short extra = 0, const unsigned short it = 1, const unsigned short mu = 1) {
             if(extra == 0) {
-                dir = new K[(3 + std::max(1, 4 * n)) * mu];
+                dir = Workspace<K>::get()->allocate((3 + std::max(1, 4 * n)) * mu, prefix);
                 p = dir + 3 * mu;
             }
             else {
-                dir = new K[(2 + 2 * it + std::max(1, (4 + extra * it) * n)) * mu];
+                dir = Workspace<K>::get()->allocate((2 + 2 * it + std::max(1, (4 + extra * it) * n)) * mu, prefix);
                 p = dir + (2 + 2 * it) * mu;
             }
         }
         template<class K, typename std::enable_if<Wrapper<K>::is_complex>::type* = nullptr>
-        static void allocate(underlying_type<K>*& dir, K*& p, const int& n, const unsigned short extra = 0, const unsigned short it = 1, const unsigned short mu = 1) {
+        static void allocate(const std::string& prefix, underlying_type<K>*& dir, K*& p, const int& n, const unsigned short extra = 0, const unsigned short it = 1, const unsigned short mu = 1) {
             if(extra == 0) {
-                dir = new underlying_type<K>[3 * mu];
-                p = new K[std::max(1, 4 * n) * mu];
+                dir = Workspace<underlying_type<K>>::get()->allocate(3 * mu, prefix);
+                p = Workspace<K>::get()->allocate(std::max(1, 4 * n) * mu, prefix);
             }
             else {
-                dir = new underlying_type<K>[(2 + 2 * it) * mu];
-                p = new K[std::max(1, (4 + extra * it) * n) * mu];
+                dir = Workspace<underlying_type<K>>::get()->allocate((2 + 2 * it) * mu, prefix);
+                p = Workspace<K>::get()->allocate(std::max(1, (4 + extra * it) * n) * mu, prefix);
             }
         }
+        /* Function: upcast
+         *  Returns a pointer to a block of vectors in the working precision, the block itself if it is already stored in the working precision, a copy of the block in a workspace otherwise. */
+        template<class K>
+        static const K* upcast(const K* const v, const int, K* const) {
+            return v;
+        }
+        template<class K, class T>
+        static const K* upcast(const T* const v, const int n, K* const work) {
+            std::copy_n(v, n, work);
+            return work;
+        }
+        /* Function: working
+         *  Returns a pointer to a block of vectors of a basis if it is stored in the working precision, a pointer to a workspace otherwise. */
+        template<class K>
+        static K* working(K* const v, K* const) {
+            return v;
+        }
+        template<class K, class T>
+        static K* working(T* const, K* const work) {
+            return work;
+        }
         /* Function: updateSol
          *
          *  Updates a solution vector after convergence of <Iterative method::GMRES>.
@@ -223,6 +393,7 @@ class IterativeMethod {
          * Template Parameters:
          *    excluded       - True if the master processes are excluded from the domain decomposition, false otherwise.
          *    K              - Scalar type.
+         *    T              - Scalar type of the basis of the Krylov subspace.
          *
          * Parameters:
          *    variant        - Type of preconditioning.
@@ -231,10 +402,10 @@ class IterativeMethod {
          *    k              - Dimension of the Hessenberg matrix.
          *    h              - Hessenberg matrix.
          *    s              - Coefficients in the Krylov subspace.
-         *    v              - Basis of the Krylov subspace. */
+         *    v              - Basis of the Krylov subspace.
+         *    work           - Workspace array of size mu * n, or 3 * mu * n if the basis is stored in a lower precision. */
         template<bool excluded, class Operator, class K, class T>
         static void updateSol(const Operator& A, const char variant, const int& n, K* const x, const K* const* const h, K* const s, T* const* const v, const short* const hasConverged, const int& mu, K* const work, const int& deflated = -1) {
-            static_assert(std::is_same<K, typename std::remove_const<T>::type>::value, "Wrong types");
             if(!excluded)
                 computeMin(h, s, hasConverged, mu, deflated);
             addSol<excluded>(A, variant, n, x, std::distance(h[0], h[1]) / std::abs(deflated), s, v, hasConverged, mu, work, deflated);
@@ -256,8 +427,7 @@ class IterativeMethod {
         }
         template<bool excluded, class Operator, class K, class T>
         static void addSol(const Operator& A, const char variant, const int& n, K* const x, const int& ldh, const K* const s, T* const* const v, const short* const hasConverged, const int& mu, K* const work, const int& deflated = -1) {
-            static_assert(std::is_same<K, typename std::remove_const<T>::type>::value, "Wrong types");
-            K* const correction = (variant == HPDDM_VARIANT_RIGHT ? (std::is_const<T>::value ? (work + mu * n) : const_cast<K*>(v[ldh / (deflated == -1 ? mu : deflated) - 1])) : work);
+            K* const correction = (variant == HPDDM_VARIANT_RIGHT ? working(v[ldh / (deflated == -1 ? mu : deflated) - 1], work + mu * n) : work);
             if(excluded || !n) {
                 if(variant == HPDDM_VARIANT_RIGHT)
                     A.template apply<excluded>(work, correction, deflated == -1 ? mu : deflated);
@@ -265,18 +435,18 @@ class IterativeMethod {
             else {
                 if(deflated == -1) {
                     int ldv = mu * n;
-                    if(variant == HPDDM_VARIANT_LEFT) {
-                        for(unsigned short nu = 0; nu < mu; ++nu)
-                            if(hasConverged[nu]) {
-                                int dim = std::abs(hasConverged[nu]);
-                                Blas<K>::gemv("N", &n, &dim, &(Wrapper<K>::d__1), *v + nu * n, &ldv, s + nu, &mu, &(Wrapper<K>::d__1), x + nu * n, &i__1);
-                            }
-                    }
-                    else {
+                    const int dim = std::abs(*std::max_element(hasConverged, hasConverged + mu, [](const short& lhs, const short& rhs) { return std::abs(lhs) < std::abs(rhs); }));
+                    // a basis stored in a lower precision is combined one block at a time
+                    const int l = std::is_same<K, typename std::remove_const<T>::type>::value ? dim : 1;
+                    for(int i = 0; i < dim; i += l) {
+                        const K* const b = upcast(v[i], l * ldv, work + 2 * ldv);
                         for(unsigned short nu = 0; nu < mu; ++nu) {
-                            int dim = std::abs(hasConverged[nu]);
-                            Blas<K>::gemv("N", &n, &dim, &(Wrapper<K>::d__1), *v + nu * n, &ldv, s + nu, &mu, &(Wrapper<K>::d__0), work + nu * n, &i__1);
+                            int k = std::min(std::abs(hasConverged[nu]) - i, l);
+                            if(k > 0)
+                                Blas<K>::gemv("N", &n, &k, &(Wrapper<K>::d__1), b + nu * n, &ldv, s + i * mu + nu, &mu, variant == HPDDM_VARIANT_LEFT || i ? &(Wrapper<K>::d__1) : &(Wrapper<K>::d__0), (variant == HPDDM_VARIANT_LEFT ? x : work) + nu * n, &i__1);
                         }
+                    }
+                    if(variant != HPDDM_VARIANT_LEFT) {
                         if(variant == HPDDM_VARIANT_RIGHT)
                             A.template apply<excluded>(work, correction, mu);
                         for(unsigned short nu = 0; nu < mu; ++nu)
@@ -285,19 +455,21 @@ class IterativeMethod {
                     }
                 }
                 else {
+                    // recycled bases are only stored in the working precision
+                    const K* const V = reinterpret_cast<const K*>(*v);
                     int dim = *hasConverged;
                     if(deflated == mu) {
                         if(variant == HPDDM_VARIANT_LEFT)
-                            Blas<K>::gemm("N", "N", &n, &mu, &dim, &(Wrapper<K>::d__1), *v, &n, s, &ldh, &(Wrapper<K>::d__1), x, &n);
+                            Blas<K>::gemm("N", "N", &n, &mu, &dim, &(Wrapper<K>::d__1), V, &n, s, &ldh, &(Wrapper<K>::d__1), x, &n);
                         else {
-                            Blas<K>::gemm("N", "N", &n, &mu, &dim, &(Wrapper<K>::d__1), *v, &n, s, &ldh, &(Wrapper<K>::d__0), work, &n);
+                            Blas<K>::gemm("N", "N", &n, &mu, &dim, &(Wrapper<K>::d__1), V, &n, s, &ldh, &(Wrapper<K>::d__0), work, &n);
                             if(variant == HPDDM_VARIANT_RIGHT)
                                 A.template apply<excluded>(work, correction, mu);
                             Blas<K>::axpy(&(dim = mu * n), &(Wrapper<K>::d__1), correction, &i__1, x, &i__1);
                         }
                     }
                     else {
-                        Blas<K>::gemm("N", "N", &n, &deflated, &dim, &(Wrapper<K>::d__1), *v, &n, s, &ldh, &(Wrapper<K>::d__0), work, &n);
+                        Blas<K>::gemm("N", "N", &n, &deflated, &dim, &(Wrapper<K>::d__1), V, &n, s, &ldh, &(Wrapper<K>::d__0), work, &n);
                         if(variant == HPDDM_VARIANT_RIGHT)
                             A.template apply<excluded>(work, correction, deflated);
                         Blas<K>::gemm("N", "N", &n, &(dim = mu - deflated), &deflated, &(Wrapper<K>::d__1), correction, &n, s + deflated * ldh, &ldh, &(Wrapper<K>::d__1), x + deflated * n, &n);
@@ -307,15 +479,14 @@ class IterativeMethod {
             }
         }
         template<bool excluded, class Operator, class K, class T>
-        static void updateSolRecycling(const Operator& A, const char variant, const int& n, K* const x, const K* const* const h, K* const s, K* const* const v, T* const norm, const K* const C, const K* const U, const short* const hasConverged, const int shift, const int mu, K* const work, const MPI_Comm& comm, const int& deflated = -1) {
-            const Option& opt = *Option::get();
+        static void updateSolRecycling(const Operator& A, const char variant, const bool same, const int& n, K* const x, const K* const* const h, K* const s, K* const* const v, T* const norm, const K* const C, const K* const U, const short* const hasConverged, const int shift, const int mu, K* const work, const MPI_Comm& comm, const int& deflated = -1) {
             const int ldh = std::distance(h[0], h[1]) / std::abs(deflated);
             const int dim = ldh / (deflated == -1 ? mu : deflated);
             if(C && U) {
                 computeMin(h, s + shift * (deflated == -1 ? mu : deflated), hasConverged, mu, deflated, shift);
                 const int ldv = (deflated == -1 ? mu : deflated) * n;
                 if(deflated == -1) {
-                    if(opt.val<unsigned short>(A.prefix("recycle_same_system")))
+                    if(same)
                         std::fill_n(s, shift * mu, K());
                     else {
                         if(!excluded && n) {
@@ -331,7 +502,7 @@ class IterativeMethod {
                         }
                         else
                             std::fill_n(s, shift * mu, K());
-                        MPI_Allreduce(MPI_IN_PLACE, s, shift * mu, Wrapper<K>::mpi_type(), MPI_SUM, comm);
+                        allreduce(MPI_IN_PLACE, s, shift * mu, Wrapper<K>::mpi_type(), MPI_SUM, comm);
                     }
                     if(!excluded && n)
                         for(unsigned short nu = 0; nu < mu; ++nu) {
@@ -344,7 +515,7 @@ class IterativeMethod {
                 else {
                     int bK = deflated * shift;
                     K beta = K();
-                    if(!opt.val<unsigned short>(A.prefix("recycle_same_system"))) {
+                    if(!same) {
                         if(!excluded && n) {
                             std::copy_n(v[shift], deflated * n, work);
                             Blas<K>::trmm("R", "U", "N", "N", &n, &deflated, &(Wrapper<K>::d__1), reinterpret_cast<K*>(norm), &ldh, work, &n);
@@ -355,7 +526,7 @@ class IterativeMethod {
                         }
                         else
                             std::fill_n(work, bK * deflated, K());
-                        MPI_Allreduce(MPI_IN_PLACE, work, bK * deflated, Wrapper<K>::mpi_type(), MPI_SUM, comm);
+                        allreduce(MPI_IN_PLACE, work, bK * deflated, Wrapper<K>::mpi_type(), MPI_SUM, comm);
                         for(unsigned short i = 0; i < deflated; ++i)
                             std::copy_n(work + i * bK, bK, s + i * ldh);
                         beta = Wrapper<K>::d__1;
@@ -451,6 +622,7 @@ class IterativeMethod {
          * Template Parameters:
          *    excluded       - True if the master processes are excluded from the domain decomposition, false otherwise.
          *    K              - Scalar type.
+         *    T              - Scalar type of the basis, dot products and updates being computed in the working precision.
          *
          * Parameters:
          *    id             - Type of orthogonalization procedure.
@@ -460,60 +632,72 @@ class IterativeMethod {
          *    B              - Pointer to the basis.
          *    v              - Input block of vectors.
          *    H              - Dot products.
+         *    work           - Workspace array of size mu * n, or 2 * mu * n if the basis is stored in a lower precision.
          *    comm           - Global MPI communicator. */
-        template<bool excluded, class K>
-        static void orthogonalization(const char id, const int n, const int k, const int mu, const K* const B, K* const v, K* const H, const underlying_type<K>* const d, K* const work, const MPI_Comm& comm) {
+        template<bool excluded, class K, class T>
+        static void orthogonalization(const char id, const int n, const int k, const int mu, const T* const B, K* const v, K* const H, const underlying_type<K>* const d, K* const work, const MPI_Comm& comm) {
+            const Telemetry::Scope scope(Telemetry::ORTHOGONALIZATION);
             if(excluded || !n) {
                 std::fill_n(H, k * mu, K());
                 if(id == 1)
                     for(unsigned short i = 0; i < k; ++i)
-                        MPI_Allreduce(MPI_IN_PLACE, H + i * mu, mu, Wrapper<K>::mpi_type(), MPI_SUM, comm);
+                        allreduce(MPI_IN_PLACE, H + i * mu, mu, Wrapper<K>::mpi_type(), MPI_SUM, comm);
                 else
-                    MPI_Allreduce(MPI_IN_PLACE, H, k * mu, Wrapper<K>::mpi_type(), MPI_SUM, comm);
+                    allreduce(MPI_IN_PLACE, H, k * mu, Wrapper<K>::mpi_type(), MPI_SUM, comm);
             }
             else {
+                int ldb = mu * n;
                 if(id == 1) {
                     for(unsigned short i = 0; i < k; ++i) {
+                        const K* const b = upcast(B + i * ldb, ldb, work);
                         if(d)
                             for(unsigned short nu = 0; nu < mu; ++nu) {
                                 H[i * mu + nu] = K();
                                 for(unsigned int j = 0; j < n; ++j)
-                                    H[i * mu + nu] += d[j] * Wrapper<K>::conj(B[(i * mu + nu) * n + j]) * v[nu * n + j];
+                                    H[i * mu + nu] += d[j] * Wrapper<K>::conj(b[nu * n + j]) * v[nu * n + j];
                             }
                         else
                             for(unsigned short nu = 0; nu < mu; ++nu)
-                                H[i * mu + nu] = Blas<K>::dot(&n, B + (i * mu + nu) * n, &i__1, v + nu * n, &i__1);
-                        MPI_Allreduce(MPI_IN_PLACE, H + i * mu, mu, Wrapper<K>::mpi_type(), MPI_SUM, comm);
+                                H[i * mu + nu] = Blas<K>::dot(&n, b + nu * n, &i__1, v + nu * n, &i__1);
+                        allreduce(MPI_IN_PLACE, H + i * mu, mu, Wrapper<K>::mpi_type(), MPI_SUM, comm);
                         for(unsigned short nu = 0; nu < mu; ++nu) {
                             K alpha = -H[i * mu + nu];
-                            Blas<K>::axpy(&n, &alpha, B + (i * mu + nu) * n, &i__1, v + nu * n, &i__1);
+                            Blas<K>::axpy(&n, &alpha, b + nu * n, &i__1, v + nu * n, &i__1);
                         }
                     }
                 }
                 else {
-                    int ldb = mu * n;
                     K* const pt = d ? work : v;
                     if(d)
                         Wrapper<K>::diag(n, d, v, work, mu);
-                    for(unsigned short nu = 0; nu < mu; ++nu)
-                        Blas<K>::gemv(&(Wrapper<K>::transc), &n, &k, &(Wrapper<K>::d__1), B + nu * n, &ldb, pt + nu * n, &i__1, &(Wrapper<K>::d__0), H + nu, &mu);
-                    MPI_Allreduce(MPI_IN_PLACE, H, k * mu, Wrapper<K>::mpi_type(), MPI_SUM, comm);
-                    for(unsigned short nu = 0; nu < mu; ++nu)
-                        Blas<K>::gemv("N", &n, &k, &(Wrapper<K>::d__2), B + nu * n, &ldb, H + nu, &mu, &(Wrapper<K>::d__1), v + nu * n, &i__1);
+                    // a basis stored in a lower precision is upcasted one block at a time
+                    const int l = std::is_same<K, T>::value ? k : 1;
+                    for(unsigned short i = 0; i < k; i += l) {
+                        const K* const b = upcast(B + i * ldb, l * ldb, work + (d ? ldb : 0));
+                        for(unsigned short nu = 0; nu < mu; ++nu)
+                            Blas<K>::gemv(&(Wrapper<K>::transc), &n, &l, &(Wrapper<K>::d__1), b + nu * n, &ldb, pt + nu * n, &i__1, &(Wrapper<K>::d__0), H + i * mu + nu, &mu);
+                    }
+                    allreduce(MPI_IN_PLACE, H, k * mu, Wrapper<K>::mpi_type(), MPI_SUM, comm);
+                    for(unsigned short i = 0; i < k; i += l) {
+                        const K* const b = upcast(B + i * ldb, l * ldb, work);
+                        for(unsigned short nu = 0; nu < mu; ++nu)
+                            Blas<K>::gemv("N", &n, &l, &(Wrapper<K>::d__2), b + nu * n, &ldb, H + i * mu + nu, &mu, &(Wrapper<K>::d__1), v + nu * n, &i__1);
+                    }
                 }
             }
         }
         template<bool excluded, class K>
         static void blockOrthogonalization(const char id, const int n, const int k, const int mu, const K* const B, K* const v, K* const H, const int ldh, const underlying_type<K>* const d, K* const work, const MPI_Comm& comm) {
+            const Telemetry::Scope scope(Telemetry::ORTHOGONALIZATION);
             if(excluded || !n) {
                 std::fill_n(work, k * mu * mu, K());
                 if(id == 1)
                     for(unsigned short i = 0; i < k; ++i) {
-                        MPI_Allreduce(MPI_IN_PLACE, work, mu * mu, Wrapper<K>::mpi_type(), MPI_SUM, comm);
+                        allreduce(MPI_IN_PLACE, work, mu * mu, Wrapper<K>::mpi_type(), MPI_SUM, comm);
                         Wrapper<K>::template omatcopy<'N'>(mu, mu, work, mu, H + mu * i, ldh);
                     }
                 else {
-                    MPI_Allreduce(MPI_IN_PLACE, work, k * mu * mu, Wrapper<K>::mpi_type(), MPI_SUM, comm);
+                    allreduce(MPI_IN_PLACE, work, k * mu * mu, Wrapper<K>::mpi_type(), MPI_SUM, comm);
                     Wrapper<K>::template omatcopy<'N'>(mu, k * mu, work, k * mu, H, ldh);
                 }
             }
@@ -524,7 +708,7 @@ class IterativeMethod {
                         if(d)
                             Wrapper<K>::diag(n, d, v, pt, mu);
                         Blas<K>::gemm(&(Wrapper<K>::transc), "N", &mu, &mu, &n, &(Wrapper<K>::d__1), B + i * mu * n, &n, pt, &n, &(Wrapper<K>::d__0), work, &mu);
-                        MPI_Allreduce(MPI_IN_PLACE, work, mu * mu, Wrapper<K>::mpi_type(), MPI_SUM, comm);
+                        allreduce(MPI_IN_PLACE, work, mu * mu, Wrapper<K>::mpi_type(), MPI_SUM, comm);
                         Blas<K>::gemm("N", "N", &n, &mu, &mu, &(Wrapper<K>::d__2), B + i * mu * n, &n, work, &mu, &(Wrapper<K>::d__1), v, &n);
                         Wrapper<K>::template omatcopy<'N'>(mu, mu, work, mu, H + mu * i, ldh);
                     }
@@ -534,7 +718,7 @@ class IterativeMethod {
                         Wrapper<K>::diag(n, d, v, pt, mu);
                     const int tmp = k * mu;
                     Blas<K>::gemm(&(Wrapper<K>::transc), "N", &tmp, &mu, &n, &(Wrapper<K>::d__1), B, &n, pt, &n, &(Wrapper<K>::d__0), work, &tmp);
-                    MPI_Allreduce(MPI_IN_PLACE, work, mu * tmp, Wrapper<K>::mpi_type(), MPI_SUM, comm);
+                    allreduce(MPI_IN_PLACE, work, mu * tmp, Wrapper<K>::mpi_type(), MPI_SUM, comm);
                     Blas<K>::gemm("N", "N", &n, &mu, &tmp, &(Wrapper<K>::d__2), B, &n, work, &tmp, &(Wrapper<K>::d__1), v, &n);
                     Wrapper<K>::template omatcopy<'N'>(mu, tmp, work, tmp, H, ldh);
                 }
@@ -568,7 +752,7 @@ class IterativeMethod {
                 }
             else
                 std::fill_n(work, mu * (k * (k + 1)) / 2, K());
-            MPI_Allreduce(MPI_IN_PLACE, work, mu * (k * (k + 1)) / 2, Wrapper<K>::mpi_type(), MPI_SUM, comm);
+            allreduce(MPI_IN_PLACE, work, mu * (k * (k + 1)) / 2, Wrapper<K>::mpi_type(), MPI_SUM, comm);
             for(unsigned short nu = mu; nu-- > 0; )
                 for(unsigned short xi = k; xi > 0; --xi)
                     std::copy_backward(work + nu * (k * (k + 1)) / 2 + (xi * (xi - 1)) / 2, work + nu * (k * (k + 1)) / 2 + (xi * (xi + 1)) / 2, R + nu * k * k + xi * ldr - (ldr - xi));
@@ -618,6 +802,7 @@ class IterativeMethod {
          *  Computes a QR decomposition of a distributed matrix. */
         template<bool excluded, class K>
         static int QR(const char id, const int n, const int k, K* const Q, K* const R, const int ldr, const underlying_type<K>* const d, K* work, const MPI_Comm& comm, bool update = true, const int mu = 1) {
+            const Telemetry::Scope scope(Telemetry::ORTHOGONALIZATION);
             const int ldv = mu * n;
             int rank = k;
             if(id == HPDDM_QR_CHOLQR) {
@@ -648,7 +833,7 @@ class IterativeMethod {
                     else
                         for(unsigned short nu = 0; nu < mu; ++nu)
                             work[xi * (k + 1) * mu + nu] = Blas<K>::dot(&n, Q + xi * ldv + nu * n, &i__1, Q + xi * ldv + nu * n, &i__1);
-                    MPI_Allreduce(MPI_IN_PLACE, work + xi * (k + 1) * mu, mu, Wrapper<K>::mpi_type(), MPI_SUM, comm);
+                    allreduce(MPI_IN_PLACE, work + xi * (k + 1) * mu, mu, Wrapper<K>::mpi_type(), MPI_SUM, comm);
                     for(unsigned short nu = 0; nu < mu; ++nu) {
                         work[xi * (k + 1) * mu + nu] = std::sqrt(work[xi * (k + 1) * mu + nu]);
                         if(std::real(work[xi * (k + 1) * mu + nu]) < HPDDM_EPS)
@@ -670,27 +855,35 @@ class IterativeMethod {
             return rank;
         }
         /* Function: Arnoldi
-         *  Computes one iteration of the Arnoldi method for generating one basis vector of a Krylov space. */
-        template<bool excluded, class K>
-        static void Arnoldi(const char id, const unsigned short m, K* const* const H, K* const* const v, K* const s, underlying_type<K>* const sn, const int n, const int i, const int mu, const underlying_type<K>* const d, K* const work, const MPI_Comm& comm, K* const* const save = nullptr, const unsigned short shift = 0) {
-            orthogonalization<excluded>(id & 3, n, i + 1 - shift, mu, v[shift], v[i + 1], H[i] + shift * mu, d, work, comm);
+         *  Computes one iteration of the Arnoldi method for generating one basis vector of a Krylov space. The new vector w is orthogonalized in the working precision and then normalized into the basis v, w is v[i + 1] if the basis is stored in the working precision. */
+        template<bool excluded, class K, class T>
+        static void Arnoldi(const char id, const unsigned short m, K* const* const H, T* const* const v, K* const w, K* const s, underlying_type<K>* const sn, const int n, const int i, const int mu, const underlying_type<K>* const d, K* const work, const MPI_Comm& comm, K* const* const save = nullptr, const unsigned short shift = 0) {
+            const Telemetry::Scope scope(Telemetry::ORTHOGONALIZATION);
+            HPDDM_TRACE_SCOPE("Arnoldi");
+            orthogonalization<excluded>(id & 3, n, i + 1 - shift, mu, static_cast<const T*>(v[shift]), w, H[i] + shift * mu, d, work, comm);
             if(excluded)
                 std::fill_n(sn + i * mu, mu, 0.0);
             else if(d)
                 for(unsigned short nu = 0; nu < mu; ++nu) {
                     sn[i * mu + nu] = 0.0;
                     for(unsigned int j = 0; j < n; ++j)
-                        sn[i * mu + nu] += d[j] * std::norm(v[i + 1][nu * n + j]);
+                        sn[i * mu + nu] += d[j] * std::norm(w[nu * n + j]);
                 }
             else
                 for(unsigned short nu = 0; nu < mu; ++nu)
-                    sn[i * mu + nu] = std::real(Blas<K>::dot(&n, v[i + 1] + nu * n, &i__1, v[i + 1] + nu * n, &i__1));
-            MPI_Allreduce(MPI_IN_PLACE, sn + i * mu, mu, Wrapper<K>::mpi_underlying_type(), MPI_SUM, comm);
+                    sn[i * mu + nu] = std::real(Blas<K>::dot(&n, w + nu * n, &i__1, w + nu * n, &i__1));
+            allreduce(MPI_IN_PLACE, sn + i * mu, mu, Wrapper<K>::mpi_underlying_type(), MPI_SUM, comm);
             for(unsigned short nu = 0; nu < mu; ++nu) {
                 H[i][(i + 1) * mu + nu] = std::sqrt(sn[i * mu + nu]);
                 if(!excluded && i < m - 1)
-                    std::for_each(v[i + 1] + nu * n, v[i + 1] + (nu + 1) * n, [&](K& y) { y /= H[i][(i + 1) * mu + nu]; });
+                    std::transform(w + nu * n, w + (nu + 1) * n, v[i + 1] + nu * n, [&](const K& y) { return y / H[i][(i + 1) * mu + nu]; });
             }
+            Givens(m, H, s, sn, i, mu, save, shift);
+        }
+        /* Function: Givens
+         *  Applies the previous and computes the next Givens rotation to reduce the Hessenberg matrix to upper triangular form. */
+        template<class K>
+        static void Givens(const unsigned short m, K* const* const H, K* const s, underlying_type<K>* const sn, const int i, const int mu, K* const* const save = nullptr, const unsigned short shift = 0) {
             if(save)
                 Wrapper<K>::template omatcopy<'T'>(i + 2 - shift, mu, H[i] + shift * mu, mu, save[i - shift], m + 1);
             for(unsigned short k = shift; k < i; ++k) {
@@ -716,6 +909,8 @@ class IterativeMethod {
          *  Computes one iteration of the Block Arnoldi method for generating one basis vector of a block Krylov space. */
         template<bool excluded, class K>
         static bool BlockArnoldi(const char id, const unsigned short m, K* const* const H, K* const* const v, K* const tau, K* const s, const int lwork, const int n, const int i, const int mu, const underlying_type<K>* const d, K* const work, const MPI_Comm& comm, K* const* const save = nullptr, const unsigned short shift = 0) {
+            const Telemetry::Scope scope(Telemetry::ORTHOGONALIZATION);
+            HPDDM_TRACE_SCOPE("BlockArnoldi");
             int ldh = (m + 1) * mu;
             blockOrthogonalization<excluded>(id & 3, n, i + 1 - shift, mu, v[shift], v[i + 1], H[i] + shift * mu, ldh, d, work, comm);
             int info = QR<excluded>((id >> 2) & 7, n, mu, v[i + 1], H[i] + (i + 1) * mu, ldh, d, work, comm, i < m - 1);
@@ -765,7 +960,7 @@ class IterativeMethod {
                             pt = global + k;
                     }
                 }
-                MPI_Allreduce(local, global, k, MPI_UNSIGNED, MPI_SUM, comm);
+                allreduce(local, global, k, MPI_UNSIGNED, MPI_SUM, comm);
             }
         }
         template<bool, class Operator, class K, typename std::enable_if<hpddm_method_id<Operator>::value>::type* = nullptr>
@@ -796,7 +991,7 @@ class IterativeMethod {
                                 break;
                         }
                     }
-                    MPI_Allreduce(local, global, k, MPI_UNSIGNED, MPI_SUM, comm);
+                    allreduce(local, global, k, MPI_UNSIGNED, MPI_SUM, comm);
                 };
                 check_size();
                 {
@@ -856,12 +1051,12 @@ class IterativeMethod {
             computeResidual(A, b, x, storage, mu, norm);
             if(!hpddm_method_id<Operator>::value) {
                 if(norm == HPDDM_COMPUTE_RESIDUAL_L2 || norm == HPDDM_COMPUTE_RESIDUAL_L1) {
-                    MPI_Allreduce(MPI_IN_PLACE, storage, 2 * mu, Wrapper<K>::mpi_underlying_type(), MPI_SUM, comm);
+                    allreduce(MPI_IN_PLACE, storage, 2 * mu, Wrapper<K>::mpi_underlying_type(), MPI_SUM, comm);
                     if(norm == HPDDM_COMPUTE_RESIDUAL_L2)
                         std::for_each(storage, storage + 2 * mu, [](underlying_type<K>& b) { b = std::sqrt(b); });
                 }
                 else
-                    MPI_Allreduce(MPI_IN_PLACE, storage, 2 * mu, Wrapper<K>::mpi_underlying_type(), MPI_MAX, comm);
+                    allreduce(MPI_IN_PLACE, storage, 2 * mu, Wrapper<K>::mpi_underlying_type(), MPI_MAX, comm);
             }
             int rank;
             MPI_Comm_rank(comm, &rank);
@@ -942,6 +1137,7 @@ class IterativeMethod {
          * Template Parameters:
          *    excluded       - True if the master processes are excluded from the domain decomposition, false otherwise.
          *    K              - Scalar type.
+         *    T              - Scalar type of the basis of the Krylov subspace, see the option -hpddm_gmres_basis_precision.
          *
          * Parameters:
          *    A              - Global operator.
@@ -949,7 +1145,7 @@ class IterativeMethod {
          *    x              - Solution vector(s).
          *    mu             - Number of right-hand sides.
          *    comm           - Global MPI communicator. */
-        template<bool, class Operator, class K>
+        template<bool, class Operator, class K, class T = K>
         static int GMRES(const Operator& A, const K* const b, K* const x, const int& mu, const MPI_Comm& comm);
         template<bool, class Operator, class K>
         static int BGMRES(const Operator&, const K* const, K* const, const int&, const MPI_Comm&);
@@ -957,6 +1153,54 @@ class IterativeMethod {
         static int GCRODR(const Operator&, const K* const, K* const, const int&, const MPI_Comm&);
         template<bool, class Operator, class K>
         static int BGCRODR(const Operator&, const K* const, K* const, const int&, const MPI_Comm&);
+        /* Function: GMRESDR
+         *
+         *  Implements the GMRES with deflated restarting. Harmonic Ritz vectors are selected as in <Iterative method::GCRODR> and kept from one cycle to the next, but they are not recycled between solves.
+         *
+         * Template Parameters:
+         *    excluded       - True if the master processes are excluded from the domain decomposition, false otherwise.
+         *    K              - Scalar type.
+         *
+         * Parameters:
+         *    A              - Global operator.
+         *    b              - Right-hand side(s).
+         *    x              - Solution vector(s).
+         *    mu             - Number of right-hand sides.
+         *    comm           - Global MPI communicator. */
+        template<bool, class Operator, class K>
+        static int GMRESDR(const Operator& A, const K* const b, K* const x, const int& mu, const MPI_Comm& comm);
+        /* Function: IDR
+         *
+         *  Implements the IDR(s) method, with s set by the option -hpddm_idr_s. Only variants left and right are available, flexible preconditioning falls back to the latter.
+         *
+         * Template Parameters:
+         *    excluded       - True if the master processes are excluded from the domain decomposition, false otherwise.
+         *    K              - Scalar type.
+         *
+         * Parameters:
+         *    A              - Global operator.
+         *    b              - Right-hand side(s).
+         *    x              - Solution vector(s).
+         *    mu             - Number of right-hand sides.
+         *    comm           - Global MPI communicator. */
+        template<bool, class Operator, class K>
+        static int IDR(const Operator& A, const K* const b, K* const x, const int& mu, const MPI_Comm& comm);
+        /* Function: BiCGStab
+         *
+         *  Implements the BiCGStab(l) method, with l set by the option -hpddm_bicgstab_l. The minimal residual polynomial is computed from a single Gram matrix per cycle. Only variants left and right are available, flexible preconditioning falls back to the latter.
+         *
+         * Template Parameters:
+         *    excluded       - True if the master processes are excluded from the domain decomposition, false otherwise.
+         *    K              - Scalar type.
+         *
+         * Parameters:
+         *    A              - Global operator.
+         *    b              - Right-hand side(s).
+         *    x              - Solution vector(s).
+         *    mu             - Number of right-hand sides.
+         *    comm           - Global MPI communicator. */
+        template<bool, class Operator, class K>
+        static int BiCGStab(const Operator& A, const K* const b, K* const x, const int& mu, const MPI_Comm& comm);
         /* Function: CG
          *
          *  Implements the CG method.
@@ -976,17 +1220,73 @@ class IterativeMethod {
         static int BCG(const Operator&, const K* const, K* const, const int&, const MPI_Comm&);
         template<bool, class Operator, class K>
         static int BFBCG(const Operator&, const K* const, K* const, const int&, const MPI_Comm&);
+        /* Function: estimateSpectrum
+         *
+         *  Estimates the extreme real parts of the eigenvalues of the preconditioned operator using the Hessenberg matrix of a few Arnoldi iterations started from a random vector in the range of the operator, so that nonsymmetric operators or preconditioners are detected.
+         *
+         * Template Parameters:
+         *    excluded       - True if the master processes are excluded from the domain decomposition, false otherwise.
+         *    K              - Scalar type.
+         *
+         * Parameters:
+         *    A              - Global operator.
+         *    k              - Maximum number of iterations.
+         *    ev             - Lower and upper estimates of the real parts, and largest imaginary part.
+         *    comm           - Global MPI communicator.
+         *
+         * Returns true if all estimates are in the right half-plane. */
+        template<bool, class Operator, class K>
+        static bool estimateSpectrum(const Operator& A, const int k, underlying_type<K>* const ev, const MPI_Comm& comm);
+        /* Function: Hessenberg
+         *
+         *  Computes the upper Hessenberg matrix of at most k Arnoldi iterations on the preconditioned operator, using classical Gram--Schmidt with one reorthogonalization.
+         *
+         * Template Parameters:
+         *    excluded       - True if the master processes are excluded from the domain decomposition, false otherwise.
+         *    K              - Scalar type.
+         *
+         * Parameters:
+         *    A              - Global operator.
+         *    k              - Maximum number of iterations.
+         *    V              - Array of size (k + 1) * <Subdomain::dof>, with the starting vector as input and the Arnoldi basis as output.
+         *    H              - Array of size (k + 1) * (k + 1), with the Hessenberg matrix of leading dimension k + 1 as output.
+         *    work           - Array of size 3 * <Subdomain::dof>.
+         *    comm           - Global MPI communicator.
+         *
+         * Returns the number of iterations, lower than k if the Krylov subspace is invariant. */
+        template<bool, class Operator, class K>
+        static int Hessenberg(const Operator& A, const int k, K* const V, K* const H, K* const work, const MPI_Comm& comm);
+        /* Function: Chebyshev
+         *
+         *  Implements Chebyshev iterations, used instead of <Iterative method::Richardson> when the option -hpddm_richardson_chebyshev is set. No global reduction is performed once the spectral bounds of the preconditioned operator, which must have a real and positive spectrum, are stored in <Spectrum>. If some estimated eigenvalues are not in the right half-plane, <Iterative method::GMRES> is used instead.
+         *
+         * Template Parameters:
+         *    excluded       - True if the master processes are excluded from the domain decomposition, false otherwise.
+         *    K              - Scalar type.
+         *
+         * Parameters:
+         *    A              - Global operator.
+         *    b              - Right-hand side(s).
+         *    x              - Solution vector(s).
+         *    mu             - Number of right-hand sides.
+         *    comm           - Global MPI communicator. */
+        template<bool, class Operator, class K>
+        static int Chebyshev(const Operator& A, const K* const b, K* const x, const int& mu, const MPI_Comm& comm);
         template<bool excluded, class Operator, class K>
-        static int Richardson(const Operator& A, const K* const b, K* const x, const int& mu, const MPI_Comm&) {
+        static int Richardson(const Operator& A, const K* const b, K* const x, const int& mu, const MPI_Comm& comm) {
             K factor;
             unsigned short it;
             {
                 underlying_type<K> d;
-                options<7>(A.prefix(), &d, nullptr, &it, nullptr);
+                int chebyshev;
+                char verbosity;
+                options<7>(A.snapshot(), &d, &chebyshev, &it, &verbosity);
+                if(chebyshev > 0)
+                    return Chebyshev<excluded>(A, b, x, mu, comm);
                 factor = d;
             }
             const int n = excluded ? 0 : mu * A.getDof();
-            K* work = new K[2 * n];
+            K* work = Workspace<K>::get()->allocate(2 * n, A.prefix());
             K* r = work + n;
             bool allocate = A.template start<excluded>(b, x, mu);
             unsigned short j = 1;
@@ -997,7 +1297,7 @@ class IterativeMethod {
                 A.template apply<excluded>(r, work, mu);
                 Blas<K>::axpy(&n, &factor, work, &i__1, x, &i__1);
             }
-            delete [] work;
+            Workspace<K>::get()->deallocate(work, A.prefix());
             A.end(allocate);
             return it;
         }
@@ -1024,14 +1324,16 @@ class IterativeMethod {
                                                                                               ) {
             int comm = 0;
 #endif
+            HPDDM_TRACE_SCOPE("solve");
             std::ios_base::fmtflags ff(std::cout.flags());
             std::cout << std::scientific;
             const std::string prefix = A.prefix();
-            Option& opt = *Option::get();
 #if HPDDM_MIXED_PRECISION
-            opt[prefix + "variant"] = HPDDM_VARIANT_FLEXIBLE;
+            Option& opt = *Option::get();
+            if(A.snapshot().variant != HPDDM_VARIANT_FLEXIBLE)
+                opt[prefix + "variant"] = HPDDM_VARIANT_FLEXIBLE;
 #endif
-            unsigned short k = opt.val<unsigned short>(prefix + "enlarge_krylov_subspace", 0);
+            unsigned short k = A.snapshot().enlarge_krylov_subspace;
             K* sx = nullptr;
             K* sb = nullptr;
             if(k)
@@ -1041,12 +1343,16 @@ class IterativeMethod {
                 sb = const_cast<K*>(b);
                 k = 1;
             }
+            Telemetry::Record* const previous = Telemetry::get()->start(prefix);
             int it;
-            switch(opt.val<char>(prefix + "krylov_method")) {
-                case HPDDM_KRYLOV_METHOD_NONE:     { it = 1; bool allocate = A.template start<excluded>(sb, sx, k * mu); K* work = new K[k * mu * A.getDof()];
-                                                     A.template apply<excluded>(sb, sx, k * mu, work); delete [] work; A.end(allocate); break; }
+            switch(A.snapshot().krylov_method) {
+                case HPDDM_KRYLOV_METHOD_NONE:     { it = 1; bool allocate = A.template start<excluded>(sb, sx, k * mu); K* work = Workspace<K>::get()->allocate(k * mu * A.getDof(), A.prefix());
+                                                     A.template apply<excluded>(sb, sx, k * mu, work); Workspace<K>::get()->deallocate(work, A.prefix()); A.end(allocate); break; }
                 case HPDDM_KRYLOV_METHOD_RICHARDSON: it = Richardson<excluded>(A, sb, sx, k * mu, comm); break;
                 case HPDDM_KRYLOV_METHOD_BFBCG:      it = BFBCG<excluded>(A, sb, sx, k * mu, comm); break;
+                case HPDDM_KRYLOV_METHOD_BICGSTABL:  it = BiCGStab<excluded>(A, sb, sx, k * mu, comm); break;
+                case HPDDM_KRYLOV_METHOD_IDR:        it = IDR<excluded>(A, sb, sx, k * mu, comm); break;
+                case HPDDM_KRYLOV_METHOD_GMRESDR:    it = GMRESDR<excluded>(A, sb, sx, k * mu, comm); break;
                 case HPDDM_KRYLOV_METHOD_BGCRODR:    it = BGCRODR<excluded>(A, sb, sx, k * mu, comm); break;
                 case HPDDM_KRYLOV_METHOD_GCRODR:     it = GCRODR<excluded>(A, sb, sx, k * mu, comm); break;
                 case HPDDM_KRYLOV_METHOD_BCG:        it = BCG<excluded>(A, sb, sx, k * mu, comm); break;
@@ -1054,19 +1360,108 @@ class IterativeMethod {
                 case HPDDM_KRYLOV_METHOD_BGMRES:     it = BGMRES<excluded>(A, sb, sx, k * mu, comm); break;
                 default:                             it = GMRES<excluded>(A, sb, sx, k * mu, comm);
             }
+            Telemetry::get()->end(prefix, previous, it, comm);
             postprocess<excluded>(A, b, sb, x, sx, k);
-            k = opt.val<unsigned short>(prefix + "compute_residual", 10);
+            k = A.snapshot().compute_residual;
             if(!excluded && k != 10)
                 printResidual(A, b, x, mu, k, comm);
             std::cout.flags(ff);
             return it;
         }
+        /* Function: solve
+         *
+         *  Solves a linear system using iterative refinement. Residuals are computed with the first operator in the working precision, while corrections are computed by <Iterative method::solve> with the second operator in a lower precision, see <Schwarz::downscale>.
+         *
+         * Template Parameter:
+         *    excluded       - True if the master processes are excluded from the domain decomposition, false otherwise.
+         *
+         * Parameters:
+         *    A              - Global operator.
+         *    B              - Global operator in a lower precision.
+         *    b              - Right-hand side(s).
+         *    x              - Solution vector(s).
+         *    mu             - Number of right-hand sides.
+         *    comm           - Global MPI communicator. */
+        template<bool excluded = false, class Operator, class Prcndtnr, class K, typename std::enable_if<!is_substructuring_method<Operator>::value>::type* = nullptr>
+        static int solve(const Operator& A, const Prcndtnr& B, const K* const b, K* const x, const int& mu, const MPI_Comm& comm) {
+            typedef downscaled_type<K, true> T;
+            std::ios_base::fmtflags ff(std::cout.flags());
+            std::cout << std::scientific;
+            const std::string prefix = A.prefix();
+            const Option& opt = *Option::get();
+            const underlying_type<K> tol = opt.val(prefix + "refinement_tol", 1.0e-10);
+            const unsigned short m = opt.val<unsigned short>(prefix + "refinement_max_it", 10);
+            const char verbosity = opt.val<char>(prefix + "verbosity", 0);
+            const int n = excluded ? 0 : A.getDof();
+            K* const r = new K[mu * n];
+            T* const rl = new T[2 * mu * n];
+            T* const el = rl + mu * n;
+            underlying_type<K>* const norm = new underlying_type<K>[2 * mu];
+            bool allocate = A.template start<excluded>(b, x, mu);
+            const underlying_type<K>* const d = A.getScaling();
+            const std::unordered_map<unsigned int, K> map = A.boundaryConditions();
+            unsigned short j = 0;
+            int it = 0;
+            bool converged;
+            while(true) {
+                if(!excluded) {
+                    A.GMV(x, r, mu);
+                    Blas<K>::axpby(mu * n, 1.0, b, 1, -1.0, r, 1);
+                }
+                std::fill_n(norm, 2 * mu, 0.0);
+                for(unsigned short nu = 0; nu < mu; ++nu)
+                    for(unsigned int i = 0; i < n; ++i) {
+                        if(map.find(i) == map.cend()) {
+                            norm[2 * nu] += (d ? d[i] : 1.0) * std::norm(b[nu * n + i]);
+                            norm[2 * nu + 1] += (d ? d[i] : 1.0) * std::norm(r[nu * n + i]);
+                        }
+                    }
+                allreduce(MPI_IN_PLACE, norm, 2 * mu, Wrapper<K>::mpi_underlying_type(), MPI_SUM, comm);
+                converged = true;
+                for(unsigned short nu = 0; nu < mu; ++nu) {
+                    norm[2 * nu] = std::sqrt(norm[2 * nu]);
+                    norm[2 * nu + 1] = std::sqrt(norm[2 * nu + 1]);
+                    if(norm[2 * nu] < HPDDM_EPS)
+                        norm[2 * nu] = 1.0;
+                    if(norm[2 * nu + 1] > tol * norm[2 * nu])
+                        converged = false;
+                }
+                if(verbosity > 0) {
+                    std::cout << "Iterative refinement (" << std::setw(3) << j << "): " << norm[1] << " (" << norm[0] << ") " << norm[1] / norm[0];
+                    if(mu > 1)
+                        std::cout << " (rhs #1)";
+                    std::cout << std::endl;
+                }
+                if(converged || j == m)
+                    break;
+                for(unsigned short nu = 0; nu < mu; ++nu) {
+                    if(norm[2 * nu + 1] < HPDDM_EPS)
+                        norm[2 * nu + 1] = 1.0;
+                    for(unsigned int i = 0; i < n; ++i)
+                        rl[nu * n + i] = r[nu * n + i] / norm[2 * nu + 1];
+                }
+                std::fill_n(el, mu * n, T());
+                it += solve<excluded>(B, rl, el, mu, comm);
+                for(unsigned short nu = 0; nu < mu; ++nu)
+                    for(unsigned int i = 0; i < n; ++i)
+                        x[nu * n + i] += norm[2 * nu + 1] * K(el[nu * n + i]);
+                ++j;
+            }
+            if(verbosity > 0)
+                std::cout << "Iterative refinement " << (converged ? "converges" : "does not converge") << " after " << j << " step" << (j > 1 ? "s" : "") << " (" << it << " inner iteration" << (it > 1 ? "s" : "") << ")" << std::endl;
+            A.end(allocate);
+            delete [] norm;
+            delete [] rl;
+            delete [] r;
+            std::cout.flags(ff);
+            return it;
+        }
         template<bool excluded = false, class Operator = void, class K = double, typename std::enable_if<is_substructuring_method<Operator>::value>::type* = nullptr>
         static int solve(const Operator& A, const K* const b, K* const x, const int&, const MPI_Comm& comm) {
             std::ios_base::fmtflags ff(std::cout.flags());
             std::cout << std::scientific;
             int it = PCG<excluded>(A, b, x, comm);
-            unsigned short k = Option::get()->val<unsigned short>(A.prefix() + "compute_residual", 10);
+            unsigned short k = A.snapshot().compute_residual;
             if(!excluded && k == HPDDM_COMPUTE_RESIDUAL_L2)
                 printResidual(A, b, x, 1, HPDDM_COMPUTE_RESIDUAL_L2, comm);
             std::cout.flags(ff);
@@ -281,6 +281,14 @@ class MatrixCSR : public MatrixBase<K> {
                 MatrixBase<K>::destroy(dtor);
             }
         }
+        /* Function: hashValues
+         *  Returns a hash of the sparsity pattern and of the values of the matrix, see <MatrixBase::hashIndices>. */
+        std::size_t hashValues() const {
+            std::size_t seed = MatrixBase<K>::hashIndices();
+            const underlying_type<K>* const pt = reinterpret_cast<const underlying_type<K>*>(_a);
+            hash_range(seed, pt, pt + (Wrapper<K>::is_complex ? 2 : 1) * MatrixBase<K>::_nnz);
+            return seed;
+        }
         /* Function: sameSparsity
          *
          *  Checks whether the input matrix can be modified to have the same sparsity pattern as the calling object.
@@ -333,7 +333,6 @@ class MatrixMultiplication : public OperatorBase<'s', Preconditioner, K> {
     private:
         typedef OperatorBase<'s', Preconditioner, K> super;
         const MatrixCSR<K>* const                       _A;
-        MatrixCSR<K>*                                   _C;
         const underlying_type<K>* const                 _D;
         K*                                           _work;
         template<bool U>
@@ -347,76 +346,21 @@ class MatrixMultiplication : public OperatorBase<'s', Preconditioner, K> {
         }
     public:
         template<template<class> class Solver, char S, class T> friend class CoarseOperator;
-        MatrixMultiplication(const Preconditioner& p, const unsigned short& c, const unsigned int& max) : super(p, c, max), _A(p.getMatrix()), _C(), _D(p.getScaling()) { }
+        MatrixMultiplication(const Preconditioner& p, const unsigned short& c, const unsigned int& max) : super(p, c, max), _A(p.getMatrix()), _D(p.getScaling()) { }
         void initialize(unsigned int k, K*& work, unsigned short s) {
-            if(_A->_sym) {
-                std::vector<std::vector<std::pair<unsigned int, K>>> v(_A->_n);
-                unsigned int nnz = ((_A->_nnz + _A->_n - 1) / _A->_n) * 2;
-                std::for_each(v.begin(), v.end(), [&](std::vector<std::pair<unsigned int, K>>& r) { r.reserve(nnz); });
-                nnz = 0;
-                for(unsigned int i = 0; i < _A->_n; ++i) {
-                    const underlying_type<K> scal = _D[i];
-                    unsigned int j = _A->_ia[i] - (HPDDM_NUMBERING == 'F');
-                    while(j < _A->_ia[i + 1] - (HPDDM_NUMBERING == 'F' ? 2 : 1)) {
-                        if(_D[_A->_ja[j] - (HPDDM_NUMBERING == 'F')] > HPDDM_EPS) {
-                            v[i].emplace_back(_A->_ja[j], _A->_a[j] * _D[_A->_ja[j] - (HPDDM_NUMBERING == 'F')]);
-                            ++nnz;
-                        }
-                        if(scal > HPDDM_EPS) {
-                            v[_A->_ja[j] - (HPDDM_NUMBERING == 'F')].emplace_back(i + (HPDDM_NUMBERING == 'F'), _A->_a[j] * scal);
-                            ++nnz;
-                        }
-                        ++j;
-                    }
-                    if(i != _A->_ja[j] - (HPDDM_NUMBERING == 'F')) {
-                        if(_D[_A->_ja[j] - (HPDDM_NUMBERING == 'F')] > HPDDM_EPS) {
-                            v[i].emplace_back(_A->_ja[j], _A->_a[j] * _D[_A->_ja[j] - (HPDDM_NUMBERING == 'F')]);
-                            ++nnz;
-                        }
-                    }
-                    if(scal > HPDDM_EPS) {
-                        v[_A->_ja[j] - (HPDDM_NUMBERING == 'F')].emplace_back(i + (HPDDM_NUMBERING == 'F'), _A->_a[j] * scal);
-                        ++nnz;
-                    }
-                }
-                _C = new MatrixCSR<K>(_A->_n, _A->_n, nnz, false);
-                _C->_ia[0] = (Wrapper<K>::I == 'F');
-                nnz = 0;
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static, HPDDM_GRANULARITY)
-#endif
-                for(unsigned int i = 0; i < _A->_n; ++i)
-                    std::sort(v[i].begin(), v[i].end(), [](const std::pair<unsigned int, K>& lhs, const std::pair<unsigned int, K>& rhs) { return lhs.first < rhs.first; });
-                for(unsigned int i = 0; i < _A->_n; ++i) {
-                    for(const std::pair<unsigned int, K>& p : v[i]) {
-                        _C->_ja[nnz] = p.first + (Wrapper<K>::I == 'F' && HPDDM_NUMBERING != Wrapper<K>::I);
-                        _C->_a[nnz++] = p.second;
-                    }
-                    _C->_ia[i + 1] = nnz + (Wrapper<K>::I == 'F');
-                }
-            }
-            else {
-                _C = new MatrixCSR<K>(_A->_n, _A->_n, _A->_nnz, false);
-                _C->_ia[0] = (Wrapper<K>::I == 'F');
-                unsigned int nnz = 0;
-                for(unsigned int i = 0; i < _A->_n; ++i) {
-                    for(unsigned int j = _A->_ia[i] - (HPDDM_NUMBERING == 'F'); j < _A->_ia[i + 1] - (HPDDM_NUMBERING == 'F'); ++j)
-                        if(_D[_A->_ja[j] - (HPDDM_NUMBERING == 'F')] > HPDDM_EPS) {
-                            _C->_ja[nnz] = _A->_ja[j] + (Wrapper<K>::I == 'F' && HPDDM_NUMBERING != Wrapper<K>::I);
-                            _C->_a[nnz++] = _A->_a[j] * _D[_A->_ja[j] - (HPDDM_NUMBERING == 'F')];
-                        }
-                    _C->_ia[i + 1] = nnz + (Wrapper<K>::I == 'F');
-                }
-                _C->_nnz = nnz;
-            }
             work = new K[2 * k];
             _work = work + k;
             super::_signed = s;
         }
         template<char S, bool U, class T>
         void applyToNeighbor(T& in, K*& work, MPI_Request*& rq, const unsigned short* info, T = nullptr, MPI_Request* = nullptr) {
-            Wrapper<K>::template csrmm<Wrapper<K>::I>(false, &(super::_n), &(super::_local), _C->_a, _C->_ia, _C->_ja, *super::_deflation, _work);
-            delete _C;
+            Wrapper<K>::diag(super::_n, _D, *super::_deflation, work, super::_local);
+            if(HPDDM_NUMBERING == Wrapper<K>::I)
+                Wrapper<K>::csrmm(_A->_sym, &(super::_n), &(super::_local), _A->_a, _A->_ia, _A->_ja, work, _work);
+            else if(_A->_ia[super::_n] == _A->_nnz)
+                Wrapper<K>::template csrmm<'C'>(_A->_sym, &(super::_n), &(super::_local), _A->_a, _A->_ia, _A->_ja, work, _work);
+            else
+                Wrapper<K>::template csrmm<'F'>(_A->_sym, &(super::_n), &(super::_local), _A->_a, _A->_ia, _A->_ja, work, _work);
             for(unsigned short i = 0; i < super::_signed; ++i) {
                 if(U || info[i]) {
                     for(unsigned short j = 0; j < super::_local; ++j)
@@ -31,10 +31,14 @@
 #include <cstring>
 #include <stdexcept>
 #include <stack>
+#include <mutex>
+#include <atomic>
 #ifndef HPDDM_NO_REGEX
 #include <regex>
 #endif
+#include "define.hpp"
 #include "singleton.hpp"
+#include "trace.hpp"
 
 namespace HPDDM {
 /* Class: Option
@@ -47,6 +51,56 @@ class Option : private Singleton {
         /* Variable: app
          *  Pointer to an unordered map that may store custom options as defined by the user in its application. */
         std::unordered_map<std::string, double>* _app;
+    public:
+        /* Struct: Snapshot
+         *  Typed values of the options read by iterative methods and Schwarz preconditioners while solving, resolved once per prefix. */
+        struct Snapshot {
+            double                       tol;
+            double     richardson_damping_factor;
+            double             deflation_tol;
+            int                      recycle;
+            short                     max_it;
+            unsigned short     gmres_restart;
+            unsigned short enlarge_krylov_subspace;
+            unsigned short recycle_same_system;
+            unsigned short             idr_s;
+            unsigned short        bicgstab_l;
+            unsigned short richardson_chebyshev;
+            unsigned short  compute_residual;
+            char                   verbosity;
+            char               krylov_method;
+            char                     variant;
+            char           orthogonalization;
+            char                          qr;
+            char       gmres_basis_precision;
+            char              recycle_target;
+            char            recycle_strategy;
+            char              schwarz_method;
+            char   schwarz_coarse_correction;
+            char             reuse_workspace;
+            bool                   telemetry;
+            std::atomic<bool>         _valid;
+        };
+    private:
+        /* Variable: snapshot
+         *  Unordered map that stores the <Option::Snapshot> of each prefix. */
+        mutable std::unordered_map<std::string, Snapshot> _snapshot;
+        /* Variable: mutex
+         *  Serializes the accesses to <Option::snapshot> from concurrent threads. */
+        mutable std::mutex                                    _mutex;
+#if HPDDM_TRACE
+        /* Variable: trace
+         *  Events of the option trace, kept alive until they are flushed by the destructor. */
+        std::shared_ptr<Trace>                                _trace;
+#endif
+        /* Function: invalidate
+         *  Marks the snapshots of all prefixes of a key as outdated. */
+        void invalidate(const std::string& key) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            for(std::pair<const std::string, Snapshot>& s : _snapshot)
+                if(key.compare(0, s.first.size(), s.first) == 0)
+                    s.second._valid = false;
+        }
         static bool hasEnding(const std::string& str, const std::string& ending) {
             return str.length() >= ending.length() ? str.compare(str.length() - ending.length(), ending.length(), ending) == 0 : false;
         }
@@ -54,6 +108,11 @@ class Option : private Singleton {
         template<int N>
         Option(Singleton::construct_key<N>);
         ~Option() {
+#if HPDDM_TRACE
+            const std::string trace = prefix("trace", true);
+            if(!trace.empty())
+                _trace->flush(trace);
+#endif
             std::unordered_map<std::string, double>::const_iterator show = _opt.find("verbosity");
             if(show != _opt.cend()) {
                 std::function<void(const std::unordered_map<std::string, double>&, const std::string&)> generate = [&](const std::unordered_map<std::string, double>& map, const std::string& header) {
@@ -125,6 +184,7 @@ class Option : private Singleton {
          * Parameter:
          *    key            - Key to remove from <Option::opt>. */
         void remove(const std::string& key) {
+            invalidate(key);
             std::unordered_map<std::string, double>::const_iterator it = _opt.find(key);
             if(it != _opt.cend())
                 _opt.erase(it);
@@ -148,7 +208,48 @@ class Option : private Singleton {
                 return _opt.cbegin()->second;
             }
         }
-        double& operator[](const std::string& key) { return _opt[key]; }
+        double& operator[](const std::string& key) {
+            invalidate(key);
+            return _opt[key];
+        }
+        /* Function: snapshot
+         *
+         *  Returns the <Option::Snapshot> of a prefix, resolved again only if one of its options has been modified by <Option::parse>, <Option::remove>, or <Option::operator[]> since the last call. References remain valid for the lifetime of <Option::opt>.
+         *
+         * Parameter:
+         *    prefix         - Prefix of the options. */
+        const Snapshot& snapshot(const std::string& prefix = "") const {
+            std::lock_guard<std::mutex> lock(_mutex);
+            Snapshot& s = _snapshot[prefix];
+            if(!s._valid) {
+                s.tol = val(prefix + "tol", 1.0e-6);
+                s.richardson_damping_factor = val(prefix + "richardson_damping_factor", 1.0);
+                s.deflation_tol = val(prefix + "deflation_tol", -1.0);
+                s.recycle = val<int>(prefix + "recycle", 0);
+                s.max_it = std::min(val<short>(prefix + "max_it", 100), std::numeric_limits<short>::max());
+                s.gmres_restart = val<unsigned short>(prefix + "gmres_restart", 40);
+                s.enlarge_krylov_subspace = val<unsigned short>(prefix + "enlarge_krylov_subspace", 0);
+                s.recycle_same_system = val<unsigned short>(prefix + "recycle_same_system", 0);
+                s.idr_s = val<unsigned short>(prefix + "idr_s", 4);
+                s.bicgstab_l = val<unsigned short>(prefix + "bicgstab_l", 2);
+                s.richardson_chebyshev = val<unsigned short>(prefix + "richardson_chebyshev", 0);
+                s.compute_residual = val<unsigned short>(prefix + "compute_residual", 10);
+                s.verbosity = val<char>(prefix + "verbosity", 0);
+                s.krylov_method = val<char>(prefix + "krylov_method", HPDDM_KRYLOV_METHOD_GMRES);
+                s.variant = val<char>(prefix + "variant", HPDDM_VARIANT_RIGHT);
+                s.orthogonalization = val<char>(prefix + "orthogonalization", HPDDM_ORTHOGONALIZATION_CGS);
+                s.qr = val<char>(prefix + "qr", HPDDM_QR_CHOLQR);
+                s.gmres_basis_precision = val<char>(prefix + "gmres_basis_precision", HPDDM_GMRES_BASIS_PRECISION_FULL);
+                s.recycle_target = val<char>(prefix + "recycle_target", HPDDM_RECYCLE_TARGET_SM);
+                s.recycle_strategy = val<char>(prefix + "recycle_strategy", HPDDM_RECYCLE_STRATEGY_A);
+                s.schwarz_method = val<char>(prefix + "schwarz_method", -1);
+                s.schwarz_coarse_correction = val<char>(prefix + "schwarz_coarse_correction", -1);
+                s.reuse_workspace = val<char>(prefix + "reuse_workspace", 0);
+                s.telemetry = val<char>(prefix + "telemetry", 0) || !this->prefix(prefix + "telemetry_file", true).empty();
+                s._valid = true;
+            }
+            return s;
+        }
         struct Arg {
             static bool positive(const std::string& opt, const std::string& s, bool verbose) {
                 if(!s.empty()) {
@@ -431,8 +532,11 @@ class Option : private Singleton {
 class OptionsPrefix {
     protected:
         char* _prefix;
+        /* Variable: snapshot
+         *  Cached pointer to the <Option::Snapshot> of the prefix. */
+        mutable const Option::Snapshot* _snapshot;
     public:
-        OptionsPrefix() : _prefix() { };
+        OptionsPrefix() : _prefix(), _snapshot() { };
         ~OptionsPrefix() {
             delete [] _prefix;
             _prefix = nullptr;
@@ -442,6 +546,7 @@ class OptionsPrefix {
                 delete [] _prefix;
             _prefix = new char[std::strlen(prefix) + 1];
             std::strcpy(_prefix, prefix);
+            _snapshot = nullptr;
         }
         void setPrefix(const std::string& prefix) {
             if(prefix.size())
@@ -453,6 +558,13 @@ class OptionsPrefix {
         std::string prefix(const std::string& opt) const {
             return !_prefix ? opt : std::string(_prefix) + opt;
         }
+        /* Function: snapshot
+         *  Returns the <Option::Snapshot> of the prefix without looking up <Option::opt> as long as it is up to date. */
+        const Option::Snapshot& snapshot() const {
+            if(!_snapshot || !_snapshot->_valid)
+                _snapshot = &(Option::get()->snapshot(prefix()));
+            return *_snapshot;
+        }
 };
 } // HPDDM
 #endif // _HPDDM_OPTION_
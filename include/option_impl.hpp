@@ -28,11 +28,19 @@ namespace HPDDM {
 template<int N>
 inline Option::Option(Singleton::construct_key<N>) {
     _app = nullptr;
+#if HPDDM_TRACE
+    _trace = Trace::get();
+#endif
 }
 template<bool recursive, bool exact, class Container>
 inline int Option::parse(std::vector<std::string>& args, bool display, const Container& reg, std::string prefix) {
     if(args.size() == 0 && reg.size() == 0)
         return 0;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        for(std::pair<const std::string, Snapshot>& s : _snapshot)
+            s.second._valid = false;
+    }
     std::vector<std::tuple<std::string, std::string, std::function<bool(std::string&, const std::string&, bool)>>> option {
         std::forward_as_tuple("help", "Display available options", Arg::anything),
         std::forward_as_tuple("version", "Display information about HPDDM", Arg::anything),
@@ -41,8 +49,15 @@ inline int Option::parse(std::vector<std::string>& args, bool display, const Con
         std::forward_as_tuple("max_it=<100>", "Maximum number of iterations", Arg::positive),
         std::forward_as_tuple("verbosity(=<integer>)", "Level of output (higher means more displayed information)", Arg::anything),
         std::forward_as_tuple("compute_residual=(l2|l1|linfty)", "Print the residual after convergence", Arg::argument),
+        std::forward_as_tuple("telemetry=(0|1)", "Record the residual history, the time spent in each kernel, and the global reductions of iterative methods", Arg::argument),
+        std::forward_as_tuple("telemetry_file=<output_file>", "Save the telemetry of iterative methods to disk, as JSON if the file name ends with .json, as CSV otherwise", Arg::argument),
+#if HPDDM_TRACE
+        std::forward_as_tuple("trace=<output_file>", "Save a timeline of the main phases to disk as Chrome traces, one file per process", Arg::argument),
+        std::forward_as_tuple("trace_size=<65536>", "Maximum number of events per process kept in memory", Arg::positive),
+#endif
         std::forward_as_tuple("push_prefix", "Prepend the according prefix for all following options (use -" + std::string(HPDDM_PREFIX) + "pop_prefix when done)", Arg::anything),
         std::forward_as_tuple("reuse_preconditioner=(0|1)", "Do not factorize again the local matrices when solving subsequent systems", Arg::argument),
+        std::forward_as_tuple("reuse_workspace=(0|1)", "Keep the work arrays of iterative methods allocated between subsequent solves", Arg::argument),
         std::forward_as_tuple("local_operator_spd=(0|1)", "Assume the local operator is symmetric positive definite", Arg::argument),
         std::forward_as_tuple("orthogonalization=(cgs|mgs)", "Classical (faster) or Modified (more robust) Gram-Schmidt process", Arg::argument),
 #ifndef HPDDM_NO_REGEX
@@ -56,9 +71,10 @@ inline int Option::parse(std::vector<std::string>& args, bool display, const Con
         std::forward_as_tuple("dump_eigenvectors=<output_file>", "Save all local eigenvectors to disk", Arg::argument),
 #endif
 #endif
-        std::forward_as_tuple("krylov_method=(gmres|bgmres|cg|bcg|gcrodr|bgcrodr|bfbcg|richardson|none)", "(Block) Generalized Minimal Residual Method, (Breakdown-Free Block) Conjugate Gradient, (Block) Generalized Conjugate Residual Method With Inner Orthogonalization and Deflated Restarting, or Richardson iterations", Arg::argument),
+        std::forward_as_tuple("krylov_method=(gmres|bgmres|cg|bcg|gcrodr|bgcrodr|bfbcg|richardson|none|gmresdr|idr|bicgstabl)", "(Block) Generalized Minimal Residual Method, (Breakdown-Free Block) Conjugate Gradient, (Block) Generalized Conjugate Residual Method With Inner Orthogonalization and Deflated Restarting, Richardson iterations, Generalized Minimal Residual Method With Deflated Restarting, Induced Dimension Reduction, or Biconjugate Gradient Stabilized Method", Arg::argument),
         std::forward_as_tuple("enlarge_krylov_subspace=<val>", "Split the initial right-hand side into multiple vectors", Arg::positive),
         std::forward_as_tuple("gmres_restart=<40>", "Maximum number of Arnoldi vectors generated per cycle", Arg::positive),
+        std::forward_as_tuple("gmres_basis_precision=(full|reduced)", "Store the Arnoldi vectors of GMRES in the working or in a lower precision", Arg::argument),
         std::forward_as_tuple("variant=(left|right|flexible)", "Left, right, or variable preconditioning", Arg::argument),
         std::forward_as_tuple("qr=(cholqr|cgs|mgs)", "Distributed QR factorizations computed with Cholesky QR, Classical or Modified Gram-Schmidt process", Arg::argument),
         std::forward_as_tuple("deflation_tol=<val>", "Tolerance when deflating right-hand sides inside block methods", Arg::numeric),
@@ -66,11 +82,18 @@ inline int Option::parse(std::vector<std::string>& args, bool display, const Con
         std::forward_as_tuple("recycle_same_system=(0|1)", "Assume the system is the same as the one for which Ritz vectors have been computed", Arg::argument),
         std::forward_as_tuple("recycle_strategy=(A|B)", "Generalized eigenvalue problem to solve for recycling", Arg::argument),
         std::forward_as_tuple("recycle_target=(SM|LM|SR|LR|SI|LI)", "Criterion to select harmonic Ritz vectors", Arg::argument),
+        std::forward_as_tuple("idr_s=<4>", "Dimension of the shadow space in IDR(s)", Arg::positive),
+        std::forward_as_tuple("bicgstab_l=<2>", "Degree of the minimal residual polynomial in BiCGStab(l)", Arg::positive),
         std::forward_as_tuple("richardson_damping_factor=<1.0>", "Damping factor using in Richardson iterations", Arg::argument),
+        std::forward_as_tuple("richardson_chebyshev=<val>", "Switch to Chebyshev iterations with spectral bounds estimated by a given number of Arnoldi iterations", Arg::positive),
+        std::forward_as_tuple("refinement_tol=<1.0e-10>", "Relative decrease in residual norm for iterative refinement with an operator in a lower precision", Arg::numeric),
+        std::forward_as_tuple("refinement_max_it=<10>", "Maximum number of iterative refinement steps", Arg::positive),
 #if HPDDM_SCHWARZ
         std::forward_as_tuple("", "", [](std::string&, const std::string&, bool) { std::cout << "\n Overlapping Schwarz methods options:"; return true; }),
         std::forward_as_tuple("schwarz_method=(ras|oras|soras|asm|osm|none)", "Symmetric or not, Optimized or Additive, Restricted or not", Arg::argument),
         std::forward_as_tuple("schwarz_coarse_correction=(deflated|additive|balanced)", "Switch to a multilevel preconditioner", Arg::argument),
+        std::forward_as_tuple("schwarz_subdomains=<1>", "Number of subdomains per process, factorized independently and solved concurrently with OpenMP tasks", Arg::positive),
+        std::forward_as_tuple("schwarz_subdomains_overlap=<1>", "Number of layers of overlap between subdomains of the same process", Arg::integer),
 #endif
 #if HPDDM_FETI || HPDDM_BDD
         std::forward_as_tuple("", "", [](std::string&, const std::string&, bool) { std::cout << "\n Substructuring methods options:"; return true; }),
@@ -131,18 +154,26 @@ inline int Option::parse(std::vector<std::string>& args, bool display, const Con
         std::forward_as_tuple("", "", [](std::string&, const std::string&, bool) { std::cout << "\n Dissection-specific options:"; return true; }),
         std::forward_as_tuple("dissection_pivot_tol=<val>", "Tolerance for choosing when to pivot during numerical factorizations", Arg::numeric),
         std::forward_as_tuple("dissection_kkt_scaling=(0|1)", "Turn on KKT scaling instead of the default diagonal scaling", Arg::argument),
+#endif
+#ifdef ILUSUB
+        std::forward_as_tuple("", "", [](std::string&, const std::string&, bool) { std::cout << "\n ILU-specific options:"; return true; }),
+        std::forward_as_tuple("ilu_level=<0>", "Level of fill of the incomplete factorizations of the subdomain matrices", Arg::integer),
 #endif
         std::forward_as_tuple("", "", Arg::anything),
 #if !defined(DSUITESPARSE) && !defined(DLAPACK)
         std::forward_as_tuple("master_p=<1>", "Number of master processes", Arg::positive),
+#endif
 #if defined(DMUMPS) && !HPDDM_INEXACT_COARSE_OPERATOR
         std::forward_as_tuple("master_distribution=(centralized|sol)", "Distribution of coarse right-hand sides and solution vectors", Arg::argument),
+#elif defined(DSUITESPARSE) || defined(DLAPACK)
+        std::forward_as_tuple("master_distribution=(centralized|sol|replicated)", "Distribution of coarse right-hand sides and solution vectors, sol is the same as centralized with a single master process", Arg::argument),
 #endif
+#if !defined(DSUITESPARSE) && !defined(DLAPACK)
         std::forward_as_tuple("master_topology=(0|" +
 #if !defined(HPDDM_CONTIGUOUS)
             std::string("1|") +
 #endif
-            std::string("2)"), "Distribution of the master processes", Arg::integer),
+            std::string("2|3|4)"), "Distribution of the master processes", Arg::integer),
 #endif
         std::forward_as_tuple("master_assembly_hierarchy=<val>", "Hierarchy used for the assembly of the coarse operator", Arg::positive),
 #if HPDDM_INEXACT_COARSE_OPERATOR
@@ -226,6 +257,9 @@ inline int Option::parse(std::vector<std::string>& args, bool display, const Con
             }
         }
         _opt.rehash(_opt.size());
+#if HPDDM_TRACE
+        _trace->enable(Option::prefix("trace", true).empty() ? 0 : val<unsigned int>("trace_size", 65536));
+#endif
     }
     if(pre.size() > 0)
         std::cout << "WARNING -- too many prefixes have been pushed" << std::endl;
@@ -331,6 +365,7 @@ inline void Option::version() const {
         " │  PETSc module activated? " + std::string(bool(HPDDM_PETSC) ? "true" : "false"),
         " │  QR algorithm: " + std::string(HPDDM_STR(HPDDM_QR)),
         " │  asynchronous collectives? " + std::string(bool(HPDDM_ICOLLECTIVE) ? "true" : "false"),
+        " │  tracing? " + std::string(bool(HPDDM_TRACE) ? "true" : "false"),
         " │  mixed precision arithmetic? " + std::string(bool(HPDDM_MIXED_PRECISION) ? "true" : "false"),
         " │  subdomain solver: " + std::string(HPDDM_STR(SUBDOMAIN)),
         " │  coarse operator solver: " + std::string(HPDDM_STR(COARSEOPERATOR)),
@@ -0,0 +1,240 @@
+ /*
+   This file is part of HPDDM.
+
+   Author(s): Pierre Jolivet <pierre.jolivet@enseeiht.fr>
+        Date: 2026-10-18
+
+   Copyright (C) 2026-     Centre National de la Recherche Scientifique
+
+   HPDDM is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published
+   by the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   HPDDM is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with HPDDM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _HPDDM_POLYNOMIAL_
+#define _HPDDM_POLYNOMIAL_
+
+#include <random>
+#include "iterative.hpp"
+
+namespace HPDDM {
+/* Class: Polynomial
+ *
+ *  A class that wraps a global operator A with a preconditioner M to precondition it by M p(A M), where p is the GMRES polynomial of A M whose roots are the harmonic Ritz values of an initial cycle of <Iterative method::GMRES>.
+ *  Each application of the polynomial preconditioner of degree d costs d applications of M and d - 1 matrix-vector products by A, but no global reduction, so that it may be used to lower the number of outer iterations.
+ *
+ * Template Parameters:
+ *    Operator       - Global operator, e.g., <Schwarz>.
+ *    K              - Scalar type. */
+template<class Operator, class K>
+class Polynomial : public OptionsPrefix {
+    private:
+        /* Variable: A
+         *  Reference to the wrapped operator. */
+        const Operator&                                 _A;
+        /* Variable: roots
+         *  Roots of the polynomial in modified Leja ordering, with complex conjugates stored consecutively for real scalar types. */
+        std::vector<std::complex<underlying_type<K>>> _roots;
+        /* Variable: work
+         *  Workspace array used by <Polynomial::apply>. */
+        mutable K*                                   _work;
+        /* Variable: size
+         *  Number of elements of <Polynomial::work>. */
+        mutable int                                  _size;
+        template<class T = K, typename std::enable_if<!Wrapper<T>::is_complex>::type* = nullptr>
+        static T scalar(const std::complex<underlying_type<T>>& z) { return std::real(z); }
+        template<class T = K, typename std::enable_if<Wrapper<T>::is_complex>::type* = nullptr>
+        static T scalar(const std::complex<underlying_type<T>>& z) { return z; }
+        /* Function: order
+         *  Sorts the harmonic Ritz values in modified Leja ordering, the first root has the largest modulus and each subsequent root maximizes the product of its distances to the previous ones. */
+        void order(std::vector<std::complex<underlying_type<K>>>& theta) {
+            _roots.clear();
+            _roots.reserve(theta.size());
+            if(!Wrapper<K>::is_complex)
+                theta.erase(std::remove_if(theta.begin(), theta.end(), [](const std::complex<underlying_type<K>>& z) { return std::imag(z) < -HPDDM_EPS; }), theta.end());
+            theta.erase(std::remove_if(theta.begin(), theta.end(), [](const std::complex<underlying_type<K>>& z) { return std::abs(z) < HPDDM_EPS; }), theta.end());
+            std::vector<underlying_type<K>> distance(theta.size(), 0.0);
+            typename std::vector<std::complex<underlying_type<K>>>::iterator it = std::max_element(theta.begin(), theta.end(), [](const std::complex<underlying_type<K>>& lhs, const std::complex<underlying_type<K>>& rhs) { return std::abs(lhs) < std::abs(rhs); });
+            while(it != theta.end()) {
+                const std::complex<underlying_type<K>> z = *it;
+                const bool pair = !Wrapper<K>::is_complex && std::abs(std::imag(z)) > HPDDM_EPS;
+                _roots.emplace_back(z);
+                if(pair)
+                    _roots.emplace_back(std::conj(z));
+                distance.erase(distance.begin() + std::distance(theta.begin(), it));
+                theta.erase(it);
+                for(unsigned short i = 0; i < theta.size(); ++i) {
+                    distance[i] += std::log(std::max(std::abs(theta[i] - z), underlying_type<K>(HPDDM_EPS)));
+                    if(pair)
+                        distance[i] += std::log(std::max(std::abs(theta[i] - std::conj(z)), underlying_type<K>(HPDDM_EPS)));
+                }
+                it = theta.begin() + std::distance(distance.cbegin(), std::max_element(distance.cbegin(), distance.cend()));
+            }
+        }
+    public:
+        Polynomial(const Operator& A) : OptionsPrefix(), _A(A), _work(), _size() {
+            setPrefix(A.prefix());
+        }
+        Polynomial(const Polynomial&) = delete;
+        ~Polynomial() {
+            delete [] _work;
+        }
+        /* Function: getDof
+         *  Returns the value of <Subdomain::dof> of the wrapped operator. */
+        int getDof() const { return _A.getDof(); }
+        /* Function: getScaling
+         *  Returns the partition of unity of the wrapped operator. */
+        const underlying_type<K>* getScaling() const { return _A.getScaling(); }
+        std::unordered_map<unsigned int, K> boundaryConditions() const { return _A.boundaryConditions(); }
+        template<bool excluded = false>
+        bool start(const K* const b, K* const x, const unsigned short& mu = 1) const {
+            return _A.template start<excluded>(b, x, mu);
+        }
+        void end(const bool free) const {
+            _A.end(free);
+        }
+        void GMV(const K* const in, K* const out, const int& mu = 1) const {
+            _A.GMV(in, out, mu);
+        }
+        /* Function: getDegree
+         *  Returns the degree of the polynomial, or 0 if <Polynomial::build> has not been called yet. */
+        unsigned short getDegree() const { return _roots.size(); }
+        /* Function: build
+         *
+         *  Computes the roots of the polynomial with one cycle of Arnoldi iterations on A M, starting from a random vector. The returned degree may be lower than requested if the Krylov subspace is invariant.
+         *
+         * Template Parameter:
+         *    excluded       - True if the master processes are excluded from the domain decomposition, false otherwise.
+         *
+         * Parameters:
+         *    degree         - Maximum degree of the polynomial.
+         *    comm           - Global MPI communicator. */
+        template<bool excluded = false>
+        unsigned short build(const unsigned short degree, const MPI_Comm& comm) {
+            _roots.clear();
+            if(!degree)
+                return 0;
+            const int n = excluded ? 0 : _A.getDof();
+            const int ldh = degree + 1;
+            K* const V = Workspace<K>::get()->allocate((degree + 4) * n + ldh * (degree + 1), prefix(), 1);
+            K* const w = V + (degree + 1) * n;
+            K* const H = w + 3 * n;
+            std::fill_n(w, 2 * n, K());
+            bool allocate = _A.template start<excluded>(w, w + n, 1);
+            if(!excluded && n) {
+                std::default_random_engine generator;
+                std::uniform_real_distribution<underlying_type<K>> uniform(-1.0, 1.0);
+                std::generate_n(V, n, [&]() { return K(uniform(generator)); });
+            }
+            const unsigned short m = IterativeMethod::Hessenberg<excluded>(_A, degree, V, H, w, comm);
+            _A.end(allocate);
+            std::vector<std::complex<underlying_type<K>>> theta;
+            {
+                const int dim = m;
+                K* const lu = new K[dim * (dim + 1)];
+                K* const f = lu + dim * dim;
+                int* const ipiv = new int[dim];
+                int info;
+                for(unsigned short i = 0; i < dim; ++i)
+                    std::copy_n(H + i * ldh, dim, lu + i * dim);
+                std::fill_n(f, dim, K());
+                f[dim - 1] = K(1.0);
+                Lapack<K>::getrf(&dim, &dim, lu, &dim, ipiv, &info);
+                Lapack<K>::getrs(&(Wrapper<K>::transc), &dim, &i__1, lu, &dim, ipiv, f, &dim, &info);
+                delete [] ipiv;
+                K* const T = lu;
+                for(unsigned short i = 0; i < dim; ++i)
+                    std::copy_n(H + i * ldh, dim, T + i * dim);
+                if(info == 0) {
+                    const K h = std::norm(H[(dim - 1) * ldh + dim]);
+                    Blas<K>::axpy(&dim, &h, f, &i__1, T + (dim - 1) * dim, &i__1);
+                }
+                K query;
+                int lwork = -1;
+                Lapack<K>::hseqr("E", "N", &dim, &i__1, &dim, nullptr, &dim, nullptr, nullptr, nullptr, &i__1, &query, &lwork, &info);
+                lwork = std::max(static_cast<int>(std::real(query)), dim);
+                K* const work = new K[lwork + (Wrapper<K>::is_complex ? dim : 2 * dim)];
+                K* const ev = work + lwork;
+                Lapack<K>::hseqr("E", "N", &dim, &i__1, &dim, T, &dim, ev, ev + dim, nullptr, &i__1, work, &lwork, &info);
+                theta.reserve(dim);
+                for(unsigned short i = 0; i < dim && info == 0; ++i)
+                    theta.emplace_back(Wrapper<K>::is_complex ? std::complex<underlying_type<K>>(ev[i]) : std::complex<underlying_type<K>>(std::real(ev[i]), std::real(ev[dim + i])));
+                delete [] work;
+                delete [] lu;
+            }
+            Workspace<K>::get()->deallocate(V, prefix(), 1);
+            order(theta);
+            return _roots.size();
+        }
+        /* Function: apply
+         *
+         *  Applies the polynomial preconditioner M p(A M).
+         *
+         * Template Parameter:
+         *    excluded       - True if the master processes are excluded from the domain decomposition, false otherwise.
+         *
+         * Parameters:
+         *    in             - Input vectors.
+         *    out            - Output vectors.
+         *    mu             - Number of vectors. */
+        template<bool excluded = false>
+        void apply(const K* const in, K* const out, const unsigned short& mu = 1, K* = nullptr) const {
+            const int dim = excluded ? 0 : mu * _A.getDof();
+            if(_roots.empty()) {
+                std::copy_n(in, dim, out);
+                return;
+            }
+            if(_size < 4 * dim) {
+                delete [] _work;
+                _size = 4 * dim;
+                _work = new K[_size];
+            }
+            K* const prod = _work;
+            K* const w = prod + dim;
+            K* const t = w + dim;
+            K* const z = t + dim;
+            std::copy_n(in, dim, prod);
+            std::fill_n(out, dim, K());
+            for(unsigned short i = 0; i < _roots.size(); ++i) {
+                const std::complex<underlying_type<K>>& theta = _roots[i];
+                if(Wrapper<K>::is_complex || std::abs(std::imag(theta)) < HPDDM_EPS) {
+                    const K factor = scalar(underlying_type<K>(1.0) / theta);
+                    _A.template apply<excluded>(prod, w, mu, z);                                              //  w = M prod
+                    Blas<K>::axpy(&dim, &factor, w, &i__1, out, &i__1);                                       //  y = y + w / theta
+                    if(i < _roots.size() - 1) {
+                        if(!excluded)
+                            _A.GMV(w, t, mu);
+                        const K alpha = -factor;
+                        Blas<K>::axpy(&dim, &alpha, t, &i__1, prod, &i__1);                                   //  prod = prod - A w / theta
+                    }
+                }
+                else {
+                    const underlying_type<K> s = std::norm(theta);
+                    _A.template apply<excluded>(prod, w, mu, z);
+                    if(!excluded)
+                        _A.GMV(w, t, mu);
+                    Blas<K>::axpby(dim, 2.0 * std::real(theta), prod, 1, -1.0, t, 1);                         //  t = 2 Re(theta) prod - A M prod
+                    _A.template apply<excluded>(t, w, mu, z);
+                    const K factor = 1.0 / s;
+                    Blas<K>::axpy(&dim, &factor, w, &i__1, out, &i__1);                                       //  y = y + M t / |theta|^2
+                    if(++i < _roots.size() - 1) {
+                        if(!excluded)
+                            _A.GMV(w, t, mu);
+                        const K alpha = -factor;
+                        Blas<K>::axpy(&dim, &alpha, t, &i__1, prod, &i__1);                                   //  prod = prod - A M t / |theta|^2
+                    }
+                }
+            }
+        }
+};
+} // HPDDM
+#endif // _HPDDM_POLYNOMIAL_
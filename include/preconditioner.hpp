@@ -77,6 +77,15 @@ class Preconditioner : public Subdomain<K> {
         /* Variable: uc
          *  Workspace array of size <Coarse operator::local>. */
         mutable K*         _uc;
+        /* Variable: timer
+         *  Time spent in, and number of calls to, the factorization of the local matrix, the solution of the generalized eigenvalue problem, and <Preconditioner::buildTwo>. */
+        Timer<3>        _timer;
+        /* Variable: history
+         *  Time spent in, and number of calls to, the assembly of and the solves with the coarse operators destroyed by <Preconditioner::buildTwo>, so that <Preconditioner::statistics> accounts for all of them. */
+        Timer<2>      _history;
+        /* Variable: memory
+         *  Peak size in bytes of <Preconditioner::uc>, and increases of the peak resident set size of the process during the factorizations of the local matrix and of the coarse operator. */
+        mutable std::array<std::size_t, 3> _memory;
         /* Function: buildTwo
          *
          *  Assembles and factorizes the coarse operator.
@@ -86,10 +95,12 @@ class Preconditioner : public Subdomain<K> {
          *
          * Parameters:
          *    A              - Operator used in the definition of the Galerkin matrix.
-         *    comm           - Global MPI communicator. */
+         *    comm           - Global MPI communicator.
+         *    keep           - True if the coarse operator will be updated in place by <Preconditioner::updateTwo>, false otherwise. */
         template<unsigned short excluded, class Operator, class Prcndtnr>
-        std::pair<MPI_Request, const K*>* buildTwo(Prcndtnr* B, const MPI_Comm& comm) {
+        std::pair<MPI_Request, const K*>* buildTwo(Prcndtnr* B, const MPI_Comm& comm, const bool keep = false) {
             static_assert(std::is_same<typename Prcndtnr::super&, decltype(*this)>::value || std::is_same<typename Prcndtnr::super::super&, decltype(*this)>::value, "Wrong preconditioner");
+            const Timer<3>::Scope scope(_timer, 2);
             std::pair<MPI_Request, const K*>* ret = nullptr;
             constexpr unsigned short N = std::is_same<typename Prcndtnr::super&, decltype(*this)>::value ? 3 : 4;
             unsigned short allUniform[N + 1];
@@ -101,6 +112,9 @@ class Preconditioner : public Subdomain<K> {
             if(N == 4)
                 allUniform[4] = nu > 0 ? nu : std::numeric_limits<unsigned short>::max();
             {
+                MPI_Datatype type;
+                MPI_Type_contiguous(N + 1, MPI_UNSIGNED_SHORT, &type);
+                MPI_Type_commit(&type);
                 MPI_Op op;
 #ifdef __MINGW32__
                 MPI_Op_create(&f<N>, 1, &op);
@@ -110,15 +124,21 @@ class Preconditioner : public Subdomain<K> {
                 };
                 MPI_Op_create(f, 1, &op);
 #endif
-                MPI_Allreduce(MPI_IN_PLACE, allUniform, N + 1, MPI_UNSIGNED_SHORT, op, comm);
+                MPI_Allreduce(MPI_IN_PLACE, allUniform, 1, type, op, comm);
                 MPI_Op_free(&op);
+                MPI_Type_free(&type);
             }
             if(nu > 0 || allUniform[2] != 0 || allUniform[3] != std::numeric_limits<unsigned short>::max()) {
                 bool uniformity = (N == 3 && opt.set("geneo_force_uniformity") && allUniform[1] == static_cast<unsigned short>(~allUniform[3]));
-                if(_co)
+                if(_co) {
+                    _history += _co->getTimer();
                     delete _co;
+                }
                 _co = new CoarseOperator;
+                _co->setLevel(prefix);
                 _co->setLocal(uniformity ? allUniform[1] : nu);
+                _co->setKeep(keep);
+                const std::size_t peak = peakMemory();
                 double construction = MPI_Wtime();
                 if((allUniform[2] == nu && allUniform[3] == static_cast<unsigned short>(~nu)) || uniformity)
                     ret = _co->template construction<1, excluded>(Operator(*B, allUniform[0], (allUniform[1] << 12) + allUniform[0]), comm);
@@ -127,22 +147,57 @@ class Preconditioner : public Subdomain<K> {
                 else
                     ret = _co->template construction<0, excluded>(Operator(*B, allUniform[0], (allUniform[1] << 12) + allUniform[0]), comm);
                 construction = MPI_Wtime() - construction;
+                _memory[2] = std::max(_memory[2], peakMemory() - peak);
                 if(_co->getRank() == 0 && opt.val<char>(prefix + "verbosity", 0) > 1) {
                     std::stringstream ss;
                     ss << std::setprecision(3) << construction;
-                    unsigned short p = opt.val<unsigned short>("master_p", 1);
+                    unsigned short p = opt.val<unsigned short>(_co->getLevel() + "master_p", 1);
                     std::string line = " --- coarse operator transferred and factorized by " + to_string(p) + " process" + (p == 1 ? "" : "es") + " (in " + ss.str() + "s)";
                     std::cout << line << std::endl;
                     std::cout << std::right << std::setw(line.size()) << "(criterion = " + to_string(allUniform[2] == nu && allUniform[3] == static_cast<unsigned short>(~nu) ? nu : (N == 4 && allUniform[3] == static_cast<unsigned short>(~allUniform[4]) ? -_co->getLocal() : (uniformity ? allUniform[1] : 0))) + ")" << std::endl;
                     std::cout.unsetf(std::ios_base::adjustfield);
                 }
             }
-            else {
+            else if(_co) {
+                _history += _co->getTimer();
                 delete _co;
                 _co = nullptr;
             }
             return ret;
         }
+        /* Function: updateTwo
+         *
+         *  Updates in place and refactorizes the coarse operator after the local matrices of some subdomains have changed, or falls back to <Preconditioner::buildTwo> if this is not possible. The data needed for in-place updates is only kept by coarse operators assembled by this function, so the first call always falls back to <Preconditioner::buildTwo>.
+         *
+         * Template Parameter:
+         *    excluded       - Greater than 0 if the master processes are excluded from the domain decomposition, equal to 0 otherwise.
+         *
+         * Parameters:
+         *    A              - Operator used in the definition of the Galerkin matrix.
+         *    comm           - Global MPI communicator.
+         *    dirty          - True if the local matrix or the deflation vectors of the current subdomain have changed since the coarse operator was last assembled or updated, false otherwise. */
+        template<unsigned short excluded, class Operator, class Prcndtnr>
+        std::pair<MPI_Request, const K*>* updateTwo(Prcndtnr* B, const MPI_Comm& comm, const bool dirty) {
+            if(excluded == 0 && _co) {
+                double update = MPI_Wtime();
+                bool updated;
+                {
+                    const Timer<3>::Scope scope(_timer, 2);
+                    updated = _co->update(Operator(*B, Subdomain<K>::_map.size(), 0), dirty);
+                }
+                if(updated) {
+                    update = MPI_Wtime() - update;
+                    const Option& opt = *Option::get();
+                    if(_co->getRank() == 0 && opt.val<char>(super::prefix("verbosity"), 0) > 1) {
+                        std::stringstream ss;
+                        ss << std::setprecision(3) << update;
+                        std::cout << " --- coarse operator updated and refactorized (in " + ss.str() + "s)" << std::endl;
+                    }
+                    return nullptr;
+                }
+            }
+            return buildTwo<excluded, Operator>(B, comm, true);
+        }
         /* Function: start
          *
          *  Allocates the array <Preconditioner::uc> depending on the number of right-hand sides to be solved by an <Iterative method>.
@@ -153,9 +208,10 @@ class Preconditioner : public Subdomain<K> {
             if(_uc)
                 delete [] _uc;
             _uc = new K[mu * _co->getSizeRHS()];
+            _memory[0] = std::max(_memory[0], mu * _co->getSizeRHS() * sizeof(K));
         }
     public:
-        Preconditioner() : _co(), _ev(), _uc() { }
+        Preconditioner() : _co(), _ev(), _uc(), _memory() { }
         Preconditioner(const Preconditioner&) = delete;
         ~Preconditioner() {
             delete _co;
@@ -176,6 +232,7 @@ class Preconditioner : public Subdomain<K> {
         void initialize(const unsigned short& deflation) {
             if(!_co) {
                 _co = new CoarseOperator;
+                _co->setLevel(super::prefix());
                 _co->setLocal(deflation);
             }
         }
@@ -215,6 +272,65 @@ class Preconditioner : public Subdomain<K> {
         /* Function: getAddrLocal
          *  Returns the address of <Coarse operator::local> or <i__0> if <Preconditioner::co> is not allocated. */
         const int* getAddrLocal() const { return _co ? _co->getAddrLocal() : &i__0; }
+        /* Function: statistics
+         *  Prints <Subdomain::statistics>, followed by the minimum, maximum, and average over all subdomains of the time spent in each phase of the setup and of the memory used by the preconditioner. Times are inclusive, e.g., the assembly of the coarse operator is also accounted for in its construction. */
+        void statistics() const {
+            super::statistics();
+            constexpr unsigned short N = 10;
+            double local[N], global[3 * N];
+            unsigned int calls[5];
+            for(unsigned short i = 0; i < 3; ++i) {
+                local[i] = _timer.time(i);
+                calls[i] = _timer.calls(i);
+            }
+            for(unsigned short i = 0; i < 2; ++i) {
+                local[3 + i] = _history.time(i) + (_co ? _co->getTimer().time(i) : 0.0);
+                calls[3 + i] = _history.calls(i) + (_co ? _co->getTimer().calls(i) : 0);
+            }
+            unsigned int n = 0;
+            for(const pairNeighbor& neighbor : Subdomain<K>::_map)
+                n += neighbor.second.size();
+            local[5] = _ev ? getLocal() * static_cast<double>(Subdomain<K>::_dof) * sizeof(K) : 0.0;
+            local[6] = _memory[0];
+            local[7] = 2.0 * n * sizeof(K);
+            local[8] = _memory[1];
+            local[9] = _memory[2];
+            MPI_Allreduce(MPI_IN_PLACE, calls, 5, MPI_UNSIGNED, MPI_MAX, Subdomain<K>::_communicator);
+            MPI_Allreduce(local, global, N, MPI_DOUBLE, MPI_MIN, Subdomain<K>::_communicator);
+            MPI_Allreduce(local, global + N, N, MPI_DOUBLE, MPI_MAX, Subdomain<K>::_communicator);
+            MPI_Allreduce(local, global + 2 * N, N, MPI_DOUBLE, MPI_SUM, Subdomain<K>::_communicator);
+            int rank, size;
+            MPI_Comm_rank(Subdomain<K>::_communicator, &rank);
+            MPI_Comm_size(Subdomain<K>::_communicator, &size);
+            if(rank == 0) {
+                constexpr const char* phases[5] { "local factorization", "eigenvalue problem", "coarse operator", "coarse assembly", "coarse solves" };
+                constexpr const char* arrays[5] { "eigenvectors", "coarse vectors", "buffers", "local factors", "coarse factors" };
+                std::vector<std::string> v;
+                v.reserve(N + 3);
+                const std::string& prefix = OptionsPrefix::prefix();
+                v.emplace_back(" ┌");
+                v.emplace_back(" │ HPDDM setup" + std::string(prefix.size() ? " for operator \""  + prefix + "\"": "") + " (min / max / avg):");
+                std::stringstream ss;
+                for(unsigned short i = 0; i < N; ++i) {
+                    if(global[N + i] <= 0.0)
+                        continue;
+                    ss.clear();
+                    ss.str(std::string());
+                    if(i < 5)
+                        ss << std::scientific << std::setprecision(2) << phases[i] << ": " << global[i] << " / " << global[N + i] << " / " << global[2 * N + i] / size << " s (" << calls[i] << " call" << (calls[i] > 1 ? "s" : "") << ")";
+                    else {
+                        const unsigned short unit = std::min(3, std::max(0, static_cast<int>(std::log(global[N + i]) / std::log(1024.0))));
+                        const double scale = std::pow(1024.0, unit);
+                        constexpr const char* units[4] { "B", "KiB", "MiB", "GiB" };
+                        ss << std::fixed << std::setprecision(1) << arrays[i - 5] << ": " << global[i] / scale << " / " << global[N + i] / scale << " / " << global[2 * N + i] / (size * scale) << " " << units[unit];
+                    }
+                    v.emplace_back(" │  " + ss.str());
+                }
+                v.emplace_back(" └");
+                std::vector<std::string>::const_iterator max = std::max_element(v.cbegin(), v.cend(), [](const std::string& lhs, const std::string& rhs) { return lhs.size() < rhs.size(); });
+                Option::output(v, max->size());
+            }
+        }
 #else
     protected:
         Preconditioner() { };
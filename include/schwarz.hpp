@@ -28,6 +28,7 @@
 
 #include <set>
 #include "preconditioner.hpp"
+#include "split.hpp"
 
 namespace HPDDM {
 #if HPDDM_DENSE
@@ -70,13 +71,31 @@ class Schwarz : public Preconditioner<
          *  Local partition of unity. */
         const underlying_type<K>* _d;
         std::size_t            _hash;
+        /* Variable: version
+         *  Version of the preconditioner, set by <nextVersion> after each factorization of the local matrix and each assembly or update of the coarse operator, see <Recycling::unchanged>. */
+        unsigned int        _version;
         /* Variable: type
          *  Type of <Prcndtnr> used in <Schwarz::apply> and <Schwarz::deflation>. */
         Prcndtnr               _type;
+#if HPDDM_SCHWARZ
+        /* Variable: split
+         *  Solvers of the subdomains of the current process if <Subdomain::a> is split, see <Split>, nullptr otherwise. */
+        Split<Solver, K>*     _split;
+#endif
     public:
-        Schwarz() : _d(), _hash(), _type(Prcndtnr::NO) { }
-        Schwarz(const Subdomain<K>& s) : super(s), _d(), _hash(), _type(Prcndtnr::NO) { }
+#if HPDDM_SCHWARZ
+        Schwarz() : _d(), _hash(), _version(nextVersion()), _type(Prcndtnr::NO), _split() { }
+        Schwarz(const Subdomain<K>& s) : super(s), _d(), _hash(), _version(nextVersion()), _type(Prcndtnr::NO), _split() { }
+        ~Schwarz() {
+            _d = nullptr;
+            delete _split;
+            _split = nullptr;
+        }
+#else
+        Schwarz() : _d(), _hash(), _version(nextVersion()), _type(Prcndtnr::NO) { }
+        Schwarz(const Subdomain<K>& s) : super(s), _d(), _hash(), _version(nextVersion()), _type(Prcndtnr::NO) { }
         ~Schwarz() { _d = nullptr; }
+#endif
         /* Typedef: super
          *  Type of the immediate parent class <Preconditioner>. */
         typedef Preconditioner<
@@ -101,29 +120,76 @@ class Schwarz : public Preconditioner<
                 Subdomain<K>::clearBuffer(free);
         }
 #if HPDDM_SCHWARZ
+        /* Function: localNumfact
+         *  Factorizes a local matrix with <Preconditioner::s>, or splits it in several subdomains if the option schwarz_subdomains is greater than one, see <Split>. */
+        template<char N = HPDDM_NUMBERING>
+        void localNumfact(MatrixCSR<K>* const& A) {
+            const std::string prefix = super::prefix();
+            Option& opt = *Option::get();
+            const unsigned short p = opt.val<unsigned short>(prefix + "schwarz_subdomains", 1);
+            if(p > 1 && A->_ia) {
+                if(!_split)
+                    _split = new Split<Solver, K>;
+                _split->template numfact<N>(A, p, opt.val<unsigned short>(prefix + "schwarz_subdomains_overlap", 1), _type == Prcndtnr::GE || _type == Prcndtnr::OG);
+            }
+            else {
+                delete _split;
+                _split = nullptr;
+                super::_s.template numfact<N>(A);
+            }
+        }
+        /* Function: localSolve
+         *  Applies <Preconditioner::s>, or the solvers of all subdomains of the current process if <Subdomain::a> is split. */
+        void localSolve(K* const x, const unsigned short& mu) const {
+            if(_split)
+                _split->solve(x, mu);
+            else
+                super::_s.solve(x, mu);
+        }
+        void localSolve(const K* const b, K* const x, const unsigned short& mu) const {
+            if(_split)
+                _split->solve(b, x, mu);
+            else
+                super::_s.solve(b, x, mu);
+        }
+        /* Function: callSolve
+         *
+         *  Applies the local solver to multiple right-hand sides in-place, see <Schwarz::localSolve>.
+         *
+         * Parameters:
+         *    x              - Input right-hand sides, solution vectors are stored in-place.
+         *    n              - Number of input right-hand sides. */
+        void callSolve(K* const x, const unsigned short& n = 1) const { localSolve(x, n); }
         /* Function: callNumfact
-         *  Factorizes <Subdomain::a> or another user-supplied matrix, useful for <Prcndtnr::OS> and <Prcndtnr::OG>. */
+         *  Factorizes <Subdomain::a> or another user-supplied matrix, useful for <Prcndtnr::OS> and <Prcndtnr::OG>. If the sparsity pattern of the factorized matrix is the same as in the previous call, <Preconditioner::s> is kept, so that solvers may only perform numerical factorizations, reusing the ordering and symbolic analysis previously computed. */
         template<char N = HPDDM_NUMBERING>
         void callNumfact(MatrixCSR<K>* const& A = nullptr) {
             const std::string prefix = super::prefix();
             Option& opt = *Option::get();
             unsigned short m = opt.val<unsigned short>(prefix + "schwarz_method");
-            if(A) {
-                std::size_t hash = A->hashIndices();
-                if(_hash != hash) {
-                    _hash = hash;
-                    super::destroySolver();
-                }
-            }
             switch(m) {
                 case HPDDM_SCHWARZ_METHOD_SORAS: _type = (A ? Prcndtnr::OS : Prcndtnr::SY); break;
                 case HPDDM_SCHWARZ_METHOD_ASM:   _type = Prcndtnr::SY; break;
                 case HPDDM_SCHWARZ_METHOD_NONE:  _type = Prcndtnr::NO; return;
                 default:                         _type = (A && (m == HPDDM_SCHWARZ_METHOD_ORAS || m == HPDDM_SCHWARZ_METHOD_OSM) ? Prcndtnr::OG : Prcndtnr::GE);
             }
+            MatrixCSR<K>* const B = (_type == Prcndtnr::OS || _type == Prcndtnr::OG ? A : Subdomain<K>::_a);
+            if(B && B->_ia) {
+                const std::size_t hash = B->hashIndices();
+                if(_hash != hash) {
+                    _hash = hash;
+                    super::destroySolver();
+                }
+            }
             m = opt.val<unsigned short>(prefix + "reuse_preconditioner");
-            if(m <= 1)
-                super::_s.template numfact<N>(_type == Prcndtnr::OS || _type == Prcndtnr::OG ? A : Subdomain<K>::_a);
+            if(m <= 1) {
+                const Timer<3>::Scope scope(super::_timer, 0);
+                const std::size_t peak = peakMemory();
+                localNumfact<N>(B);
+                super::_memory[1] = std::max(super::_memory[1], peakMemory() - peak);
+                Spectrum<underlying_type<K>>::get()->destroy(prefix);
+                _version = nextVersion();
+            }
             if(m >= 1)
                 opt[prefix + "reuse_preconditioner"] += 1;
         }
@@ -131,8 +197,62 @@ class Schwarz : public Preconditioner<
             bool fact = super::setMatrix(a) && _type != Prcndtnr::OS && _type != Prcndtnr::OG;
             if(fact) {
                 super::destroySolver();
-                super::_s.numfact(a);
+                localNumfact(a);
+                if(a->_ia)
+                    _hash = a->hashIndices();
+                Spectrum<underlying_type<K>>::get()->destroy(super::prefix());
+                _version = nextVersion();
+            }
+        }
+        /* Function: downscale
+         *
+         *  Initializes a copy of the preconditioner in a lower precision, e.g., to compute corrections in <Iterative method::solve> with iterative refinement. The copy shares the prefix of the preconditioner. The local matrix, the partition of unity, and the deflation vectors are converted, while the local matrices are factorized and the coarse operator is assembled in the lower precision.
+         *
+         * Template Parameter:
+         *    T              - Scalar type of the copy.
+         *
+         * Parameters:
+         *    B              - Copy of the preconditioner.
+         *    d              - Array of size <Subdomain::dof> used to store the converted partition of unity.
+         *    comm           - Global MPI communicator. */
+        template<class T>
+        void downscale(Schwarz<Solver, CoarseSolver, S, T>& B, underlying_type<T>* const d, const MPI_Comm& comm) const {
+            B.setPrefix(OptionsPrefix::prefix());
+            MatrixCSR<T>* a = nullptr;
+            if(Subdomain<K>::_a) {
+                a = new MatrixCSR<T>(Subdomain<K>::_a->_n, Subdomain<K>::_a->_m, Subdomain<K>::_a->_nnz, Subdomain<K>::_a->_sym);
+                std::copy_n(Subdomain<K>::_a->_ia, Subdomain<K>::_a->_n + 1, a->_ia);
+                std::copy_n(Subdomain<K>::_a->_ja, Subdomain<K>::_a->_nnz, a->_ja);
+                std::copy_n(Subdomain<K>::_a->_a, Subdomain<K>::_a->_nnz, a->_a);
+            }
+            std::vector<unsigned short> o;
+            std::vector<pairNeighbor::second_type> r;
+            o.reserve(Subdomain<K>::_map.size());
+            r.reserve(Subdomain<K>::_map.size());
+            for(const pairNeighbor& neighbor : Subdomain<K>::_map) {
+                o.emplace_back(neighbor.first);
+                r.emplace_back(neighbor.second);
+            }
+            MPI_Comm communicator = Subdomain<K>::_communicator;
+            B.Subdomain<T>::initialize(a, o, r, &communicator);
+            std::copy_n(_d, Subdomain<K>::_dof, d);
+            B.initialize(d);
+            if(super::_co) {
+                const unsigned short nu = super::getLocal();
+                T** ev = nullptr;
+                if(nu) {
+                    ev = new T*[nu];
+                    *ev = new T[nu * Subdomain<K>::_dof];
+                    for(unsigned short i = 0; i < nu; ++i) {
+                        ev[i] = *ev + i * Subdomain<K>::_dof;
+                        std::copy_n(super::_ev[i], Subdomain<K>::_dof, ev[i]);
+                    }
+                }
+                B.setVectors(ev);
+                static_cast<typename Schwarz<Solver, CoarseSolver, S, T>::super&>(B).initialize(nu);
+                B.buildTwo(comm);
             }
+            B.callNumfact();
         }
         /* Function: multiplicityScaling
          *
@@ -178,6 +298,7 @@ class Schwarz : public Preconditioner<
          *    mu             - Number of vectors. */
         template<bool excluded>
         void deflation(const K* const in, K* const out, const unsigned short& mu) const {
+            HPDDM_TRACE_SCOPE("deflation");
             if(excluded)
                 super::_co->template callSolver<excluded>(super::_uc, mu);
             else {
@@ -203,22 +324,77 @@ class Schwarz : public Preconditioner<
          * Parameters:
          *    in             - Input vector.
          *    out            - Output vector.
-         *    rq             - MPI request to check completion of the MPI transfers. */
+         *    rq             - MPI request to check completion of the MPI transfers.
+         *    uc             - Coarse vectors, <Preconditioner::uc> by default. */
         template<bool excluded>
-        void Ideflation(const K* const in, K* const out, const unsigned short& mu, MPI_Request* rq) const {
+        void Ideflation(const K* const in, K* const out, const unsigned short& mu, MPI_Request* rq, K* uc = nullptr) const {
+            HPDDM_TRACE_SCOPE("Ideflation");
+            if(!uc)
+                uc = super::_uc;
             if(excluded)
-                super::_co->template IcallSolver<excluded>(super::_uc, mu, rq);
+                super::_co->template IcallSolver<excluded>(uc, mu, rq);
             else {
                 Wrapper<K>::diag(Subdomain<K>::_dof, _d, in, out, mu);
                 int tmp = mu;
-                Blas<K>::gemm(&(Wrapper<K>::transc), "N", super::getAddrLocal(), &tmp, &(Subdomain<K>::_dof), &(Wrapper<K>::d__1), *super::_ev, &(Subdomain<K>::_dof), out, &(Subdomain<K>::_dof), &(Wrapper<K>::d__0), super::_uc, super::getAddrLocal());
-                super::_co->template IcallSolver<excluded>(super::_uc, mu, rq);
+                if(super::getLocal())
+                    Blas<K>::gemm(&(Wrapper<K>::transc), "N", super::getAddrLocal(), &tmp, &(Subdomain<K>::_dof), &(Wrapper<K>::d__1), *super::_ev, &(Subdomain<K>::_dof), out, &(Subdomain<K>::_dof), &(Wrapper<K>::d__0), uc, super::getAddrLocal());
+                super::_co->template IcallSolver<excluded>(uc, mu, rq);
             }
         }
+        /* Function: Wdeflation
+         *
+         *  Waits for the completion of a coarse correction computed asynchronously by <Schwarz::Ideflation>, and computes its second part.
+         *
+         * Parameters:
+         *    out            - Output vector.
+         *    mu             - Number of vectors.
+         *    rq             - MPI requests returned by <Schwarz::Ideflation>.
+         *    uc             - Coarse vectors passed to <Schwarz::Ideflation>. */
+        void Wdeflation(K* const out, const unsigned short& mu, MPI_Request* rq, const K* const uc) const {
+            HPDDM_TRACE_SCOPE("Wdeflation");
+            MPI_Waitall(2, rq, MPI_STATUSES_IGNORE);
+            int tmp = mu;
+            if(super::getLocal())
+                Blas<K>::gemm("N", "N", &(Subdomain<K>::_dof), &tmp, super::getAddrLocal(), &(Wrapper<K>::d__1), *super::_ev, &(Subdomain<K>::_dof), uc, super::getAddrLocal(), &(Wrapper<K>::d__0), out, &(Subdomain<K>::_dof)); // out = _ev E \ _ev^T D in
+            else
+                std::fill_n(out, mu * Subdomain<K>::_dof, K());
+            scaledExchange(out, mu);
+        }
 #endif // HPDDM_ICOLLECTIVE
+        /* Function: projectedSolve
+         *
+         *  Computes the second part of a deflated preconditioner, once the coarse correction is available.
+         *
+         * Parameters:
+         *    out            - Coarse correction Z E \ Z^T in on input, output vectors on output.
+         *    work           - Input vectors, modified internally.
+         *    mu             - Number of vectors. */
+        void projectedSolve(K* const out, K* const work, const unsigned short& mu) const {
+            int tmp;
+            if(!Subdomain<K>::_a->_ia && !Subdomain<K>::_a->_ja) {
+                K* workBis = new K[mu * Subdomain<K>::_dof];
+                GMV(out, workBis, mu);
+                Blas<K>::axpby(mu * Subdomain<K>::_dof, -1.0, workBis, 1, 1.0, work, 1);
+                delete [] workBis;
+            }
+            else {
+                if(HPDDM_NUMBERING == Wrapper<K>::I)
+                    Wrapper<K>::csrmm("N", &(Subdomain<K>::_dof), &(tmp = mu), &(Subdomain<K>::_dof), &(Wrapper<K>::d__2), Subdomain<K>::_a->_sym, Subdomain<K>::_a->_a, Subdomain<K>::_a->_ia, Subdomain<K>::_a->_ja, out, &(Wrapper<K>::d__1), work);
+                else if(Subdomain<K>::_a->_ia[Subdomain<K>::_dof] == Subdomain<K>::_a->_nnz)
+                    Wrapper<K>::template csrmm<'C'>("N", &(Subdomain<K>::_dof), &(tmp = mu), &(Subdomain<K>::_dof), &(Wrapper<K>::d__2), Subdomain<K>::_a->_sym, Subdomain<K>::_a->_a, Subdomain<K>::_a->_ia, Subdomain<K>::_a->_ja, out, &(Wrapper<K>::d__1), work);
+                else
+                    Wrapper<K>::template csrmm<'F'>("N", &(Subdomain<K>::_dof), &(tmp = mu), &(Subdomain<K>::_dof), &(Wrapper<K>::d__2), Subdomain<K>::_a->_sym, Subdomain<K>::_a->_a, Subdomain<K>::_a->_ia, Subdomain<K>::_a->_ja, out, &(Wrapper<K>::d__1), work);
+            }
+            scaledExchange(work, mu);                                                                      //  in = (I - A Z E \ Z^T) in
+            if(_type == Prcndtnr::OS)
+                Wrapper<K>::diag(Subdomain<K>::_dof, _d, work, mu);
+            localSolve(work, mu);
+            scaledExchange(work, mu);                                                                      //  in = D A \ (I - A Z E \ Z^T) in
+            Blas<K>::axpy(&(tmp = mu * Subdomain<K>::_dof), &(Wrapper<K>::d__1), work, &i__1, out, &i__1); // out = D A \ (I - A Z E \ Z^T) in + Z E \ Z^T in
+        }
         /* Function: buildTwo
          *
-         *  Assembles and factorizes the coarse operator by calling <Preconditioner::buildTwo>.
+         *  Assembles and factorizes the coarse operator by calling <Preconditioner::buildTwo>. To only recompute the Galerkin product of a coarse operator already assembled, e.g., after <Schwarz::setMatrix> in a Newton method, see <Schwarz::updateTwo>.
          *
          * Template Parameter:
          *    excluded       - Greater than 0 if the master processes are excluded from the domain decomposition, equal to 0 otherwise.
@@ -229,11 +405,36 @@ class Schwarz : public Preconditioner<
          * See also: <Bdd::buildTwo>, <Feti::buildTwo>. */
         template<unsigned short excluded = 0>
         std::pair<MPI_Request, const K*>* buildTwo(const MPI_Comm& comm) {
+            Spectrum<underlying_type<K>>::get()->destroy(super::prefix());
+            _version = nextVersion();
             return super::template buildTwo<excluded, MatrixMultiplication<Schwarz<Solver, CoarseSolver, S, K>, K>>(this, comm);
         }
+        /* Function: updateTwo
+         *
+         *  Updates in place and refactorizes the coarse operator by calling <Preconditioner::updateTwo>. Even if the local matrices of all subdomains have changed, e.g., after <Schwarz::setMatrix> in a Newton method, only the Galerkin product is recomputed, while the sparsity pattern of the coarse operator, its communicators, and the symbolic factorization of <Coarse operator::Solver> are reused. The first call assembles the coarse operator from scratch, see <Preconditioner::updateTwo>.
+         *
+         * Template Parameter:
+         *    excluded       - Greater than 0 if the master processes are excluded from the domain decomposition, equal to 0 otherwise.
+         *
+         * Parameters:
+         *    comm           - Global MPI communicator.
+         *    dirty          - True if the local matrix of the current subdomain has changed since the coarse operator was last assembled or updated, false otherwise. */
+        template<unsigned short excluded = 0>
+        std::pair<MPI_Request, const K*>* updateTwo(const MPI_Comm& comm, const bool dirty = true) {
+            Spectrum<underlying_type<K>>::get()->destroy(super::prefix());
+            _version = nextVersion();
+            return super::template updateTwo<excluded, MatrixMultiplication<Schwarz<Solver, CoarseSolver, S, K>, K>>(this, comm, dirty);
+        }
         template<bool excluded = false>
         bool start(const K* const b, K* const x, const unsigned short& mu = 1) const {
-            bool allocate = Subdomain<K>::setBuffer();
+            K* wk = nullptr;
+            int space = 0;
+            if(super::snapshot().reuse_workspace) {
+                for(const auto& i : Subdomain<K>::_map)
+                    space += 2 * i.second.size();
+                wk = Workspace<K>::get()->allocate(space, super::prefix(), 2);
+            }
+            bool allocate = Subdomain<K>::setBuffer(wk, space);
             if(!excluded && Subdomain<K>::_a->_ia) {
                 const std::unordered_map<unsigned int, K> map = Subdomain<K>::boundaryConditions();
                 for(const std::pair<unsigned int, K>& p : map)
@@ -243,14 +444,14 @@ class Schwarz : public Preconditioner<
             scaledExchange(x, mu);
             if(super::_co) {
                 unsigned short k = 1;
-                const std::string prefix = super::prefix();
-                Option& opt = *Option::get();
-                if(opt.any_of(prefix + "krylov_method", { HPDDM_KRYLOV_METHOD_GCRODR, HPDDM_KRYLOV_METHOD_BGCRODR }) && !opt.val<unsigned short>(prefix + "recycle_same_system"))
-                    k = std::max(opt.val<int>(prefix + "recycle", 1), 1);
+                const Option::Snapshot& snapshot = super::snapshot();
+                if((snapshot.krylov_method == HPDDM_KRYLOV_METHOD_GCRODR || snapshot.krylov_method == HPDDM_KRYLOV_METHOD_BGCRODR) && !snapshot.recycle_same_system)
+                    k = std::max(snapshot.recycle, 1);
                 super::start(mu * k);
-                if(opt.val<char>(prefix + "schwarz_coarse_correction") == HPDDM_SCHWARZ_COARSE_CORRECTION_BALANCED) {
+                if(snapshot.schwarz_coarse_correction == HPDDM_SCHWARZ_COARSE_CORRECTION_BALANCED) {
+                    Option& opt = *Option::get();
                     if(opt.val<char>("geneo_force_uniformity") == HPDDM_GENEO_FORCE_UNIFORMITY_MAX)
-                        opt[prefix + "schwarz_coarse_correction"] = HPDDM_SCHWARZ_COARSE_CORRECTION_DEFLATED;
+                        opt[super::prefix("schwarz_coarse_correction")] = HPDDM_SCHWARZ_COARSE_CORRECTION_DEFLATED;
                     else if(!excluded) {
                         K* tmp = new K[mu * Subdomain<K>::_dof];
                         GMV(x, tmp, mu);                                                  // tmp = A x
@@ -280,13 +481,15 @@ class Schwarz : public Preconditioner<
          *    work           - Workspace array. */
         template<bool excluded = false>
         void apply(const K* const in, K* const out, const unsigned short& mu = 1, K* work = nullptr) const {
-            const char correction = Option::get()->val<char>(super::prefix("schwarz_coarse_correction"), -1);
+            const Telemetry::Scope scope(Telemetry::PRECONDITIONER);
+            HPDDM_TRACE_SCOPE("apply");
+            const char correction = super::snapshot().schwarz_coarse_correction;
             if(!super::_co || correction == -1) {
                 if(_type == Prcndtnr::NO)
                     std::copy_n(in, mu * Subdomain<K>::_dof, out);
                 else if(_type == Prcndtnr::GE || _type == Prcndtnr::OG) {
                     if(!excluded) {
-                        super::_s.solve(in, out, mu);
+                        localSolve(in, out, mu);
                         scaledExchange(out, mu);         // out = D A \ in
                     }
                 }
@@ -294,11 +497,11 @@ class Schwarz : public Preconditioner<
                     if(!excluded) {
                         if(_type == Prcndtnr::OS) {
                             Wrapper<K>::diag(Subdomain<K>::_dof, _d, in, out, mu);
-                            super::_s.solve(out, mu);
+                            localSolve(out, mu);
                             Wrapper<K>::diag(Subdomain<K>::_dof, _d, out, mu);
                         }
                         else
-                            super::_s.solve(in, out, mu);
+                            localSolve(in, out, mu);
                         Subdomain<K>::exchange(out, mu); // out = A \ in
                     }
                 }
@@ -314,7 +517,7 @@ class Schwarz : public Preconditioner<
                     MPI_Request rq[2];
                     Ideflation<excluded>(in, out, mu, rq);
                     if(!excluded) {
-                        super::_s.solve(work, mu);                                                                                                                                                         // out = A \ in
+                        localSolve(work, mu);                                                                                                                                                                   // out = A \ in
                         MPI_Waitall(2, rq, MPI_STATUSES_IGNORE);
                         int k = mu;
                         Blas<K>::gemm("N", "N", &(Subdomain<K>::_dof), &k, super::getAddrLocal(), &(Wrapper<K>::d__1), *super::_ev, &(Subdomain<K>::_dof), super::_uc, super::getAddrLocal(), &(Wrapper<K>::d__0), out, &(Subdomain<K>::_dof));                   // out = _ev E \ _ev^T D in
@@ -326,17 +529,46 @@ class Schwarz : public Preconditioner<
 #else
                     deflation<excluded>(in, out, mu);
                     if(!excluded) {
-                        super::_s.solve(work, mu);
+                        localSolve(work, mu);
                         Blas<K>::axpy(&tmp, &(Wrapper<K>::d__1), work, &i__1, out, &i__1);
                         scaledExchange(out, mu);
                     }
 #endif // HPDDM_ICOLLECTIVE
                 }
                 else if(correction == HPDDM_SCHWARZ_COARSE_CORRECTION_BALANCED) {
+#if HPDDM_ICOLLECTIVE
+                    if(mu > 1) {
+                        /* the local solve of the second half of the vectors is overlapped with the coarse correction of the first half */
+                        const unsigned short batch[2] = { static_cast<unsigned short>(mu / 2), static_cast<unsigned short>(mu - mu / 2) };
+                        K* const uc[2] = { super::_uc, super::_uc + batch[0] * super::_co->getSizeRHS() };
+                        MPI_Request rq[4];
+                        for(unsigned short i = 0; i < 2; ++i) {
+                            K* const w = work + i * batch[0] * Subdomain<K>::_dof;
+                            if(!excluded) {
+                                K* const o = out + i * batch[0] * Subdomain<K>::_dof;
+                                if(_type == Prcndtnr::OS)
+                                    Wrapper<K>::diag(Subdomain<K>::_dof, _d, w, batch[i]);
+                                localSolve(w, o, batch[i]);
+                                scaledExchange(o, batch[i]);
+                                GMV(o, w, batch[i]);
+                            }
+                            Ideflation<excluded>(nullptr, w, batch[i], rq + 2 * i, uc[i]);
+                        }
+                        for(unsigned short i = 0; i < 2; ++i) {
+                            if(!excluded)
+                                Wdeflation(work + i * batch[0] * Subdomain<K>::_dof, batch[i], rq + 2 * i, uc[i]);
+                            else
+                                MPI_Wait(rq + 2 * i + 1, MPI_STATUS_IGNORE);
+                        }
+                        if(!excluded)
+                            Blas<K>::axpy(&tmp, &(Wrapper<K>::d__2), work, &i__1, out, &i__1);
+                    }
+                    else
+#endif
                     if(!excluded) {
                         if(_type == Prcndtnr::OS)
                             Wrapper<K>::diag(Subdomain<K>::_dof, _d, work, mu);
-                        super::_s.solve(work, out, mu);
+                        localSolve(work, out, mu);
                         scaledExchange(out, mu);
                         GMV(out, work, mu);
                         deflation<excluded>(nullptr, work, mu);
@@ -346,28 +578,29 @@ class Schwarz : public Preconditioner<
                         deflation<excluded>(nullptr, nullptr, mu);
                 }
                 else {
-                    deflation<excluded>(in, out, mu);                                                                  // out = Z E \ Z^T in
-                    if(!excluded) {
-                        if(!Subdomain<K>::_a->_ia && !Subdomain<K>::_a->_ja) {
-                            K* workBis = new K[mu * Subdomain<K>::_dof];
-                            GMV(out, workBis, mu);
-                            Blas<K>::axpby(mu * Subdomain<K>::_dof, -1.0, workBis, 1, 1.0, work, 1);
-                            delete [] workBis;
-                        }
-                        else {
-                            if(HPDDM_NUMBERING == Wrapper<K>::I)
-                                Wrapper<K>::csrmm("N", &(Subdomain<K>::_dof), &(tmp = mu), &(Subdomain<K>::_dof), &(Wrapper<K>::d__2), Subdomain<K>::_a->_sym, Subdomain<K>::_a->_a, Subdomain<K>::_a->_ia, Subdomain<K>::_a->_ja, out, &(Wrapper<K>::d__1), work);
-                            else if(Subdomain<K>::_a->_ia[Subdomain<K>::_dof] == Subdomain<K>::_a->_nnz)
-                                Wrapper<K>::template csrmm<'C'>("N", &(Subdomain<K>::_dof), &(tmp = mu), &(Subdomain<K>::_dof), &(Wrapper<K>::d__2), Subdomain<K>::_a->_sym, Subdomain<K>::_a->_a, Subdomain<K>::_a->_ia, Subdomain<K>::_a->_ja, out, &(Wrapper<K>::d__1), work);
+#if HPDDM_ICOLLECTIVE
+                    if(mu > 1) {
+                        /* the coarse correction of the second half of the vectors is overlapped with the local solve of the first half */
+                        const unsigned short batch[2] = { static_cast<unsigned short>(mu / 2), static_cast<unsigned short>(mu - mu / 2) };
+                        K* const uc[2] = { super::_uc, super::_uc + batch[0] * super::_co->getSizeRHS() };
+                        MPI_Request rq[4];
+                        for(unsigned short i = 0; i < 2; ++i)
+                            Ideflation<excluded>(in + i * batch[0] * Subdomain<K>::_dof, out + i * batch[0] * Subdomain<K>::_dof, batch[i], rq + 2 * i, uc[i]);
+                        for(unsigned short i = 0; i < 2; ++i) {
+                            if(!excluded) {
+                                Wdeflation(out + i * batch[0] * Subdomain<K>::_dof, batch[i], rq + 2 * i, uc[i]);                  // out = Z E \ Z^T in
+                                projectedSolve(out + i * batch[0] * Subdomain<K>::_dof, work + i * batch[0] * Subdomain<K>::_dof, batch[i]);
+                            }
                             else
-                                Wrapper<K>::template csrmm<'F'>("N", &(Subdomain<K>::_dof), &(tmp = mu), &(Subdomain<K>::_dof), &(Wrapper<K>::d__2), Subdomain<K>::_a->_sym, Subdomain<K>::_a->_a, Subdomain<K>::_a->_ia, Subdomain<K>::_a->_ja, out, &(Wrapper<K>::d__1), work);
+                                MPI_Wait(rq + 2 * i + 1, MPI_STATUS_IGNORE);
                         }
-                        scaledExchange(work, mu);                                                                      //  in = (I - A Z E \ Z^T) in
-                        if(_type == Prcndtnr::OS)
-                            Wrapper<K>::diag(Subdomain<K>::_dof, _d, work, mu);
-                        super::_s.solve(work, mu);
-                        scaledExchange(work, mu);                                                                      //  in = D A \ (I - A Z E \ Z^T) in
-                        Blas<K>::axpy(&(tmp = mu * Subdomain<K>::_dof), &(Wrapper<K>::d__1), work, &i__1, out, &i__1); // out = D A \ (I - A Z E \ Z^T) in + Z E \ Z^T in
+                    }
+                    else
+#endif
+                    {
+                        deflation<excluded>(in, out, mu);                                                              // out = Z E \ Z^T in
+                        if(!excluded)
+                            projectedSolve(out, work, mu);
                     }
                 }
             }
@@ -428,6 +661,7 @@ class Schwarz : public Preconditioner<
          *    B              - Right-hand side matrix (optional). */
         template<template<class> class Eps>
         void solveGEVP(MatrixCSR<K>* const& A, MatrixCSR<K>* const& B = nullptr, const MatrixCSR<K>* const& pattern = nullptr) {
+            const Timer<3>::Scope scope(super::_timer, 1);
             const std::string prefix = super::prefix();
             Option& opt = *Option::get();
             const underlying_type<K>& threshold = opt.val(prefix + "geneo_threshold", 0.0);
@@ -465,7 +699,8 @@ class Schwarz : public Preconditioner<
                 delete [] difference;
             }
 #endif
-            evp.template solve<Solver>(A, rhs, super::_ev, Subdomain<K>::_communicator, free ? &(super::_s) : nullptr);
+            // <Preconditioner::s> is not used when <Subdomain::a> is split, see <Schwarz::localNumfact>, so there is no analysis to share with it
+            evp.template solve<Solver>(A, rhs, super::_ev, Subdomain<K>::_communicator, free && opt.template val<unsigned short>(prefix + "schwarz_subdomains", 1) < 2 ? &(super::_s) : nullptr);
             if(rhs != B)
                 delete rhs;
             if(free) {
@@ -493,6 +728,8 @@ class Schwarz : public Preconditioner<
         virtual void GMV(const K* const in, K* const out, const int& mu = 1) const = 0;
 #else
         void GMV(const K* const in, K* const out, const int& mu = 1, MatrixCSR<K>* const& A = nullptr) const {
+            const Telemetry::Scope scope(Telemetry::SPMV);
+            HPDDM_TRACE_SCOPE("GMV");
 #if 0
             K* tmp = new K[mu * Subdomain<K>::_dof];
             Wrapper<K>::diag(Subdomain<K>::_dof, _d, in, tmp, mu);
@@ -589,6 +826,9 @@ class Schwarz : public Preconditioner<
         /* Function: getScaling
          *  Returns a constant pointer to <Schwarz::d>. */
         const underlying_type<K>* getScaling() const { return _d; }
+        /* Function: getVersion
+         *  Returns the value of <Schwarz::version>. */
+        unsigned int getVersion() const { return _version; }
         template<char N = HPDDM_NUMBERING>
         void distributedNumbering(unsigned int* const in, unsigned int& first, unsigned int& last, unsigned int& global) const {
             Subdomain<K>::template globalMapping<N>(in, in + Subdomain<K>::_dof, first, last, global, _d);
@@ -0,0 +1,244 @@
+ /*
+   This file is part of HPDDM.
+
+   Author(s): Pierre Jolivet <pierre.jolivet@enseeiht.fr>
+        Date: 2026-10-18
+
+   Copyright (C) 2026-     Centre National de la Recherche Scientifique
+
+   HPDDM is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published
+   by the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   HPDDM is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with HPDDM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _HPDDM_SPLIT_
+#define _HPDDM_SPLIT_
+
+namespace HPDDM {
+/* Class: Split
+ *
+ *  A class to split the local matrix of a process in several subdomains, each factorized by its own instance of a subdomain solver, see the options schwarz_subdomains and schwarz_subdomains_overlap.
+ *  Subdomains of a process share its local vectors, so that they communicate through memory copies instead of messages. Factorizations are performed sequentially, while local solves are performed concurrently with OpenMP tasks, so that <Solver::solve> must be thread-safe for distinct instances of the subdomain solver.
+ *
+ * Template Parameters:
+ *    Solver         - Solver used for the factorization of the matrices of the subdomains.
+ *    K              - Scalar type. */
+template<template<class> class Solver, class K>
+class Split {
+    private:
+        /* Variable: s
+         *  Solvers of the subdomains. */
+        Solver<K>*                             _s;
+        /* Variable: a
+         *  Matrices of the subdomains. */
+        std::vector<MatrixCSR<K>*>             _a;
+        /* Variable: entries
+         *  Positions in the values of the local matrix of the nonzero entries of the matrices of the subdomains. */
+        std::vector<std::vector<int>>    _entries;
+        /* Variable: idx
+         *  Indices of the unknowns of each subdomain, sorted in increasing order. */
+        std::vector<std::vector<int>>        _idx;
+        /* Variable: owner
+         *  Subdomain owning each unknown of the process. */
+        std::vector<unsigned short>        _owner;
+        /* Variable: work
+         *  Workspace arrays, one per subdomain. */
+        mutable std::vector<std::vector<K>> _work;
+        mutable std::vector<K>                 _b;
+        /* Variable: hash
+         *  Hash of the sparsity pattern of the local matrix, see <MatrixBase::hashIndices>. */
+        std::size_t                         _hash;
+        /* Variable: n
+         *  Number of unknowns of the process. */
+        int                                    _n;
+        /* Variable: overlap
+         *  Number of layers of overlap between subdomains. */
+        unsigned short                   _overlap;
+        /* Variable: restricted
+         *  True if solutions of the subdomains are only kept on the unknowns they own, false if they are summed. */
+        bool                          _restricted;
+        void clear() {
+            delete [] _s;
+            _s = nullptr;
+            for(MatrixCSR<K>* const& a : _a)
+                delete a;
+            _a.clear();
+            _entries.clear();
+        }
+    public:
+        Split() : _s(), _hash(), _n(), _overlap(), _restricted() { }
+        Split(const Split&) = delete;
+        ~Split() { clear(); }
+        /* Function: size
+         *  Returns the number of subdomains of the process. */
+        unsigned short size() const { return _a.size(); }
+        /* Function: numfact
+         *
+         *  Splits a local matrix in subdomains, and factorizes their matrices.
+         * Unknowns are sorted using a breadth-first traversal of the adjacency graph of the local matrix, and this ordering is cut in chunks of equal sizes, which are then extended by layers of neighboring unknowns.
+         * If the sparsity pattern of the local matrix and the parameters are the same as in the previous call, the partitioning is kept, only the values of the matrices of the subdomains are updated, and solvers are refactorized numerically.
+         *
+         * Template Parameter:
+         *    N              - 0- or 1-based indexing of the input matrix.
+         *
+         * Parameters:
+         *    A              - Local matrix.
+         *    p              - Number of subdomains.
+         *    overlap        - Number of layers of overlap between subdomains.
+         *    restricted     - True if solutions of the subdomains are only kept on the unknowns they own, e.g., for restricted Schwarz methods, false if they are summed, e.g., for symmetric Schwarz methods. */
+        template<char N = HPDDM_NUMBERING>
+        void numfact(const MatrixCSR<K>* const A, unsigned short p, const unsigned short overlap, const bool restricted) {
+            p = std::max(1, std::min(static_cast<int>(p), A->_n));
+            const std::size_t hash = A->hashIndices();
+            if(_s && hash == _hash && A->_n == _n && p == _a.size() && overlap == _overlap && restricted == _restricted) {
+                for(unsigned short k = 0; k < p; ++k) {
+                    for(int j = 0; j < _entries[k].size(); ++j)
+                        _a[k]->_a[j] = A->_a[_entries[k][j]];
+                    _s[k].template numfact<N>(_a[k]);
+                }
+                return;
+            }
+            clear();
+            _hash = hash;
+            _n = A->_n;
+            _overlap = overlap;
+            _restricted = restricted;
+            std::vector<std::vector<int>> adjacency(_n);
+            for(int i = 0; i < _n; ++i)
+                for(int j = A->_ia[i] - (N == 'F'); j < A->_ia[i + 1] - (N == 'F'); ++j) {
+                    const int col = A->_ja[j] - (N == 'F');
+                    if(col != i) {
+                        adjacency[i].emplace_back(col);
+                        if(A->_sym)
+                            adjacency[col].emplace_back(i);
+                    }
+                }
+            std::vector<int> order;
+            order.reserve(_n);
+            {
+                std::vector<char> visited(_n);
+                for(int root = 0; root < _n; ++root) {
+                    if(visited[root])
+                        continue;
+                    visited[root] = true;
+                    order.emplace_back(root);
+                    for(int k = order.size() - 1; k < order.size(); ++k)
+                        for(const int& j : adjacency[order[k]])
+                            if(!visited[j]) {
+                                visited[j] = true;
+                                order.emplace_back(j);
+                            }
+                }
+            }
+            _owner.resize(_n);
+            for(int i = 0; i < _n; ++i)
+                _owner[order[i]] = (static_cast<long long>(i) * p) / _n;
+            _idx.assign(p, std::vector<int>());
+            for(int i = 0; i < _n; ++i)
+                _idx[_owner[i]].emplace_back(i);
+            std::vector<int> local(_n, -1);
+            _s = new Solver<K>[p];
+            _a.reserve(p);
+            _work.resize(p);
+            _entries.resize(p);
+            for(unsigned short k = 0; k < p; ++k) {
+                std::vector<int>& idx = _idx[k];
+                for(const int& i : idx)
+                    local[i] = 0;
+                std::vector<int> frontier(idx);
+                for(unsigned short l = 0; l < overlap && !frontier.empty(); ++l) {
+                    std::vector<int> next;
+                    for(const int& i : frontier)
+                        for(const int& j : adjacency[i])
+                            if(local[j] == -1) {
+                                local[j] = 0;
+                                next.emplace_back(j);
+                            }
+                    idx.insert(idx.end(), next.cbegin(), next.cend());
+                    frontier.swap(next);
+                }
+                std::sort(idx.begin(), idx.end());
+                int nnz = 0;
+                for(int i = 0; i < idx.size(); ++i) {
+                    local[idx[i]] = i;
+                    for(int j = A->_ia[idx[i]] - (N == 'F'); j < A->_ia[idx[i] + 1] - (N == 'F'); ++j)
+                        nnz += (local[A->_ja[j] - (N == 'F')] != -1);
+                }
+                MatrixCSR<K>* a = new MatrixCSR<K>(idx.size(), idx.size(), nnz, A->_sym);
+                a->_ia[0] = (N == 'F');
+                _entries[k].resize(nnz);
+                nnz = 0;
+                for(int i = 0; i < idx.size(); ++i) {
+                    for(int j = A->_ia[idx[i]] - (N == 'F'); j < A->_ia[idx[i] + 1] - (N == 'F'); ++j) {
+                        const int col = local[A->_ja[j] - (N == 'F')];
+                        if(col != -1) {
+                            a->_ja[nnz] = col + (N == 'F');
+                            _entries[k][nnz] = j;
+                            a->_a[nnz++] = A->_a[j];
+                        }
+                    }
+                    a->_ia[i + 1] = nnz + (N == 'F');
+                }
+                for(const int& i : idx)
+                    local[i] = -1;
+                _a.emplace_back(a);
+                _s[k].template numfact<N>(a);
+            }
+        }
+        /* Function: solve
+         *
+         *  Solves the systems of all subdomains, and gathers their solutions.
+         *
+         * Parameters:
+         *    b              - Input right-hand sides.
+         *    x              - Solution vectors.
+         *    mu             - Number of right-hand sides. */
+        void solve(const K* const b, K* const x, const unsigned short& mu = 1) const {
+            if(!_restricted)
+                std::fill_n(x, mu * _n, K());
+#ifdef _OPENMP
+#pragma omp parallel if(_a.size() > 1)
+#pragma omp single
+#endif
+            for(unsigned short k = 0; k < _a.size(); ++k) {
+#ifdef _OPENMP
+#pragma omp task
+#endif
+                {
+                    HPDDM_TRACE_SCOPE("local solve");
+                    const std::vector<int>& idx = _idx[k];
+                    const int m = idx.size();
+                    std::vector<K>& work = _work[k];
+                    work.resize(mu * m);
+                    for(unsigned short nu = 0; nu < mu; ++nu)
+                        Wrapper<K>::gthr(m, b + nu * _n, work.data() + nu * m, idx.data());
+                    _s[k].solve(work.data(), mu);
+                    if(_restricted)
+                        for(unsigned short nu = 0; nu < mu; ++nu)
+                            for(int i = 0; i < m; ++i)
+                                if(_owner[idx[i]] == k)
+                                    x[nu * _n + idx[i]] = work[nu * m + i];
+                }
+            }
+            if(!_restricted)
+                for(unsigned short k = 0; k < _a.size(); ++k)
+                    for(unsigned short nu = 0; nu < mu; ++nu)
+                        for(int i = 0; i < _idx[k].size(); ++i)
+                            x[nu * _n + _idx[k][i]] += _work[k][nu * _idx[k].size() + i];
+        }
+        void solve(K* const x, const unsigned short& mu = 1) const {
+            _b.assign(x, x + mu * _n);
+            solve(_b.data(), x, mu);
+        }
+};
+} // HPDDM
+#endif // _HPDDM_SPLIT_
@@ -87,6 +87,7 @@ class Subdomain : public OptionsPrefix {
          * Parameter:
          *    in             - Input vector. */
         void exchange(K* const in, const unsigned short& mu = 1) const {
+            HPDDM_TRACE_SCOPE("exchange");
             for(unsigned short nu = 0; nu < mu; ++nu) {
                 for(unsigned short i = 0, size = _map.size(); i < size; ++i) {
                     MPI_Irecv(_buff[i], _map[i].second.size(), Wrapper<K>::mpi_type(), _map[i].first, 0, _communicator, _rq + i);
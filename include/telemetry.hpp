@@ -0,0 +1,348 @@
+ /*
+   This file is part of HPDDM.
+
+   Author(s): Pierre Jolivet <pierre.jolivet@enseeiht.fr>
+        Date: 2026-10-18
+
+   Copyright (C) 2026-     Centre National de la Recherche Scientifique
+
+   HPDDM is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published
+   by the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   HPDDM is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with HPDDM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _HPDDM_TELEMETRY_
+#define _HPDDM_TELEMETRY_
+
+#include <array>
+#include <chrono>
+#include <fstream>
+#if defined(__unix__) || defined(__APPLE__)
+# include <sys/resource.h>
+#endif
+
+namespace HPDDM {
+/* Class: Telemetry
+ *
+ *  A class to record the residual history of iterative methods, the wall-clock time spent in their kernels, and their global reductions, one record per prefix, see the options telemetry and telemetry_file.
+ *  Times are exclusive, e.g., a reduction performed during an orthogonalization is only accounted for as a reduction, and a nested solve with another prefix is accounted for in the kernel that triggered it. */
+class Telemetry : private Singleton {
+    public:
+        /* Enum: Kernel
+         *
+         *  Defines the kernels of iterative methods that are timed.
+         *
+         * OTHER             - Everything else, e.g., vector updates or small dense linear algebra.
+         * SPMV              - Global sparse matrix-vector products.
+         * PRECONDITIONER    - Applications of the preconditioner.
+         * ORTHOGONALIZATION - Orthogonalizations of Krylov bases, reductions excluded.
+         * REDUCTION         - Calls to MPI_Allreduce. */
+        enum Kernel : char {
+            OTHER, SPMV, PRECONDITIONER, ORTHOGONALIZATION, REDUCTION, KERNELS
+        };
+        /* Struct: Sample
+         *  Telemetry of a single iteration. Times and reductions are cumulative since the first solve recorded, so that differences between consecutive samples give the cost of an iteration. */
+        struct Sample {
+            std::array<double, KERNELS>    time;
+            double                     residual;
+            double                     relative;
+            unsigned long long       reductions;
+            unsigned long long            bytes;
+            unsigned int                  solve;
+            unsigned short            iteration;
+        };
+        /* Struct: Record
+         *  Telemetry of all solves with a given prefix. */
+        struct Record {
+            std::vector<Sample>         history;
+            /* Variable: maximum
+             *  Times of the samples written to disk, maxima over all processes, only stored on the first process. */
+            std::vector<std::array<double, KERNELS>> maximum;
+            std::array<double, KERNELS>    time;
+            unsigned long long       reductions;
+            unsigned long long            bytes;
+            unsigned int                 solves;
+            unsigned int             iterations;
+            /* Variable: written
+             *  Number of samples written to disk. */
+            unsigned int                written;
+            Kernel                       kernel;
+            std::chrono::steady_clock::time_point tick;
+            Record() : time(), reductions(), bytes(), solves(), iterations(), written(), kernel(OTHER) { }
+            /* Function: update
+             *  Charges the time elapsed since the last update to the current kernel. */
+            void update() {
+                const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+                time[kernel] += std::chrono::duration<double>(now - tick).count();
+                tick = now;
+            }
+        };
+        /* Class: Scope
+         *  A class to charge the lifetime of its instances to a kernel of the solve being recorded, if any. */
+        class Scope {
+            private:
+                Record* const _record;
+                Kernel        _kernel;
+            public:
+                explicit Scope(const Kernel kernel) : _record(Telemetry::get()->_current), _kernel(kernel) {
+                    if(_record) {
+                        _record->update();
+                        std::swap(_record->kernel, _kernel);
+                    }
+                }
+                Scope(const Scope&) = delete;
+                ~Scope() {
+                    if(_record) {
+                        _record->update();
+                        _record->kernel = _kernel;
+                    }
+                }
+                /* Function: reduction
+                 *  Counts a global reduction of a given size in bytes. */
+                void reduction(const unsigned long long bytes) const {
+                    if(_record) {
+                        ++_record->reductions;
+                        _record->bytes += bytes;
+                    }
+                }
+        };
+    private:
+        std::unordered_map<std::string, Record> _storage;
+        /* Variable: current
+         *  Record of the solve being recorded, if any. */
+        Record*                                 _current;
+        static const char* name(const unsigned short kernel) {
+            static constexpr const char* names[KERNELS] { "other", "spmv", "preconditioner", "orthogonalization", "reduction" };
+            return names[kernel];
+        }
+        template<bool header>
+        static void csv(std::ostream& out, const Sample& s, const std::array<double, KERNELS>& time) {
+            if(header)
+                out << "solve,iteration,residual,relative";
+            else
+                out << s.solve << "," << s.iteration << "," << s.residual << "," << s.relative;
+            for(unsigned short i = 0; i < KERNELS; ++i) {
+                if(header)
+                    out << "," << name(i);
+                else
+                    out << "," << time[i];
+            }
+            if(header)
+                out << ",reductions,bytes\n";
+            else
+                out << "," << s.reductions << "," << s.bytes << "\n";
+        }
+        /* Function: csv
+         *  Writes the samples of a record starting from a given one, with a header if it is the first one, using the maxima over all processes of the times if available. */
+        static void csv(std::ostream& out, const Record& record, const unsigned int first, const bool maximum) {
+            if(first == 0)
+                csv<true>(out, Sample(), std::array<double, KERNELS>());
+            for(unsigned int i = first; i < record.history.size(); ++i)
+                csv<false>(out, record.history[i], maximum ? record.maximum[i] : record.history[i].time);
+        }
+        /* Function: json
+         *  Writes a record as a JSON object, using the maxima over all processes of the times if available. */
+        static void json(std::ostream& out, const Record& record, const std::array<double, KERNELS>& time, const bool maximum, const std::string& key) {
+            out << "{\n  \"prefix\": \"" << key << "\",\n  \"solves\": " << record.solves << ",\n  \"iterations\": " << record.iterations << ",\n  \"time\": ";
+            json(out, time);
+            out << ",\n  \"reductions\": " << record.reductions << ",\n  \"bytes\": " << record.bytes << ",\n  \"history\": [";
+            for(unsigned int i = 0; i < record.history.size(); ++i) {
+                const Sample& s = record.history[i];
+                out << (i ? ",\n" : "\n") << "    { \"solve\": " << s.solve << ", \"iteration\": " << s.iteration << ", \"residual\": " << s.residual << ", \"relative\": " << s.relative << ", \"time\": ";
+                json(out, maximum ? record.maximum[i] : s.time);
+                out << ", \"reductions\": " << s.reductions << ", \"bytes\": " << s.bytes << " }";
+            }
+            out << (record.history.empty() ? "]\n}\n" : "\n  ]\n}\n");
+        }
+        static void json(std::ostream& out, const std::array<double, KERNELS>& time) {
+            out << "{ ";
+            for(unsigned short i = 0; i < KERNELS; ++i)
+                out << (i ? ", \"" : "\"") << name(i) << "\": " << time[i];
+            out << " }";
+        }
+    public:
+        template<int N>
+        Telemetry(Singleton::construct_key<N>) : _current() { }
+        /* Function: destroy
+         *  Discards the record of a prefix. */
+        void destroy(const std::string& key = "") {
+            std::unordered_map<std::string, Record>::const_iterator it = _storage.find(key);
+            if(it != _storage.cend() && &(it->second) != _current)
+                _storage.erase(it);
+        }
+        /* Function: record
+         *  Returns a pointer to the record of a prefix, or nullptr if no solve has been recorded yet. */
+        const Record* record(const std::string& key = "") const {
+            std::unordered_map<std::string, Record>::const_iterator it = _storage.find(key);
+            return it != _storage.cend() ? &(it->second) : nullptr;
+        }
+        /* Function: recording
+         *  Returns true if a solve is being recorded. */
+        bool recording() const { return _current; }
+        /* Function: start
+         *
+         *  Starts recording a solve if the option telemetry is set for the given prefix.
+         *
+         * Parameter:
+         *    key            - Prefix of the solve.
+         *
+         * Returns: the record of the enclosing solve, if any, to be given back to <Telemetry::end>. */
+        Record* start(const std::string& key = "") {
+            Record* const previous = _current;
+            if(Option::get()->snapshot(key).telemetry) {
+                _current = &_storage[key];
+                _current->tick = std::chrono::steady_clock::now();
+                _current->kernel = OTHER;
+            }
+            else
+                _current = nullptr;
+            return previous;
+        }
+        /* Function: end
+         *
+         *  Ends the recording of a solve, and writes the record of its prefix to the file given by the option telemetry_file, if any. Times written to disk are maxima over all processes, only the samples of the solves since the last write are reduced, and CSV files are appended to.
+         *
+         * Parameters:
+         *    key            - Prefix of the solve.
+         *    previous       - Output of <Telemetry::start>.
+         *    it             - Number of iterations of the solve.
+         *    comm           - Global MPI communicator. */
+        void end(const std::string& key, Record* const previous, const int it, const MPI_Comm& comm) {
+            Record* const record = _current;
+            _current = previous;
+            if(!record)
+                return;
+            record->update();
+            ++record->solves;
+            record->iterations += it;
+            const Option& opt = *Option::get();
+            const std::string filename = opt.prefix(key + "telemetry_file", true);
+            if(!filename.empty()) {
+                const unsigned int first = record->written;
+                std::vector<double> time((record->history.size() - first + 1) * KERNELS);
+                std::copy_n(record->time.cbegin(), KERNELS, time.begin());
+                for(unsigned int i = first; i < record->history.size(); ++i)
+                    std::copy_n(record->history[i].time.cbegin(), KERNELS, time.begin() + (i - first + 1) * KERNELS);
+                MPI_Allreduce(MPI_IN_PLACE, time.data(), time.size(), MPI_DOUBLE, MPI_MAX, comm);
+                record->written = record->history.size();
+                int rank;
+                MPI_Comm_rank(comm, &rank);
+                if(rank == 0) {
+                    record->maximum.resize(record->history.size());
+                    for(unsigned int i = first; i < record->history.size(); ++i)
+                        std::copy_n(time.cbegin() + (i - first + 1) * KERNELS, KERNELS, record->maximum[i].begin());
+                    std::array<double, KERNELS> total;
+                    std::copy_n(time.cbegin(), KERNELS, total.begin());
+                    if(filename.size() > 5 && filename.compare(filename.size() - 5, 5, ".json") == 0) {
+                        std::ofstream output { filename };
+                        output << std::scientific;
+                        json(output, *record, total, true, key);
+                    }
+                    else {
+                        std::ofstream output { filename, first ? std::ios::app : std::ios::trunc };
+                        output << std::scientific;
+                        csv(output, *record, first, true);
+                    }
+                }
+            }
+        }
+        /* Function: sample
+         *  Appends the residual of the current iteration to the history of the solve being recorded, if any. */
+        void sample(const unsigned short iteration, const double residual, const double relative) {
+            if(_current) {
+                _current->update();
+                _current->history.emplace_back(Sample { _current->time, residual, relative, _current->reductions, _current->bytes, _current->solves, iteration });
+            }
+        }
+        /* Function: csv
+         *  Writes a record as comma-separated values, one line per iteration. */
+        static void csv(std::ostream& out, const Record& record) {
+            csv(out, record, 0, false);
+        }
+        /* Function: json
+         *  Writes a record as a JSON object. */
+        static void json(std::ostream& out, const Record& record, const std::string& key = "") {
+            json(out, record, record.time, false, key);
+        }
+        template<int N = 0>
+        static std::shared_ptr<Telemetry> get() {
+            return Singleton::get<Telemetry, N>();
+        }
+};
+
+/* Class: Timer
+ *
+ *  A class to accumulate the wall-clock time spent in, and the number of calls to, a fixed number of phases, e.g., of the setup of a preconditioner. Nested phases are timed inclusively.
+ *
+ * Template Parameter:
+ *    N              - Number of phases. */
+template<unsigned short N>
+class Timer {
+    private:
+        std::array<double, N>        _time;
+        std::array<unsigned int, N> _calls;
+    public:
+        /* Class: Scope
+         *  A class to charge the lifetime of its instances to a phase. */
+        class Scope {
+            private:
+                Timer&                                      _timer;
+                const unsigned short                        _phase;
+                const std::chrono::steady_clock::time_point _start;
+            public:
+                Scope(Timer& timer, const unsigned short phase) : _timer(timer), _phase(phase), _start(std::chrono::steady_clock::now()) { }
+                Scope(const Scope&) = delete;
+                ~Scope() {
+                    _timer._time[_phase] += std::chrono::duration<double>(std::chrono::steady_clock::now() - _start).count();
+                    ++_timer._calls[_phase];
+                }
+        };
+        Timer() : _time(), _calls() { }
+        /* Function: time
+         *  Returns the time in seconds spent in a phase. */
+        double time(const unsigned short phase) const { return _time[phase]; }
+        /* Function: calls
+         *  Returns the number of calls to a phase. */
+        unsigned int calls(const unsigned short phase) const { return _calls[phase]; }
+        /* Function: operator+=
+         *  Adds the timings of another timer. */
+        Timer& operator+=(const Timer& other) {
+            for(unsigned short i = 0; i < N; ++i) {
+                _time[i] += other._time[i];
+                _calls[i] += other._calls[i];
+            }
+            return *this;
+        }
+        /* Function: reset
+         *  Discards all timings. */
+        void reset() {
+            _time.fill(0.0);
+            _calls.fill(0);
+        }
+};
+
+/* Function: peakMemory
+ *  Returns the peak resident set size of the process in bytes, or 0 if it is not available on this platform. */
+inline std::size_t peakMemory() {
+#if defined(__unix__) || defined(__APPLE__)
+    struct rusage usage;
+    if(getrusage(RUSAGE_SELF, &usage) == 0)
+# ifdef __APPLE__
+        return usage.ru_maxrss;
+# else
+        return usage.ru_maxrss * 1024;
+# endif
+#endif
+    return 0;
+}
+} // HPDDM
+#endif // _HPDDM_TELEMETRY_
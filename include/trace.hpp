@@ -0,0 +1,149 @@
+ /*
+   This file is part of HPDDM.
+
+   Author(s): Pierre Jolivet <pierre.jolivet@enseeiht.fr>
+        Date: 2026-10-18
+
+   Copyright (C) 2026-     Centre National de la Recherche Scientifique
+
+   HPDDM is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published
+   by the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   HPDDM is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with HPDDM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _HPDDM_TRACE_
+#define _HPDDM_TRACE_
+
+#if HPDDM_TRACE
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <vector>
+#ifdef _OPENMP
+# include <omp.h>
+#endif
+#include "singleton.hpp"
+
+# define HPDDM_TRACE_SCOPE(NAME) const HPDDM::Trace::Scope traceScope(NAME)
+
+namespace HPDDM {
+/* Class: Trace
+ *
+ *  A class to record the beginning and the end of the main phases of HPDDM in a ring buffer, one per process, see the options trace and trace_size.
+ *  Events are written as a Chrome trace, which may be loaded in chrome://tracing or https://ui.perfetto.dev, with one file per process when the <Option> singleton is destroyed. Only the latest events are kept once the ring buffer is full. */
+class Trace : private Singleton {
+    public:
+        /* Struct: Event
+         *  A phase of a given thread, with times in microseconds. */
+        struct Event {
+            const char*     name;
+            long long      begin;
+            long long        end;
+            int           thread;
+        };
+        /* Class: Scope
+         *  A class to record the lifetime of its instances as an event, if tracing is enabled. */
+        class Scope {
+            private:
+                const char* const _name;
+                long long        _begin;
+            public:
+                explicit Scope(const char* const name) : _name(Trace::instance()->_enabled ? name : nullptr) {
+                    if(_name)
+                        _begin = now();
+                }
+                Scope(const Scope&) = delete;
+                ~Scope() {
+                    if(_name)
+                        Trace::instance()->push(_name, _begin, now());
+                }
+        };
+    private:
+        /* Variable: events
+         *  Ring buffer of events. */
+        std::vector<Event>              _events;
+        /* Variable: count
+         *  Number of events pushed since tracing was enabled, incremented atomically so that concurrent threads get distinct slots of <Trace::events>. */
+        std::atomic<unsigned long long>  _count;
+        int                               _rank;
+        bool                           _enabled;
+        static long long now() {
+            return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+        void push(const char* const name, const long long begin, const long long end) {
+#ifdef _OPENMP
+            const int thread = omp_get_thread_num();
+#else
+            const int thread = 0;
+#endif
+            _events[_count.fetch_add(1, std::memory_order_relaxed) % _events.size()] = Event { name, begin, end, thread };
+        }
+        /* Function: instance
+         *  Returns a pointer to the singleton, cached so that scopes do not copy the std::shared_ptr returned by <Trace::get>. */
+        static Trace* instance() {
+            static Trace* const trace = get().get();
+            return trace;
+        }
+    public:
+        template<int N>
+        Trace(Singleton::construct_key<N>) : _count(), _rank(), _enabled() { }
+        /* Function: enable
+         *
+         *  Turns tracing on or off. This function is called by <Option::parse> and must not be called concurrently with the recording of events.
+         *
+         * Parameter:
+         *    size           - Capacity of the ring buffer, or 0 to disable tracing. */
+        void enable(const unsigned int size) {
+            _enabled = (size > 0);
+            if(_enabled && size != _events.size()) {
+                _events.resize(size);
+                _count = 0;
+            }
+#if HPDDM_MPI
+            int flag;
+            MPI_Initialized(&flag);
+            if(_enabled && flag)
+                MPI_Comm_rank(MPI_COMM_WORLD, &_rank);
+#endif
+        }
+        /* Function: flush
+         *
+         *  Writes recorded events as a Chrome trace, and discards them.
+         *
+         * Parameter:
+         *    filename       - Name of the output file, to which the rank of the process in MPI_COMM_WORLD is appended before the extension .json. */
+        void flush(std::string filename) {
+            const unsigned long long count = _count;
+            if(count == 0)
+                return;
+            if(filename.size() > 5 && filename.compare(filename.size() - 5, 5, ".json") == 0)
+                filename.resize(filename.size() - 5);
+            std::ofstream output { filename + "_" + to_string(_rank) + ".json" };
+            output << "{\"traceEvents\":[";
+            const unsigned long long size = _events.size();
+            for(unsigned long long i = (count > size ? count - size : 0); i < count; ++i) {
+                const Event& e = _events[i % size];
+                output << (i == (count > size ? count - size : 0) ? "\n" : ",\n") << "{\"name\":\"" << e.name << "\",\"cat\":\"hpddm\",\"ph\":\"X\",\"ts\":" << e.begin << ",\"dur\":" << e.end - e.begin << ",\"pid\":" << _rank << ",\"tid\":" << e.thread << "}";
+            }
+            output << "\n],\"displayTimeUnit\":\"ms\"}\n";
+            _count = 0;
+        }
+        template<int N = 0>
+        static std::shared_ptr<Trace> get() {
+            return Singleton::get<Trace, N>();
+        }
+};
+} // HPDDM
+#else
+# define HPDDM_TRACE_SCOPE(NAME)
+#endif // HPDDM_TRACE
+#endif // _HPDDM_TRACE_
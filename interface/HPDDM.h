@@ -113,6 +113,7 @@ void HpddmSchwarzDestroy(HpddmSchwarz*);
 
 int HpddmSolve(HpddmSchwarz*, const K* const, K* const, int, const MPI_Comm*);
 void HpddmDestroyRecycling();
+void HpddmDestroyWorkspace(const char*);
 struct HpddmCustomOperator;
 typedef struct HpddmCustomOperator HpddmCustomOperator;
 int HpddmCustomOperatorSolve(const HpddmCustomOperator* const, int, void (*)(const HpddmCustomOperator* const, const K*, K*, int), void (*)(const HpddmCustomOperator* const, const K*, K*, int), const K* const, K* const, int, const MPI_Comm*);
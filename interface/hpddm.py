@@ -263,6 +263,11 @@ _solve.argtypes = [ ctypes.POINTER(Schwarz), numpy.ctypeslib.ndpointer(scalar, f
 destroyRecycling = lib.destroyRecycling
 destroyRecycling.restype = None
 destroyRecycling.argtypes = [ ctypes.c_int ]
+_destroyWorkspace = lib.destroyWorkspace
+_destroyWorkspace.restype = None
+_destroyWorkspace.argtypes = [ ctypes.c_char_p ]
+def destroyWorkspace(pre = None):
+    _destroyWorkspace(pre)
 _CustomOperatorSolve = lib.CustomOperatorSolve
 _CustomOperatorSolve.restype = ctypes.c_int
 _CustomOperatorSolve.argtypes = [ ctypes.POINTER(MatrixCSR), precondFunc, numpy.ctypeslib.ndpointer(scalar, flags = 'F_CONTIGUOUS'), numpy.ctypeslib.ndpointer(scalar, flags = 'F_CONTIGUOUS'), ctypes.c_int ]
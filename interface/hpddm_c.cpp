@@ -193,6 +193,12 @@ int HpddmSolve(HpddmSchwarz* A, const K* const b, K* const sol, int mu, const MP
 void HpddmDestroyRecycling() {
     HPDDM::Recycling<K>::get()->destroy();
 }
+void HpddmDestroyWorkspace(const char* prefix) {
+    const std::string key(prefix ? prefix : "");
+    HPDDM::Workspace<cpp_type<K>>::get()->destroy(key);
+    HPDDM::Workspace<underlying_type>::get()->destroy(key);
+    HPDDM::Workspace<HPDDM::downscaled_type<cpp_type<K>, true>>::get()->destroy(key);
+}
 int HpddmCustomOperatorSolve(const HpddmCustomOperator* const A, int n, void (*mv)(const HpddmCustomOperator* const, const K*, K*, int), void (*precond)(const HpddmCustomOperator* const, const K*, K*, int), const K* const b, K* const sol, int mu, const MPI_Comm* comm) {
     return HPDDM::IterativeMethod::solve(CustomOperator<HpddmCustomOperator, K>(A, n, mv, precond), reinterpret_cast<const cpp_type<K>*>(b), reinterpret_cast<cpp_type<K>*>(sol), mu, *comm);
 }
@@ -250,6 +250,12 @@ int solve(void* A, HPDDM::pod_type<K>* f, HPDDM::pod_type<K>* sol, int mu, MPI_C
 void destroyRecycling() {
     HPDDM::Recycling<K>::get()->destroy();
 }
+void destroyWorkspace(char* prefix) {
+    const std::string key(prefix ? prefix : "");
+    HPDDM::Workspace<K>::get()->destroy(key);
+    HPDDM::Workspace<HPDDM::underlying_type<K>>::get()->destroy(key);
+    HPDDM::Workspace<HPDDM::downscaled_type<K, true>>::get()->destroy(key);
+}
 int CustomOperatorSolve(void* Mat, void (*precond)(const HPDDM::pod_type<K>*, HPDDM::pod_type<K>*, int, int), HPDDM::pod_type<K>* f, HPDDM::pod_type<K>* sol, int mu) {
     return HPDDM::IterativeMethod::solve(CustomOperator(reinterpret_cast<HPDDM::MatrixCSR<K>*>(Mat), precond), reinterpret_cast<K*>(f), reinterpret_cast<K*>(sol), mu, MPI_COMM_SELF);
 }